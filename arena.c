@@ -0,0 +1,346 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include arena functionality. This #if is closed at the very bottom of this
+ * file. If you want to include arenas then ensure configUSE_ARENAS is set to 1
+ * in FreeRTOSConfig.h. */
+#if ( configUSE_ARENAS == 1 )
+
+/* The size of the structure placed at the beginning of each arena, rounded up
+ * so the memory that follows it is correctly byte aligned. */
+    #define arenaSTRUCT_SIZE    ( ( sizeof( Arena_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The control structure of an arena, which is placed at the start of the
+ * arena's memory.  The memory between pucNextFreeByte and pucEnd has not been
+ * allocated. */
+    typedef struct ArenaDefinition
+    {
+        uint8_t * pucStart;           /**< The first byte of the arena that can be allocated. */
+        uint8_t * pucNextFreeByte;    /**< The first byte of the arena that has not been allocated. */
+        uint8_t * pucEnd;             /**< One past the last byte of the arena. */
+        size_t xMinimumEverFreeBytes; /**< The least free space the arena has had. */
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the arena was created in a buffer provided by the application, so its memory is not freed when it is deleted. */
+        #endif
+    } Arena_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the control structure at the start of pucMemory, which is
+ * xSizeBytes long and aligned to portBYTE_ALIGNMENT.
+ */
+    static Arena_t * prvInitialiseNewArena( uint8_t * pucMemory,
+                                            size_t xSizeBytes ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static Arena_t * prvInitialiseNewArena( uint8_t * pucMemory,
+                                            size_t xSizeBytes )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        Arena_t * pxArena = ( Arena_t * ) pucMemory;
+
+        pxArena->pucStart = pucMemory + arenaSTRUCT_SIZE;
+        pxArena->pucNextFreeByte = pxArena->pucStart;
+        pxArena->pucEnd = pucMemory + xSizeBytes;
+        pxArena->xMinimumEverFreeBytes = xSizeBytes - arenaSTRUCT_SIZE;
+
+        return pxArena;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        ArenaHandle_t xArenaCreate( size_t xArenaSizeBytes )
+        {
+            Arena_t * pxArena = NULL;
+            uint8_t * pucMemory;
+
+            traceENTER_xArenaCreate( xArenaSizeBytes );
+
+            /* Check for addition overflow. */
+            if( xArenaSizeBytes <= ( SIZE_MAX - arenaSTRUCT_SIZE ) )
+            {
+                /* The control structure and the arena itself are allocated in a
+                 * single block, so the arena is freed with a single call to
+                 * vPortFree(). */
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucMemory = ( uint8_t * ) pvPortMalloc( arenaSTRUCT_SIZE + xArenaSizeBytes );
+
+                if( pucMemory != NULL )
+                {
+                    pxArena = prvInitialiseNewArena( pucMemory, arenaSTRUCT_SIZE + xArenaSizeBytes );
+                    pxArena->ucStaticallyAllocated = pdFALSE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xArenaCreate( pxArena );
+
+            return pxArena;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    ArenaHandle_t xArenaCreateStatic( uint8_t * pucArenaBuffer,
+                                      size_t xArenaBufferSizeBytes )
+    {
+        Arena_t * pxArena = NULL;
+        size_t xPadding;
+
+        traceENTER_xArenaCreateStatic( pucArenaBuffer, xArenaBufferSizeBytes );
+
+        configASSERT( pucArenaBuffer );
+
+        if( pucArenaBuffer != NULL )
+        {
+            /* Skip any bytes needed to align the start of the buffer. */
+            xPadding = ( size_t ) ( ( ( size_t ) portBYTE_ALIGNMENT - ( ( size_t ) ( portPOINTER_SIZE_TYPE ) pucArenaBuffer & ( size_t ) portBYTE_ALIGNMENT_MASK ) ) & ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+            if( ( xArenaBufferSizeBytes > xPadding ) && ( ( xArenaBufferSizeBytes - xPadding ) >= arenaSTRUCT_SIZE ) )
+            {
+                pxArena = prvInitialiseNewArena( pucArenaBuffer + xPadding, xArenaBufferSizeBytes - xPadding );
+
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * this arena was created statically in case it is later
+                     * deleted. */
+                    pxArena->ucStaticallyAllocated = pdTRUE;
+                }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xArenaCreateStatic( pxArena );
+
+        return pxArena;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvArenaMallocAligned( ArenaHandle_t xArena,
+                                 size_t xWantedSize,
+                                 size_t xAlignment )
+    {
+        Arena_t * const pxArena = xArena;
+        void * pvReturn = NULL;
+        size_t xPadding;
+        size_t xFreeBytes;
+
+        traceENTER_pvArenaMallocAligned( xArena, xWantedSize, xAlignment );
+
+        configASSERT( pxArena );
+        configASSERT( ( xAlignment & ( xAlignment - 1U ) ) == 0U );
+
+        if( xAlignment < ( size_t ) portBYTE_ALIGNMENT )
+        {
+            xAlignment = ( size_t ) portBYTE_ALIGNMENT;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xWantedSize > 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                xPadding = ( size_t ) ( ( xAlignment - ( ( size_t ) ( portPOINTER_SIZE_TYPE ) pxArena->pucNextFreeByte & ( xAlignment - 1U ) ) ) & ( xAlignment - 1U ) );
+                xFreeBytes = ( size_t ) ( pxArena->pucEnd - pxArena->pucNextFreeByte );
+
+                /* Written so neither side can overflow. */
+                if( ( xPadding <= xFreeBytes ) && ( xWantedSize <= ( xFreeBytes - xPadding ) ) )
+                {
+                    pvReturn = ( void * ) ( pxArena->pucNextFreeByte + xPadding );
+                    pxArena->pucNextFreeByte += xPadding + xWantedSize;
+                    xFreeBytes -= xPadding + xWantedSize;
+
+                    if( xFreeBytes < pxArena->xMinimumEverFreeBytes )
+                    {
+                        pxArena->xMinimumEverFreeBytes = xFreeBytes;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_pvArenaMallocAligned( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xArenaGetFreeSize( ArenaHandle_t xArena )
+    {
+        const Arena_t * const pxArena = xArena;
+        size_t xReturn;
+
+        traceENTER_xArenaGetFreeSize( xArena );
+
+        configASSERT( pxArena );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = ( size_t ) ( pxArena->pucEnd - pxArena->pucNextFreeByte );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xArenaGetFreeSize( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena )
+    {
+        const Arena_t * const pxArena = xArena;
+        size_t xReturn;
+
+        traceENTER_xArenaGetMinimumEverFreeSize( xArena );
+
+        configASSERT( pxArena );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxArena->xMinimumEverFreeBytes;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xArenaGetMinimumEverFreeSize( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vArenaReset( ArenaHandle_t xArena )
+    {
+        Arena_t * const pxArena = xArena;
+
+        traceENTER_vArenaReset( xArena );
+
+        configASSERT( pxArena );
+
+        taskENTER_CRITICAL();
+        {
+            pxArena->pucNextFreeByte = pxArena->pucStart;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vArenaReset();
+    }
+/*-----------------------------------------------------------*/
+
+    void vArenaDelete( ArenaHandle_t xArena )
+    {
+        Arena_t * const pxArena = xArena;
+
+        traceENTER_vArenaDelete( xArena );
+
+        configASSERT( pxArena );
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* The arena could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxArena->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxArena );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configSUPPORT_DYNAMIC_ALLOCATION */
+        {
+            /* The arena was allocated statically, so there is nothing to free. */
+            ( void ) pxArena;
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        traceRETURN_vArenaDelete();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include arena functionality. If you want to include arenas then ensure
+ * configUSE_ARENAS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ARENAS == 1 */
@@ -0,0 +1,214 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures how long critical sections and scheduler suspension are held.  See
+ * the comments in critical_profiler.h.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "critical_profiler.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the critical section profiler. This #if is closed at the very
+ * bottom of this file. If you want to include the profiler then ensure
+ * configUSE_CRITICAL_PROFILER is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+    #define criticalprofilerNUMBER_OF_REGIONS    ( 2U )
+
+/* The state of one kind of region on one core. */
+    typedef struct CriticalProfilerRegion
+    {
+        uint32_t ulEntryTime;           /**< configCRITICAL_PROFILER_GET_TIME() when the region was entered. */
+        const void * pvEntryCaller;     /**< The caller that entered the region. */
+        uint8_t ucEntered;              /**< pdTRUE between vCriticalProfilerEnter() and vCriticalProfilerExit(). */
+        CriticalProfilerStats_t xStats; /**< The hold times recorded so far. */
+    } CriticalProfilerRegion_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Adds a hold time of ulHoldTime for a region entered by pvCaller to *pxStats.
+ */
+    static void prvRecordHoldTime( CriticalProfilerStats_t * pxStats,
+                                   const void * pvCaller,
+                                   uint32_t ulHoldTime ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    PRIVILEGED_DATA static CriticalProfilerRegion_t xProfilerRegions[ configNUMBER_OF_CORES ][ criticalprofilerNUMBER_OF_REGIONS ];
+
+/*-----------------------------------------------------------*/
+
+    static void prvRecordHoldTime( CriticalProfilerStats_t * pxStats,
+                                   const void * pvCaller,
+                                   uint32_t ulHoldTime )
+    {
+        CriticalProfilerCaller_t * const pxWorst = pxStats->xWorstCallers;
+        CriticalProfilerCaller_t xSwap;
+        uint32_t ulBits = ulHoldTime;
+        UBaseType_t uxBucket = 0U;
+        UBaseType_t x;
+
+        pxStats->ulCount++;
+
+        if( ulHoldTime > pxStats->ulMaximum )
+        {
+            pxStats->ulMaximum = ulHoldTime;
+        }
+
+        /* The bucket is the number of significant bits in the hold time. */
+        while( ( ulBits != 0U ) && ( uxBucket < ( UBaseType_t ) ( configCRITICAL_PROFILER_BUCKETS - 1 ) ) )
+        {
+            ulBits >>= 1U;
+            uxBucket++;
+        }
+
+        pxStats->ulBuckets[ uxBucket ]++;
+
+        /* The worst callers are kept sorted longest first, so most regions
+         * only need comparing against the last entry. */
+        if( ulHoldTime > pxWorst[ configCRITICAL_PROFILER_WORST_CALLERS - 1 ].ulMaximum )
+        {
+            /* Update the caller's existing entry, or failing that replace the
+             * last entry. */
+            for( x = 0U; x < ( UBaseType_t ) ( configCRITICAL_PROFILER_WORST_CALLERS - 1 ); x++ )
+            {
+                if( pxWorst[ x ].pvCaller == pvCaller )
+                {
+                    break;
+                }
+            }
+
+            if( ( pxWorst[ x ].pvCaller != pvCaller ) || ( pxWorst[ x ].ulMaximum < ulHoldTime ) )
+            {
+                pxWorst[ x ].pvCaller = pvCaller;
+                pxWorst[ x ].ulMaximum = ulHoldTime;
+
+                while( ( x > 0U ) && ( pxWorst[ x - 1U ].ulMaximum < pxWorst[ x ].ulMaximum ) )
+                {
+                    xSwap = pxWorst[ x - 1U ];
+                    pxWorst[ x - 1U ] = pxWorst[ x ];
+                    pxWorst[ x ] = xSwap;
+                    x--;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerEnter( eCriticalProfilerRegion eRegion,
+                                 const void * pvCaller )
+    {
+        CriticalProfilerRegion_t * const pxRegion = &( xProfilerRegions[ portGET_CORE_ID() ][ eRegion ] );
+
+        pxRegion->pvEntryCaller = pvCaller;
+        pxRegion->ucEntered = ( uint8_t ) pdTRUE;
+
+        /* Read the time last so the profiler's own overhead is not counted. */
+        pxRegion->ulEntryTime = ( uint32_t ) configCRITICAL_PROFILER_GET_TIME();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerExit( eCriticalProfilerRegion eRegion )
+    {
+        const uint32_t ulExitTime = ( uint32_t ) configCRITICAL_PROFILER_GET_TIME();
+        CriticalProfilerRegion_t * const pxRegion = &( xProfilerRegions[ portGET_CORE_ID() ][ eRegion ] );
+
+        if( pxRegion->ucEntered != ( uint8_t ) pdFALSE )
+        {
+            pxRegion->ucEntered = ( uint8_t ) pdFALSE;
+            prvRecordHoldTime( &( pxRegion->xStats ), pxRegion->pvEntryCaller, ulExitTime - pxRegion->ulEntryTime );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerGetStats( BaseType_t xCoreID,
+                                    eCriticalProfilerRegion eRegion,
+                                    CriticalProfilerStats_t * pxStats )
+    {
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+        configASSERT( ( UBaseType_t ) eRegion < ( UBaseType_t ) criticalprofilerNUMBER_OF_REGIONS );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memcpy( pxStats, &( xProfilerRegions[ xCoreID ][ eRegion ].xStats ), sizeof( CriticalProfilerStats_t ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerReset( void )
+    {
+        BaseType_t xCoreID;
+        UBaseType_t uxRegion;
+
+        taskENTER_CRITICAL();
+        {
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                for( uxRegion = 0U; uxRegion < ( UBaseType_t ) criticalprofilerNUMBER_OF_REGIONS; uxRegion++ )
+                {
+                    ( void ) memset( &( xProfilerRegions[ xCoreID ][ uxRegion ].xStats ), 0x00, sizeof( CriticalProfilerStats_t ) );
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_CRITICAL_PROFILER == 1 */
@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_ARENAS == 1 )
+    #include "arena.h"
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -63,8 +67,64 @@
         #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
             uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
         #endif
+
+        #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+            volatile UBaseType_t uxLockCount;        /**< Non-zero while a task is accessing xTasksWaitingForBits, in which case interrupts must not access the list. */
+            volatile EventBits_t uxBitsSetWhileLocked; /**< Bits set from an interrupt while the event group was locked, processed when the event group is unlocked. */
+        #endif
+
+        #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+            List_t xTasksWaitingForBit[ configEVENT_GROUP_WAITER_LISTS ]; /**< Tasks that only need to be evaluated when bit N (modulo configEVENT_GROUP_WAITER_LISTS) is set. */
+            EventBits_t uxBitsWaitedForInList;                             /**< All the bits waited for by tasks in xTasksWaitingForBits, which then only holds tasks waiting for any one of several bits. */
+        #endif
     } EventGroup_t;
 
+    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+        #if ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( configEVENT_GROUP_WAITER_LISTS > 8 ) )
+            #error configEVENT_GROUP_WAITER_LISTS cannot be greater than the 8 event bits available when TickType_t is 16 bits.
+        #elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ) && ( configEVENT_GROUP_WAITER_LISTS > 24 ) )
+            #error configEVENT_GROUP_WAITER_LISTS cannot be greater than the 24 event bits available when TickType_t is 32 bits.
+        #elif ( configEVENT_GROUP_WAITER_LISTS > 56 )
+            #error configEVENT_GROUP_WAITER_LISTS cannot be greater than the 56 event bits available when TickType_t is 64 bits.
+        #endif
+    #endif
+
+/*
+ * When configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1 interrupts modify the event
+ * bits directly, so tasks can only modify them from within a critical section.
+ * Otherwise interrupts never access the event bits, and suspending the
+ * scheduler is enough.
+ */
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        #define eventENTER_BITS_CRITICAL()    taskENTER_CRITICAL()
+        #define eventEXIT_BITS_CRITICAL()     taskEXIT_CRITICAL()
+    #else
+        #define eventENTER_BITS_CRITICAL()
+        #define eventEXIT_BITS_CRITICAL()
+    #endif
+
+/*
+ * Locking an event group prevents interrupts from accessing the list of tasks
+ * waiting for bits while a task (with the scheduler suspended) is walking or
+ * modifying it.  Bits set by an interrupt while the event group is locked are
+ * still written to the event bits, but the waiting tasks are only evaluated
+ * when the event group is unlocked again.  Locks nest, as xEventGroupSync()
+ * calls xEventGroupSetBits().
+ */
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        #define prvLockEventGroup( pxEventBits ) \
+    taskENTER_CRITICAL();                        \
+    {                                            \
+        ( pxEventBits )->uxLockCount++;          \
+    }                                            \
+    taskEXIT_CRITICAL()
+
+        static void prvUnlockEventGroup( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+    #else
+        #define prvLockEventGroup( pxEventBits )
+        #define prvUnlockEventGroup( pxEventBits )
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -79,6 +139,58 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock every task waiting on the event group whose wait condition is met by
+ * the current event bits, after the bits in uxBitsSet have been set.  Returns
+ * the bits that must be cleared because a task that was unblocked specified
+ * xClearOnExit.  Must be called either with the scheduler suspended (xFromISR
+ * set to pdFALSE) or, when configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1, from a
+ * critical section within an interrupt while the event group is not locked
+ * (xFromISR set to pdTRUE).
+ */
+    static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                               const EventBits_t uxBitsSet,
+                                               const BaseType_t xFromISR,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Evaluate the tasks in a single list of tasks waiting on the event group
+ * against uxCurrentEventBits, as described for prvUnblockWaitingTasks().  The
+ * bits waited for by the tasks that remain in the list are returned in
+ * *puxBitsStillWaitedFor.
+ */
+    static EventBits_t prvUnblockTasksInList( EventGroup_t * pxEventBits,
+                                              List_t * const pxList,
+                                              const EventBits_t uxCurrentEventBits,
+                                              EventBits_t * const puxBitsStillWaitedFor,
+                                              const BaseType_t xFromISR,
+                                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Select the list a task waiting for uxBitsToWaitFor should be placed in, so
+ * that only setting one of the bits the task is waiting for causes the task to
+ * be evaluated.  A task waiting for all of a set of bits is placed in the list
+ * of one of the bits that is not yet set (in uxCurrentEventBits), and moved to
+ * the list of another bit that is not set each time it is evaluated without its
+ * wait condition being met.  A task waiting for any of a set of bits is placed
+ * in the list of those bits if they share a list, and otherwise in
+ * xTasksWaitingForBits.
+ */
+    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+        static List_t * prvGetWaitingList( EventGroup_t * pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits,
+                                           const EventBits_t uxCurrentEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the list for the lowest bit set in uxBits, which must
+ * not be zero.
+ */
+        static UBaseType_t prvGetListIndexOfLowestBit( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+    #else
+        #define prvGetWaitingList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits, uxCurrentEventBits )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+    #endif
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,6 +225,26 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                {
+                    pxEventBits->uxLockCount = ( UBaseType_t ) 0U;
+                    pxEventBits->uxBitsSetWhileLocked = 0;
+                }
+                #endif
+
+                #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+                {
+                    UBaseType_t x;
+
+                    for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; x++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ x ] ) );
+                    }
+
+                    pxEventBits->uxBitsWaitedForInList = 0;
+                }
+                #endif
+
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -140,40 +272,106 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    #if ( configUSE_ARENAS == 1 )
 
-        EventGroupHandle_t xEventGroupCreate( void )
+        EventGroupHandle_t xEventGroupCreateInArena( ArenaHandle_t xArena )
         {
-            EventGroup_t * pxEventBits;
+            StaticEventGroup_t * pxEventGroupBuffer;
+            EventGroupHandle_t xReturn = NULL;
 
-            traceENTER_xEventGroupCreate();
+            traceENTER_xEventGroupCreateInArena( xArena );
+
+            configASSERT( xArena );
 
+            /* The event group is created as a statically allocated event group
+             * so deleting it does not attempt to free the arena's memory. */
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) );
+            pxEventGroupBuffer = ( StaticEventGroup_t * ) pvArenaMalloc( xArena, sizeof( StaticEventGroup_t ) );
 
-            if( pxEventBits != NULL )
+            if( pxEventGroupBuffer != NULL )
             {
-                pxEventBits->uxEventBits = 0;
-                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
-
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-                {
-                    /* Both static and dynamic allocation can be used, so note this
-                     * event group was allocated statically in case the event group is
-                     * later deleted. */
-                    pxEventBits->ucStaticallyAllocated = pdFALSE;
-                }
-                #endif /* configSUPPORT_STATIC_ALLOCATION */
-
-                traceEVENT_GROUP_CREATE( pxEventBits );
+                xReturn = xEventGroupCreateStatic( pxEventGroupBuffer );
             }
             else
             {
                 traceEVENT_GROUP_CREATE_FAILED();
             }
 
+            traceRETURN_xEventGroupCreateInArena( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        EventGroupHandle_t xEventGroupCreate( void )
+        {
+            EventGroup_t * pxEventBits;
+
+            traceENTER_xEventGroupCreate();
+
+            #if ( configUSE_ARENAS == 1 )
+                if( xTaskGetDefaultArena( NULL ) != NULL )
+                {
+                    /* The calling task has a default arena, so the event group is
+                     * created in it. */
+                    pxEventBits = ( EventGroup_t * ) xEventGroupCreateInArena( xTaskGetDefaultArena( NULL ) );
+                }
+                else
+            #endif /* configUSE_ARENAS */
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxEventBits = ( EventGroup_t * ) pvPortMallocObject( eObjectPoolEventGroup, sizeof( EventGroup_t ) );
+
+                if( pxEventBits != NULL )
+                {
+                    pxEventBits->uxEventBits = 0;
+                    vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+                    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                    {
+                        pxEventBits->uxLockCount = ( UBaseType_t ) 0U;
+                        pxEventBits->uxBitsSetWhileLocked = 0;
+                    }
+                    #endif
+
+                    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+                    {
+                        UBaseType_t x;
+
+                        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; x++ )
+                        {
+                            vListInitialise( &( pxEventBits->xTasksWaitingForBit[ x ] ) );
+                        }
+
+                        pxEventBits->uxBitsWaitedForInList = 0;
+                    }
+                    #endif
+
+                    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    {
+                        /* Both static and dynamic allocation can be used, so note this
+                         * event group was allocated statically in case the event group is
+                         * later deleted. */
+                        pxEventBits->ucStaticallyAllocated = pdFALSE;
+                    }
+                    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                    traceEVENT_GROUP_CREATE( pxEventBits );
+                }
+                else
+                {
+                    traceEVENT_GROUP_CREATE_FAILED();
+                }
+            }
+
             traceRETURN_xEventGroupCreate( pxEventBits );
 
             return pxEventBits;
@@ -204,6 +402,8 @@
 
         vTaskSuspendAll();
         {
+            prvLockEventGroup( pxEventBits );
+
             uxOriginalBitValue = pxEventBits->uxEventBits;
 
             ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
@@ -215,7 +415,11 @@
 
                 /* Rendezvous always clear the bits.  They will have been cleared
                  * already unless this is the only task in the rendezvous. */
-                pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+                eventENTER_BITS_CRITICAL();
+                {
+                    pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+                }
+                eventEXIT_BITS_CRITICAL();
 
                 xTicksToWait = 0;
             }
@@ -228,7 +432,9 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor, pdTRUE, ( uxOriginalBitValue | uxBitsToSet ) ),
+                                                    ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ),
+                                                    xTicksToWait );
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +450,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            prvUnlockEventGroup( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -316,7 +524,7 @@
                                      TickType_t xTicksToWait )
     {
         EventGroup_t * pxEventBits = xEventGroup;
-        EventBits_t uxReturn, uxControlBits = 0;
+        EventBits_t uxReturn, uxCurrentEventBits, uxControlBits = 0;
         BaseType_t xWaitConditionMet, xAlreadyYielded;
         BaseType_t xTimeoutOccurred = pdFALSE;
 
@@ -335,20 +543,20 @@
 
         vTaskSuspendAll();
         {
-            const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
-
-            /* Check to see if the wait condition is already met or not. */
-            xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
+            prvLockEventGroup( pxEventBits );
 
-            if( xWaitConditionMet != pdFALSE )
+            eventENTER_BITS_CRITICAL();
             {
-                /* The wait condition has already been met so there is no need to
-                 * block. */
-                uxReturn = uxCurrentEventBits;
-                xTicksToWait = ( TickType_t ) 0;
+                uxCurrentEventBits = pxEventBits->uxEventBits;
 
-                /* Clear the wait bits if requested to do so. */
-                if( xClearOnExit != pdFALSE )
+                /* Check to see if the wait condition is already met or not. */
+                xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
+
+                /* Clear the wait bits if the condition is met and clearing was
+                 * requested.  This is done in the same critical section as the
+                 * test, if one is needed, so bits set by an interrupt in between
+                 * are not lost. */
+                if( ( xWaitConditionMet != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
                 {
                     pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
                 }
@@ -357,6 +565,15 @@
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            eventEXIT_BITS_CRITICAL();
+
+            if( xWaitConditionMet != pdFALSE )
+            {
+                /* The wait condition has already been met so there is no need to
+                 * block. */
+                uxReturn = uxCurrentEventBits;
+                xTicksToWait = ( TickType_t ) 0;
+            }
             else if( xTicksToWait == ( TickType_t ) 0 )
             {
                 /* The wait condition has not been met, but no block time was
@@ -391,7 +608,9 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits, uxCurrentEventBits ),
+                                                ( uxBitsToWaitFor | uxControlBits ),
+                                                xTicksToWait );
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -400,6 +619,8 @@
 
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
+
+            prvUnlockEventGroup( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -501,7 +722,38 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+        BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
+                                                const EventBits_t uxBitsToClear )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            EventGroup_t * pxEventBits = xEventGroup;
+
+            traceENTER_xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* Clearing bits never unblocks a task, so the bits can be cleared
+             * directly, whether or not the event group is locked. */
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xEventGroupClearBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                                 const EventBits_t uxBitsToClear )
@@ -518,7 +770,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -547,13 +799,8 @@
     EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                     const EventBits_t uxBitsToSet )
     {
-        ListItem_t * pxListItem;
-        ListItem_t * pxNext;
-        ListItem_t const * pxListEnd;
-        List_t const * pxList;
-        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+        EventBits_t uxBitsToClear;
         EventGroup_t * pxEventBits = xEventGroup;
-        BaseType_t xMatchFound = pdFALSE;
 
         traceENTER_xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -562,79 +809,31 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        pxList = &( pxEventBits->xTasksWaitingForBits );
-        pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
         {
-            traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+            prvLockEventGroup( pxEventBits );
 
-            pxListItem = listGET_HEAD_ENTRY( pxList );
+            traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
             /* Set the bits. */
-            pxEventBits->uxEventBits |= uxBitsToSet;
-
-            /* See if the new bit value should unblock any tasks. */
-            while( pxListItem != pxListEnd )
+            eventENTER_BITS_CRITICAL();
             {
-                pxNext = listGET_NEXT( pxListItem );
-                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-                xMatchFound = pdFALSE;
-
-                /* Split the bits waited for from the control bits. */
-                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-                {
-                    /* Just looking for single bit being set. */
-                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                    {
-                        xMatchFound = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-                {
-                    /* All bits are set. */
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    /* Need all bits to be set, but not all the bits were set. */
-                }
-
-                if( xMatchFound != pdFALSE )
-                {
-                    /* The bits match.  Should the bits be cleared on exit? */
-                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                    {
-                        uxBitsToClear |= uxBitsWaitedFor;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Store the actual event flag value in the task's event list
-                     * item before removing the task from the event list.  The
-                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                     * that is was unblocked due to its required bits matching, rather
-                     * than because it timed out. */
-                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-                }
-
-                /* Move onto the next list item.  Note pxListItem->pxNext is not
-                 * used here as the list item may have been removed from the event list
-                 * and inserted into the ready/pending reading list. */
-                pxListItem = pxNext;
+                pxEventBits->uxEventBits |= uxBitsToSet;
             }
+            eventEXIT_BITS_CRITICAL();
+
+            /* See if the new bit value should unblock any tasks. */
+            uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, uxBitsToSet, pdFALSE, NULL );
 
             /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
              * bit was set in the control word. */
-            pxEventBits->uxEventBits &= ~uxBitsToClear;
+            eventENTER_BITS_CRITICAL();
+            {
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+            }
+            eventEXIT_BITS_CRITICAL();
+
+            prvUnlockEventGroup( pxEventBits );
         }
         ( void ) xTaskResumeAll();
 
@@ -644,101 +843,439 @@
     }
 /*-----------------------------------------------------------*/
 
-    void vEventGroupDelete( EventGroupHandle_t xEventGroup )
+    static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                               const EventBits_t uxBitsSet,
+                                               const BaseType_t xFromISR,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
     {
-        EventGroup_t * pxEventBits = xEventGroup;
-        const List_t * pxTasksWaitingForBits;
-
-        traceENTER_vEventGroupDelete( xEventGroup );
-
-        configASSERT( pxEventBits );
+        EventBits_t uxBitsToClear = 0, uxBitsStillWaitedFor;
 
-        pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+        /* The bits are read once so every task is evaluated against the same
+         * value, as the bits that are cleared on exit are only cleared after all
+         * the tasks have been evaluated. */
+        const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
-        vTaskSuspendAll();
+        #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
         {
-            traceEVENT_GROUP_DELETE( xEventGroup );
-
-            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            EventBits_t uxBitsToProcess = uxBitsSet & ~eventEVENT_BITS_CONTROL_BYTES;
+            EventBits_t uxListsProcessed = 0;
+            UBaseType_t uxListIndex;
+
+            /* Tasks waiting for any one of bits that do not share a list are
+             * only evaluated if one of the bits they wait for was set. */
+            if( ( ( uxBitsToProcess & pxEventBits->uxBitsWaitedForInList ) != ( EventBits_t ) 0 ) &&
+                ( listLIST_IS_EMPTY( &( pxEventBits->xTasksWaitingForBits ) ) == pdFALSE ) )
             {
-                /* Unblock the task, returning 0 as the event list is being deleted
-                 * and cannot therefore have any bits set. */
-                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
-            }
-        }
-        ( void ) xTaskResumeAll();
+                uxBitsToClear |= prvUnblockTasksInList( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), uxCurrentEventBits, &uxBitsStillWaitedFor, xFromISR, pxHigherPriorityTaskWoken );
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-        {
-            /* The event group can only have been allocated dynamically - free
-             * it again. */
-            vPortFree( pxEventBits );
-        }
-        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-        {
-            /* The event group could have been allocated statically or
-             * dynamically, so check before attempting to free the memory. */
-            if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-            {
-                vPortFree( pxEventBits );
+                /* Tasks that timed out are removed from the list without the
+                 * event group knowing, so the bits waited for are refreshed each
+                 * time the list is evaluated. */
+                pxEventBits->uxBitsWaitedForInList = uxBitsStillWaitedFor;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            /* Then evaluate only the lists of the bits that were set. */
+            while( uxBitsToProcess != ( EventBits_t ) 0 )
+            {
+                uxListIndex = prvGetListIndexOfLowestBit( uxBitsToProcess );
+                uxBitsToProcess &= uxBitsToProcess - ( EventBits_t ) 1;
+
+                if( ( uxListsProcessed & ( ( EventBits_t ) 1 << uxListIndex ) ) == ( EventBits_t ) 0 )
+                {
+                    uxListsProcessed |= ( EventBits_t ) 1 << uxListIndex;
+                    uxBitsToClear |= prvUnblockTasksInList( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxListIndex ] ), uxCurrentEventBits, &uxBitsStillWaitedFor, xFromISR, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        #else /* if ( configEVENT_GROUP_WAITER_LISTS > 0 ) */
+        {
+            /* All the waiting tasks are in the same list. */
+            ( void ) uxBitsSet;
 
-        traceRETURN_vEventGroupDelete();
+            uxBitsToClear = prvUnblockTasksInList( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), uxCurrentEventBits, &uxBitsStillWaitedFor, xFromISR, pxHigherPriorityTaskWoken );
+        }
+        #endif /* if ( configEVENT_GROUP_WAITER_LISTS > 0 ) */
+
+        return uxBitsToClear;
     }
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        BaseType_t xEventGroupGetStaticBuffer( EventGroupHandle_t xEventGroup,
-                                               StaticEventGroup_t ** ppxEventGroupBuffer )
-        {
-            BaseType_t xReturn;
-            EventGroup_t * pxEventBits = xEventGroup;
+    static EventBits_t prvUnblockTasksInList( EventGroup_t * pxEventBits,
+                                              List_t * const pxList,
+                                              const EventBits_t uxCurrentEventBits,
+                                              EventBits_t * const puxBitsStillWaitedFor,
+                                              const BaseType_t xFromISR,
+                                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+        BaseType_t xMatchFound;
 
-            traceENTER_xEventGroupGetStaticBuffer( xEventGroup, ppxEventGroupBuffer );
+        *puxBitsStillWaitedFor = 0;
 
-            configASSERT( pxEventBits );
-            configASSERT( ppxEventGroupBuffer );
+        pxListEnd = listGET_END_MARKER( pxList );
+        pxListItem = listGET_HEAD_ENTRY( pxList );
 
-            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+            xMatchFound = pdFALSE;
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
             {
-                /* Check if the event group was statically allocated. */
-                if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdTRUE )
+                /* Just looking for single bit being set. */
+                if( ( uxBitsWaitedFor & uxCurrentEventBits ) != ( EventBits_t ) 0 )
                 {
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    *ppxEventGroupBuffer = ( StaticEventGroup_t * ) pxEventBits;
-                    xReturn = pdTRUE;
+                    xMatchFound = pdTRUE;
                 }
                 else
                 {
-                    xReturn = pdFALSE;
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            #else /* configSUPPORT_DYNAMIC_ALLOCATION */
+            else if( ( uxBitsWaitedFor & uxCurrentEventBits ) == uxBitsWaitedFor )
             {
-                /* Event group must have been statically allocated. */
-                /* MISRA Ref 11.3.1 [Misaligned access] */
-                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
-                /* coverity[misra_c_2012_rule_11_3_violation] */
-                *ppxEventGroupBuffer = ( StaticEventGroup_t * ) pxEventBits;
-                xReturn = pdTRUE;
+                /* All bits are set. */
+                xMatchFound = pdTRUE;
             }
-            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-
-            traceRETURN_xEventGroupGetStaticBuffer( xReturn );
+            else
+            {
+                /* Need all bits to be set, but not all the bits were set. */
+                #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+                {
+                    List_t * const pxNewList = &( pxEventBits->xTasksWaitingForBit[ prvGetListIndexOfLowestBit( uxBitsWaitedFor & ~uxCurrentEventBits ) ] );
 
-            return xReturn;
-        }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
-/*-----------------------------------------------------------*/
+                    /* Move the task to the list of a bit it is still waiting for
+                     * so it is not evaluated again until that bit is set.  If the
+                     * new list is evaluated later in this pass the task will not
+                     * move again as the bits being evaluated do not change. */
+                    if( pxNewList != pxList )
+                    {
+                        listREMOVE_ITEM( pxListItem );
+                        listINSERT_END( pxNewList, pxListItem );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configEVENT_GROUP_WAITER_LISTS */
+            }
+
+            if( xMatchFound != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    uxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                    if( xFromISR != pdFALSE )
+                    {
+                        if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, uxCurrentEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                #endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+                {
+                    vTaskRemoveFromUnorderedEventList( pxListItem, uxCurrentEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+            }
+            else
+            {
+                *puxBitsStillWaitedFor |= uxBitsWaitedFor;
+            }
+
+            /* Move onto the next list item.  Note pxListItem->pxNext is not
+             * used here as the list item may have been removed from the event list
+             * and inserted into the ready/pending reading list. */
+            pxListItem = pxNext;
+        }
+
+        /* Prevent compiler warnings when direct setting from interrupts or the
+         * waiter lists are not used. */
+        ( void ) pxEventBits;
+        ( void ) xFromISR;
+        ( void ) pxHigherPriorityTaskWoken;
+
+        return uxBitsToClear;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+
+        static List_t * prvGetWaitingList( EventGroup_t * pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits,
+                                           const EventBits_t uxCurrentEventBits )
+        {
+            List_t * pxList;
+            UBaseType_t uxListIndex;
+            EventBits_t uxBits;
+
+            if( xWaitForAllBits != pdFALSE )
+            {
+                /* The wait condition cannot be met until one of the bits that is
+                 * not already set is set. */
+                uxBits = uxBitsToWaitFor & ~uxCurrentEventBits;
+
+                if( uxBits == ( EventBits_t ) 0 )
+                {
+                    /* Can only happen if another task cleared the bits after
+                     * they were tested, in which case any of the bits will do. */
+                    uxBits = uxBitsToWaitFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxList = &( pxEventBits->xTasksWaitingForBit[ prvGetListIndexOfLowestBit( uxBits ) ] );
+            }
+            else
+            {
+                /* Setting any of the bits meets the wait condition, so the task
+                 * can only go in a bit's list if all the bits share that list. */
+                uxListIndex = prvGetListIndexOfLowestBit( uxBitsToWaitFor );
+                pxList = &( pxEventBits->xTasksWaitingForBit[ uxListIndex ] );
+                uxBits = uxBitsToWaitFor;
+
+                while( uxBits != ( EventBits_t ) 0 )
+                {
+                    if( prvGetListIndexOfLowestBit( uxBits ) != uxListIndex )
+                    {
+                        pxList = &( pxEventBits->xTasksWaitingForBits );
+                        pxEventBits->uxBitsWaitedForInList |= uxBitsToWaitFor;
+                        uxBits = 0;
+                    }
+                    else
+                    {
+                        uxBits &= uxBits - ( EventBits_t ) 1;
+                    }
+                }
+            }
+
+            return pxList;
+        }
+
+    #endif /* configEVENT_GROUP_WAITER_LISTS */
+/*-----------------------------------------------------------*/
+
+    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+
+        static UBaseType_t prvGetListIndexOfLowestBit( EventBits_t uxBits )
+        {
+            UBaseType_t uxBit = 0U;
+
+            configASSERT( uxBits != ( EventBits_t ) 0 );
+
+            while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+            {
+                uxBits >>= 1;
+                uxBit++;
+            }
+
+            return uxBit % ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS;
+        }
+
+    #endif /* configEVENT_GROUP_WAITER_LISTS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+        static void prvUnlockEventGroup( EventGroup_t * pxEventBits )
+        {
+            EventBits_t uxBitsToClear, uxBitsSet = 0;
+            BaseType_t xUnlocked = pdFALSE;
+
+            /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+            /* Bits set by interrupts while the event group was locked are already
+             * in uxEventBits, but the tasks waiting for them have not been
+             * evaluated yet.  Keep evaluating until no more bits were set from an
+             * interrupt before the lock is released.  Only the outermost unlock
+             * does this. */
+            while( xUnlocked == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( ( pxEventBits->uxLockCount > ( UBaseType_t ) 1U ) || ( pxEventBits->uxBitsSetWhileLocked == ( EventBits_t ) 0 ) )
+                    {
+                        pxEventBits->uxLockCount--;
+                        xUnlocked = pdTRUE;
+                    }
+                    else
+                    {
+                        uxBitsSet = pxEventBits->uxBitsSetWhileLocked;
+                        pxEventBits->uxBitsSetWhileLocked = 0;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xUnlocked == pdFALSE )
+                {
+                    uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, uxBitsSet, pdFALSE, NULL );
+
+                    taskENTER_CRITICAL();
+                    {
+                        pxEventBits->uxEventBits &= ~uxBitsToClear;
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+    #endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+    void vEventGroupDelete( EventGroupHandle_t xEventGroup )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        const List_t * pxTasksWaitingForBits;
+        UBaseType_t uxList;
+
+        traceENTER_vEventGroupDelete( xEventGroup );
+
+        configASSERT( pxEventBits );
+
+        vTaskSuspendAll();
+        {
+            prvLockEventGroup( pxEventBits );
+
+            traceEVENT_GROUP_DELETE( xEventGroup );
+
+            /* List 0 is xTasksWaitingForBits, lists 1 and above are the lists of
+             * individual bits, if they are used. */
+            for( uxList = ( UBaseType_t ) 0U; uxList <= ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; uxList++ )
+            {
+                #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+                {
+                    pxTasksWaitingForBits = ( uxList == ( UBaseType_t ) 0U ) ? &( pxEventBits->xTasksWaitingForBits ) : &( pxEventBits->xTasksWaitingForBit[ uxList - ( UBaseType_t ) 1U ] );
+                }
+                #else
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+                }
+                #endif
+
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                {
+                    /* Unblock the task, returning 0 as the event list is being deleted
+                     * and cannot therefore have any bits set. */
+                    configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                    vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+            }
+
+            prvUnlockEventGroup( pxEventBits );
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The event group can only have been allocated dynamically - free
+             * it again. */
+            vPortFreeObject( eObjectPoolEventGroup, pxEventBits );
+        }
+        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The event group could have been allocated statically or
+             * dynamically, so check before attempting to free the memory. */
+            if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFreeObject( eObjectPoolEventGroup, pxEventBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        traceRETURN_vEventGroupDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        BaseType_t xEventGroupGetStaticBuffer( EventGroupHandle_t xEventGroup,
+                                               StaticEventGroup_t ** ppxEventGroupBuffer )
+        {
+            BaseType_t xReturn;
+            EventGroup_t * pxEventBits = xEventGroup;
+
+            traceENTER_xEventGroupGetStaticBuffer( xEventGroup, ppxEventGroupBuffer );
+
+            configASSERT( pxEventBits );
+            configASSERT( ppxEventGroupBuffer );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* Check if the event group was statically allocated. */
+                if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdTRUE )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    *ppxEventGroupBuffer = ( StaticEventGroup_t * ) pxEventBits;
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    xReturn = pdFALSE;
+                }
+            }
+            #else /* configSUPPORT_DYNAMIC_ALLOCATION */
+            {
+                /* Event group must have been statically allocated. */
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                *ppxEventGroupBuffer = ( StaticEventGroup_t * ) pxEventBits;
+                xReturn = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            traceRETURN_xEventGroupGetStaticBuffer( xReturn );
+
+            return xReturn;
+        }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
 /* For internal use only - execute a 'set bits' command that was pended from
  * an interrupt. */
@@ -809,7 +1346,68 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+        BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            EventGroup_t * pxEventBits = xEventGroup;
+            EventBits_t uxBitsToClear;
+            BaseType_t xTaskWoken = pdFALSE;
+
+            traceENTER_xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* See the comment in xQueueGenericSendFromISR() for details on
+             * interrupt priority checking. */
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+                pxEventBits->uxEventBits |= uxBitsToSet;
+
+                if( pxEventBits->uxLockCount == ( UBaseType_t ) 0U )
+                {
+                    /* No task is accessing the list of waiting tasks, so the
+                     * waiting tasks can be evaluated and unblocked here rather
+                     * than by the timer task. */
+                    uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, uxBitsToSet, pdTRUE, &xTaskWoken );
+                    pxEventBits->uxEventBits &= ~uxBitsToClear;
+                }
+                else
+                {
+                    /* A task has the event group locked.  The bits have been set,
+                     * and the task that holds the lock will evaluate the waiting
+                     * tasks when it unlocks the event group. */
+                    pxEventBits->uxBitsSetWhileLocked |= uxBitsToSet;
+                }
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupSetBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                               const EventBits_t uxBitsToSet,
@@ -827,7 +1425,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -878,6 +1476,613 @@
     #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+
+        typedef struct WideEventGroupDef_t
+        {
+            List_t xTasksWaitingForBits;    /**< List of the wait records of the tasks waiting for bits to be set. */
+            UBaseType_t uxNumberOfWords;    /**< The number of words in puxEventBits. */
+            WideEventBits_t * puxEventBits; /**< The event bits, either following this structure in the same allocation or provided by the application. */
+
+            #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+                uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
+            #endif
+        } WideEventGroup_t;
+
+/*
+ * A task blocked on a wide event group places one of these in the event group's
+ * xTasksWaitingForBits list.  The record lives in the blocked task's stack frame,
+ * so the mask being waited for does not have to fit in the list item value.  The
+ * record is only accessed with the scheduler suspended, and is removed from the
+ * list by the task that unblocks the waiting task, or by vTaskDelete() if the
+ * waiting task is deleted, as its list item is recorded in the task's TCB.
+ */
+        typedef struct WideEventWaiter
+        {
+            ListItem_t xListItem;                       /**< Owned by this record, and referenced from the event group's list. */
+            TaskHandle_t xTask;                         /**< The waiting task, notified when the record is removed from the list. */
+            const WideEventBits_t * puxBitsToWaitFor;   /**< The waiting task's mask. */
+            WideEventBits_t * puxEventBits;             /**< Where to copy the event bits when the task is unblocked, or NULL. */
+            BaseType_t xClearOnExit;
+            BaseType_t xWaitForAllBits;
+            volatile BaseType_t xWaiting;               /**< pdTRUE while the record is in the event group's list. */
+            volatile BaseType_t xConditionMet;          /**< Set to pdTRUE if the record was removed because the wait condition was met. */
+        } WideEventWaiter_t;
+
+/*
+ * The wide event group equivalent of prvTestWaitCondition(), evaluated one word
+ * at a time.
+ */
+        static BaseType_t prvTestWideWaitCondition( const WideEventBits_t * puxCurrentEventBits,
+                                                    const WideEventBits_t * puxBitsToWaitFor,
+                                                    const UBaseType_t uxNumberOfWords,
+                                                    const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise a wide event group whose event bits are held in puxEventBitsBuffer.
+ */
+        static void prvInitialiseWideEventGroup( WideEventGroup_t * pxEventBits,
+                                                 UBaseType_t uxNumberOfWords,
+                                                 WideEventBits_t * puxEventBitsBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a wait record from the event group's list and notify its task, after
+ * copying the current event bits out to the task if it requested them.  Must be
+ * called with the scheduler suspended.
+ */
+        static void prvReleaseWideWaiter( const WideEventGroup_t * pxEventBits,
+                                          WideEventWaiter_t * pxWaiter,
+                                          const BaseType_t xConditionMet ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+            WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxNumberOfBits,
+                                                                WideEventBits_t * puxEventBitsBuffer,
+                                                                StaticWideEventGroup_t * pxEventGroupBuffer )
+            {
+                WideEventGroup_t * pxEventBits = NULL;
+
+                traceENTER_xWideEventGroupCreateStatic( uxNumberOfBits, puxEventBitsBuffer, pxEventGroupBuffer );
+
+                configASSERT( uxNumberOfBits > ( UBaseType_t ) 0U );
+                configASSERT( puxEventBitsBuffer );
+                configASSERT( pxEventGroupBuffer );
+
+                #if ( configASSERT_DEFINED == 1 )
+                {
+                    /* Sanity check that the size of the structure used to declare a
+                     * variable of type StaticWideEventGroup_t equals the size of the
+                     * real wide event group structure. */
+                    volatile size_t xSize = sizeof( StaticWideEventGroup_t );
+                    configASSERT( xSize == sizeof( WideEventGroup_t ) );
+                }
+                #endif /* configASSERT_DEFINED */
+
+                if( ( puxEventBitsBuffer != NULL ) && ( pxEventGroupBuffer != NULL ) && ( uxNumberOfBits > ( UBaseType_t ) 0U ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxEventBits = ( WideEventGroup_t * ) pxEventGroupBuffer;
+
+                    prvInitialiseWideEventGroup( pxEventBits, eventWIDE_WORDS_FOR_BITS( uxNumberOfBits ), puxEventBitsBuffer );
+
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* Both static and dynamic allocation can be used, so note that
+                         * this event group was created statically in case the event group
+                         * is later deleted. */
+                        pxEventBits->ucStaticallyAllocated = pdTRUE;
+                    }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceRETURN_xWideEventGroupCreateStatic( pxEventBits );
+
+                return pxEventBits;
+            }
+
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+            WideEventGroupHandle_t xWideEventGroupCreate( UBaseType_t uxNumberOfBits )
+            {
+                WideEventGroup_t * pxEventBits = NULL;
+                UBaseType_t uxNumberOfWords;
+                uint8_t * pucAllocation;
+
+                traceENTER_xWideEventGroupCreate( uxNumberOfBits );
+
+                configASSERT( uxNumberOfBits > ( UBaseType_t ) 0U );
+
+                uxNumberOfWords = eventWIDE_WORDS_FOR_BITS( uxNumberOfBits );
+
+                /* The event bits are placed directly after the event group
+                 * structure, whose size is a multiple of the alignment of
+                 * UBaseType_t, so a single allocation holds both.  Check the
+                 * size calculation cannot overflow. */
+                if( ( uxNumberOfWords > ( UBaseType_t ) 0U ) &&
+                    ( ( size_t ) uxNumberOfWords <= ( ( ( ~( ( size_t ) 0 ) ) - sizeof( WideEventGroup_t ) ) / sizeof( WideEventBits_t ) ) ) )
+                {
+                    pucAllocation = ( uint8_t * ) pvPortMalloc( sizeof( WideEventGroup_t ) + ( ( size_t ) uxNumberOfWords * sizeof( WideEventBits_t ) ) );
+
+                    if( pucAllocation != NULL )
+                    {
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxEventBits = ( WideEventGroup_t * ) pucAllocation;
+
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        prvInitialiseWideEventGroup( pxEventBits, uxNumberOfWords, ( WideEventBits_t * ) &( pucAllocation[ sizeof( WideEventGroup_t ) ] ) );
+
+                        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                        {
+                            /* Both static and dynamic allocation can be used, so note this
+                             * event group was allocated dynamically in case the event group
+                             * is later deleted. */
+                            pxEventBits->ucStaticallyAllocated = pdFALSE;
+                        }
+                        #endif /* configSUPPORT_STATIC_ALLOCATION */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceRETURN_xWideEventGroupCreate( pxEventBits );
+
+                return pxEventBits;
+            }
+
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+        static void prvInitialiseWideEventGroup( WideEventGroup_t * pxEventBits,
+                                                 UBaseType_t uxNumberOfWords,
+                                                 WideEventBits_t * puxEventBitsBuffer )
+        {
+            UBaseType_t x;
+
+            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            pxEventBits->uxNumberOfWords = uxNumberOfWords;
+            pxEventBits->puxEventBits = puxEventBitsBuffer;
+
+            for( x = ( UBaseType_t ) 0U; x < uxNumberOfWords; x++ )
+            {
+                puxEventBitsBuffer[ x ] = ( WideEventBits_t ) 0U;
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup,
+                                            const WideEventBits_t * puxBitsToWaitFor,
+                                            WideEventBits_t * puxEventBits,
+                                            const BaseType_t xClearOnExit,
+                                            const BaseType_t xWaitForAllBits,
+                                            TickType_t xTicksToWait )
+        {
+            WideEventGroup_t * pxEventBits = xEventGroup;
+            WideEventWaiter_t xWaiter;
+            TimeOut_t xTimeOut;
+            BaseType_t xReturn = pdFALSE;
+            BaseType_t xTimedOut = pdFALSE;
+            UBaseType_t x;
+
+            traceENTER_xWideEventGroupWaitBits( xEventGroup, puxBitsToWaitFor, puxEventBits, xClearOnExit, xWaitForAllBits, xTicksToWait );
+
+            configASSERT( xEventGroup );
+            configASSERT( puxBitsToWaitFor );
+
+            #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+            }
+            #endif
+
+            xWaiter.xWaiting = pdFALSE;
+            xWaiter.xConditionMet = pdFALSE;
+
+            vTaskSuspendAll();
+            {
+                if( prvTestWideWaitCondition( pxEventBits->puxEventBits, puxBitsToWaitFor, pxEventBits->uxNumberOfWords, xWaitForAllBits ) != pdFALSE )
+                {
+                    /* The wait condition has already been met so there is no need
+                     * to block. */
+                    for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                    {
+                        if( puxEventBits != NULL )
+                        {
+                            puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                        }
+
+                        if( xClearOnExit != pdFALSE )
+                        {
+                            pxEventBits->puxEventBits[ x ] &= ~puxBitsToWaitFor[ x ];
+                        }
+                    }
+
+                    xWaiter.xConditionMet = pdTRUE;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The wait condition has not been met, but no block time was
+                     * specified, so just return the current value. */
+                    if( puxEventBits != NULL )
+                    {
+                        for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                        {
+                            puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                        }
+                    }
+                }
+                else
+                {
+                    /* Record what the task is waiting for in the task's own stack
+                     * frame, then block on the task's notification until the task
+                     * that sets the bits removes the record from the list. */
+                    xWaiter.xTask = xTaskGetCurrentTaskHandle();
+                    xWaiter.puxBitsToWaitFor = puxBitsToWaitFor;
+                    xWaiter.puxEventBits = puxEventBits;
+                    xWaiter.xClearOnExit = xClearOnExit;
+                    xWaiter.xWaitForAllBits = xWaitForAllBits;
+                    xWaiter.xWaiting = pdTRUE;
+
+                    vListInitialiseItem( &( xWaiter.xListItem ) );
+                    listSET_LIST_ITEM_OWNER( &( xWaiter.xListItem ), &xWaiter );
+                    vListInsertEnd( &( pxEventBits->xTasksWaitingForBits ), &( xWaiter.xListItem ) );
+                    vTaskInternalSetWideEventWaitItem( &( xWaiter.xListItem ) );
+
+                    /* Discard any notification left over from an earlier wait. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, configWIDE_EVENT_GROUP_NOTIFICATION_INDEX );
+                    vTaskSetTimeOutState( &xTimeOut );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( xWaiter.xWaiting != pdFALSE )
+            {
+                /* A notification only means the record may have been removed, so
+                 * keep waiting until it has been, or the block time expires. */
+                while( ( xWaiter.xWaiting != pdFALSE ) && ( xTimedOut == pdFALSE ) )
+                {
+                    ( void ) xTaskNotifyWaitIndexed( configWIDE_EVENT_GROUP_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                    xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+                }
+
+                vTaskSuspendAll();
+                {
+                    if( xWaiter.xWaiting != pdFALSE )
+                    {
+                        /* Timed out while the record was still in the list. */
+                        ( void ) uxListRemove( &( xWaiter.xListItem ) );
+                        xWaiter.xWaiting = pdFALSE;
+
+                        if( puxEventBits != NULL )
+                        {
+                            for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                            {
+                                puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                            }
+                        }
+                    }
+                    else
+                    {
+                        /* The record was removed, possibly after the block time
+                         * expired, in which case the notification is still
+                         * pending. */
+                        ( void ) xTaskNotifyStateClearIndexed( NULL, configWIDE_EVENT_GROUP_NOTIFICATION_INDEX );
+                    }
+
+                    vTaskInternalSetWideEventWaitItem( NULL );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = xWaiter.xConditionMet;
+
+            traceRETURN_xWideEventGroupWaitBits( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        void vWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup,
+                                     const WideEventBits_t * puxBitsToSet )
+        {
+            WideEventGroup_t * pxEventBits = xEventGroup;
+            const ListItem_t * pxListEnd;
+            ListItem_t * pxListItem;
+            ListItem_t * pxNext;
+            WideEventWaiter_t * pxWaiter;
+            BaseType_t xMatchFound = pdFALSE;
+            UBaseType_t x;
+
+            traceENTER_vWideEventGroupSetBits( xEventGroup, puxBitsToSet );
+
+            configASSERT( xEventGroup );
+            configASSERT( puxBitsToSet );
+
+            pxListEnd = listGET_END_MARKER( &( pxEventBits->xTasksWaitingForBits ) );
+
+            vTaskSuspendAll();
+            {
+                for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                {
+                    pxEventBits->puxEventBits[ x ] |= puxBitsToSet[ x ];
+                }
+
+                /* First evaluate every waiting task against the bits as they are
+                 * now, as with xEventGroupSetBits(), bits are only cleared on
+                 * exit once all the waiting tasks have been evaluated. */
+                for( pxListItem = listGET_HEAD_ENTRY( &( pxEventBits->xTasksWaitingForBits ) ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+                {
+                    pxWaiter = ( WideEventWaiter_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+
+                    if( prvTestWideWaitCondition( pxEventBits->puxEventBits, pxWaiter->puxBitsToWaitFor, pxEventBits->uxNumberOfWords, pxWaiter->xWaitForAllBits ) != pdFALSE )
+                    {
+                        pxWaiter->xConditionMet = pdTRUE;
+                        xMatchFound = pdTRUE;
+
+                        if( pxWaiter->puxEventBits != NULL )
+                        {
+                            for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                            {
+                                pxWaiter->puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                /* Then clear the bits and unblock the tasks whose condition was
+                 * met. */
+                if( xMatchFound != pdFALSE )
+                {
+                    pxListItem = listGET_HEAD_ENTRY( &( pxEventBits->xTasksWaitingForBits ) );
+
+                    while( pxListItem != pxListEnd )
+                    {
+                        pxNext = listGET_NEXT( pxListItem );
+                        pxWaiter = ( WideEventWaiter_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+
+                        if( pxWaiter->xConditionMet != pdFALSE )
+                        {
+                            if( pxWaiter->xClearOnExit != pdFALSE )
+                            {
+                                for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                                {
+                                    pxEventBits->puxEventBits[ x ] &= ~( pxWaiter->puxBitsToWaitFor[ x ] );
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            prvReleaseWideWaiter( NULL, pxWaiter, pdTRUE );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxListItem = pxNext;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vWideEventGroupSetBits();
+        }
+/*-----------------------------------------------------------*/
+
+        void vWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup,
+                                       const WideEventBits_t * puxBitsToClear )
+        {
+            WideEventGroup_t * pxEventBits = xEventGroup;
+            UBaseType_t x;
+
+            traceENTER_vWideEventGroupClearBits( xEventGroup, puxBitsToClear );
+
+            configASSERT( xEventGroup );
+            configASSERT( puxBitsToClear );
+
+            vTaskSuspendAll();
+            {
+                for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                {
+                    pxEventBits->puxEventBits[ x ] &= ~puxBitsToClear[ x ];
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vWideEventGroupClearBits();
+        }
+/*-----------------------------------------------------------*/
+
+        void vWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup,
+                                     WideEventBits_t * puxEventBits )
+        {
+            const WideEventGroup_t * pxEventBits = xEventGroup;
+            UBaseType_t x;
+
+            traceENTER_vWideEventGroupGetBits( xEventGroup, puxEventBits );
+
+            configASSERT( xEventGroup );
+            configASSERT( puxEventBits );
+
+            vTaskSuspendAll();
+            {
+                for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                {
+                    puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vWideEventGroupGetBits();
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t uxWideEventGroupGetNumberOfWords( WideEventGroupHandle_t xEventGroup )
+        {
+            const WideEventGroup_t * pxEventBits = xEventGroup;
+
+            traceENTER_uxWideEventGroupGetNumberOfWords( xEventGroup );
+
+            configASSERT( xEventGroup );
+
+            traceRETURN_uxWideEventGroupGetNumberOfWords( pxEventBits->uxNumberOfWords );
+
+            return pxEventBits->uxNumberOfWords;
+        }
+/*-----------------------------------------------------------*/
+
+        void vWideEventGroupDelete( WideEventGroupHandle_t xEventGroup )
+        {
+            WideEventGroup_t * pxEventBits = xEventGroup;
+            const List_t * pxTasksWaitingForBits;
+
+            traceENTER_vWideEventGroupDelete( xEventGroup );
+
+            configASSERT( pxEventBits );
+
+            pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+
+            vTaskSuspendAll();
+            {
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                {
+                    /* Unblock the task, returning pdFALSE as the event list is
+                     * being deleted and cannot therefore have any bits set. */
+                    prvReleaseWideWaiter( pxEventBits, ( WideEventWaiter_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxTasksWaitingForBits ), pdFALSE );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+            {
+                /* The event group can only have been allocated dynamically - free
+                 * it again. */
+                vPortFree( pxEventBits );
+            }
+            #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+            {
+                /* The event group could have been allocated statically or
+                 * dynamically, so check before attempting to free the memory. */
+                if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+                {
+                    vPortFree( pxEventBits );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            traceRETURN_vWideEventGroupDelete();
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvReleaseWideWaiter( const WideEventGroup_t * pxEventBits,
+                                          WideEventWaiter_t * pxWaiter,
+                                          const BaseType_t xConditionMet )
+        {
+            UBaseType_t x;
+
+            /* When the condition was met the bits were already copied out while
+             * the waiting tasks were being evaluated, before any were cleared. */
+            if( ( pxEventBits != NULL ) && ( pxWaiter->puxEventBits != NULL ) )
+            {
+                for( x = ( UBaseType_t ) 0U; x < pxEventBits->uxNumberOfWords; x++ )
+                {
+                    pxWaiter->puxEventBits[ x ] = pxEventBits->puxEventBits[ x ];
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( void ) uxListRemove( &( pxWaiter->xListItem ) );
+            pxWaiter->xConditionMet = xConditionMet;
+            pxWaiter->xWaiting = pdFALSE;
+
+            /* The record must not be accessed after this point, as the task may
+             * return from xWideEventGroupWaitBits() as soon as it runs. */
+            ( void ) xTaskNotifyIndexed( pxWaiter->xTask, configWIDE_EVENT_GROUP_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvTestWideWaitCondition( const WideEventBits_t * puxCurrentEventBits,
+                                                    const WideEventBits_t * puxBitsToWaitFor,
+                                                    const UBaseType_t uxNumberOfWords,
+                                                    const BaseType_t xWaitForAllBits )
+        {
+            BaseType_t xWaitConditionMet;
+            UBaseType_t x;
+
+            if( xWaitForAllBits == pdFALSE )
+            {
+                /* Met as soon as any word has a bit in common with the mask. */
+                xWaitConditionMet = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0U; ( x < uxNumberOfWords ) && ( xWaitConditionMet == pdFALSE ); x++ )
+                {
+                    if( ( puxCurrentEventBits[ x ] & puxBitsToWaitFor[ x ] ) != ( WideEventBits_t ) 0 )
+                    {
+                        xWaitConditionMet = pdTRUE;
+                    }
+                }
+            }
+            else
+            {
+                /* Not met as soon as any word is missing a bit from the mask. */
+                xWaitConditionMet = pdTRUE;
+
+                for( x = ( UBaseType_t ) 0U; ( x < uxNumberOfWords ) && ( xWaitConditionMet != pdFALSE ); x++ )
+                {
+                    if( ( puxCurrentEventBits[ x ] & puxBitsToWaitFor[ x ] ) != puxBitsToWaitFor[ x ] )
+                    {
+                        xWaitConditionMet = pdFALSE;
+                    }
+                }
+            }
+
+            return xWaitConditionMet;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* configUSE_WIDE_EVENT_GROUPS */
+
 /* This entire source file will be skipped if the application is not configured
  * to include event groups functionality. If you want to include event groups
  * then ensure configUSE_EVENT_GROUPS is set to 1 in FreeRTOSConfig.h. */
@@ -0,0 +1,85 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Configuration used by the kernel microbenchmarks, which run on the POSIX
+ * port.  See examples/template_configuration/FreeRTOSConfig.h for a
+ * description of each setting. */
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configTICK_RATE_HZ                      1000
+#define configMINIMAL_STACK_SIZE                ( ( configSTACK_DEPTH_TYPE ) 1024 )
+#define configMAX_PRIORITIES                    6
+#define configMAX_TASK_NAME_LEN                 16
+#define configTICK_TYPE_WIDTH_IN_BITS           TICK_TYPE_WIDTH_64_BITS
+#define configSTACK_DEPTH_TYPE                  size_t
+#define configUSE_MUTEXES                       1
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) 8 * 1024 * 1024 )
+
+/* The tick hook timestamps each tick, so the time from a timer expiring to its
+ * callback running can be measured. */
+#define configUSE_TICK_HOOK                     1
+
+/* The timer task runs above all the benchmark tasks so timer commands are
+ * processed as soon as they are sent. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+/* The ISR benchmarks read the latency histograms the kernel keeps for each
+ * interrupt source, which are timed with the run time stats clock. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define configUSE_ISR_WAKE_LATENCY              1
+
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskPrioritySet                1
+
+/* Set by CMakeLists.txt to the heap_N.c the kernel is built with. */
+#ifndef KERNEL_BENCHMARK_HEAP
+    #define KERNEL_BENCHMARK_HEAP               4
+#endif
+
+#define configASSERT( x )                       \
+    if( ( x ) == 0 )                            \
+    {                                           \
+        vAssertCalled( __FILE__, __LINE__ );    \
+    }
+
+extern void vAssertCalled( const char * pcFile,
+                           unsigned long ulLine );
+
+#endif /* FREERTOS_CONFIG_H */
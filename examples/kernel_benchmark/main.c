@@ -0,0 +1,958 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Microbenchmarks of the kernel primitives, run on the POSIX port.
+ *
+ * A control task runs each benchmark in turn, timing each operation with
+ * CLOCK_MONOTONIC, and writes the results to stdout as JSON.  Each result
+ * gives the minimum, mean, 50th, 90th and 99th percentile and maximum time
+ * in nanoseconds, so the output of two builds of the kernel can be compared
+ * with a script.  The benchmarks are:
+ *
+ * - yield, delay_0: a taskYIELD() or vTaskDelay( 0 ) that switches to a task
+ *   of the same priority, which yields straight back.
+ * - queue_ping_pong: send an item to a higher priority task, which sends it
+ *   back on a second queue.
+ * - semaphore_give_take: give then take a binary semaphore, uncontended.
+ * - notify_ping_pong: as queue_ping_pong, using direct to task notifications.
+ * - mutex_take_give: take then give a mutex, uncontended.
+ * - mutex_inheritance: take a mutex held by a lower priority task, which
+ *   inherits the priority of the control task until it gives the mutex.
+ * - stream_buffer, message_buffer: send a block of each size to a higher
+ *   priority task that is waiting to receive it.  Also given in MB/s.
+ * - timer_start: xTimerStart(), including the timer task processing the
+ *   command.
+ * - timer_expire: from the tick on which a timer expires to its callback.
+ * - event_group_fan_out: set bits that unblock several higher priority tasks.
+ * - heap_malloc, heap_free: pvPortMalloc() and vPortFree() of each size, with
+ *   the heap selected by -DKERNEL_BENCHMARK_HEAP=<n>.  heap_1.c cannot free.
+ * - isr_queue_send, isr_notify_give, isr_semaphore_give: from an interrupt,
+ *   emulated by xPortStartISRStimulus(), calling xQueueSendFromISR(),
+ *   vTaskNotifyGiveFromISR() or xSemaphoreGiveFromISR() to the woken task
+ *   running.  These are measured by the kernel with the run time stats clock,
+ *   which counts microseconds, and reported from the histogram of each
+ *   interrupt source, so the percentiles are power of 2 estimates, there is
+ *   no mean, and the "histogram" array gives the counts in each bucket.
+ *
+ * No objects are deleted, so the benchmarks also run when heap_1.c is used.
+ *
+ * Note that on the POSIX port each task is a pthread, so the times include
+ * the cost of switching threads on the host, and are best compared with
+ * results from the same machine.
+ */
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <timers.h>
+#include <event_groups.h>
+#include <stream_buffer.h>
+#include <message_buffer.h>
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* The number of times each operation is timed, after it has been run
+ * benchWARMUP times untimed. */
+#define benchSAMPLES                ( 2000U )
+#define benchWARMUP                 ( 100U )
+#define benchITERATIONS             ( benchWARMUP + benchSAMPLES )
+
+/* Each timer expiry waits for a tick, so fewer are timed. */
+#define benchTIMER_EXPIRIES         ( 500U )
+
+#define benchFAN_OUT_TASKS          ( 4U )
+#define benchBUFFER_BYTES           ( ( size_t ) 8192 )
+#define benchMAX_BLOCK_BYTES        ( 4096U )
+
+/* The period of the emulated interrupts, and the interrupt source of each
+ * ISR benchmark. */
+#define benchISR_PERIOD_US          ( 250U )
+#define benchISR_QUEUE_SOURCE       ( 0U )
+#define benchISR_NOTIFY_SOURCE      ( 1U )
+#define benchISR_SEMAPHORE_SOURCE   ( 2U )
+
+#define benchLOW_PRIORITY           ( tskIDLE_PRIORITY + 1U )
+#define benchCONTROL_PRIORITY       ( tskIDLE_PRIORITY + 2U )
+#define benchHIGH_PRIORITY          ( tskIDLE_PRIORITY + 3U )
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void );
+static void prvRecord( uint32_t ulIteration,
+                       uint64_t ullStart,
+                       uint64_t ullEnd );
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB );
+static void prvReport( const char * pcName,
+                       const char * pcParameter,
+                       uint32_t ulParameter,
+                       uint32_t ulSamples,
+                       uint32_t ulBytes );
+static void prvReportISRLatency( const char * pcName,
+                                 UBaseType_t uxSourceID );
+static TaskHandle_t prvCreateHelper( TaskFunction_t pxFunction,
+                                     const char * pcName,
+                                     UBaseType_t uxPriority,
+                                     void * pvParameters );
+
+static void prvYieldTask( void * pvParameters );
+static void prvQueueEchoTask( void * pvParameters );
+static void prvNotifyEchoTask( void * pvParameters );
+static void prvMutexHolderTask( void * pvParameters );
+static void prvBufferReaderTask( void * pvParameters );
+static void prvFanOutTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+static void prvISRWaiterTask( void * pvParameters );
+static BaseType_t prvQueueStimulus( void );
+static BaseType_t prvNotifyStimulus( void );
+static BaseType_t prvSemaphoreStimulus( void );
+
+static void prvBenchmarkYield( void );
+static void prvBenchmarkQueue( void );
+static void prvBenchmarkSemaphore( void );
+static void prvBenchmarkNotify( void );
+static void prvBenchmarkMutex( void );
+static void prvBenchmarkBuffers( void );
+static void prvBenchmarkTimers( void );
+static void prvBenchmarkEventGroup( void );
+static void prvBenchmarkHeap( void );
+static void prvBenchmarkISR( void );
+static void prvControlTask( void * pvParameters ) __attribute__( ( noreturn ) );
+
+/*-----------------------------------------------------------*/
+
+/* The times of the operation being measured, in nanoseconds. */
+static uint32_t ulSamples[ benchSAMPLES ];
+
+/* Used to separate the results in the JSON output. */
+static BaseType_t xFirstResult = pdTRUE;
+
+static TaskHandle_t xControlTask;
+static volatile BaseType_t xYieldDone;
+static QueueHandle_t xPingQueue, xPongQueue;
+static SemaphoreHandle_t xBenchmarkMutex;
+static EventGroupHandle_t xFanOutGroup;
+
+/* The buffer being measured, and whether it is a message buffer. */
+static StreamBufferHandle_t xBuffer;
+static BaseType_t xBufferIsMessageBuffer;
+static size_t xBufferBlockBytes;
+static uint8_t ucWriteBlock[ benchMAX_BLOCK_BYTES ], ucReadBlock[ benchMAX_BLOCK_BYTES ];
+
+/* Written by the tick hook and the timer callback. */
+static volatile uint64_t ullLastTickNs, ullTimerCallbackNs;
+
+/* Given to by the emulated interrupts. */
+static QueueHandle_t xISRQueue;
+static SemaphoreHandle_t xISRSemaphore;
+static TaskHandle_t xISRNotifyTask;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( uint32_t ulIteration,
+                       uint64_t ullStart,
+                       uint64_t ullEnd )
+{
+    uint64_t ullElapsed = ullEnd - ullStart;
+
+    if( ulIteration >= benchWARMUP )
+    {
+        ulSamples[ ulIteration - benchWARMUP ] = ( ullElapsed > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullElapsed;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB )
+{
+    uint32_t ulA = *( const uint32_t * ) pvA;
+    uint32_t ulB = *( const uint32_t * ) pvB;
+
+    return ( ulA > ulB ) - ( ulA < ulB );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcName,
+                       const char * pcParameter,
+                       uint32_t ulParameter,
+                       uint32_t ulSampleCount,
+                       uint32_t ulBytes )
+{
+    static const uint32_t ulPercentiles[] = { 50U, 90U, 99U };
+    uint64_t ullTotal = 0;
+    uint32_t ulMean, ulSample, ulRank;
+    size_t x;
+
+    qsort( ulSamples, ulSampleCount, sizeof( ulSamples[ 0 ] ), prvCompareSamples );
+
+    for( ulSample = 0; ulSample < ulSampleCount; ulSample++ )
+    {
+        ullTotal += ulSamples[ ulSample ];
+    }
+
+    ulMean = ( uint32_t ) ( ullTotal / ulSampleCount );
+
+    ( void ) printf( "%s\n    { \"name\": \"%s\"", ( xFirstResult != pdFALSE ) ? "" : ",", pcName );
+    xFirstResult = pdFALSE;
+
+    if( pcParameter != NULL )
+    {
+        ( void ) printf( ", \"%s\": %lu", pcParameter, ( unsigned long ) ulParameter );
+    }
+
+    ( void ) printf( ", \"samples\": %lu, \"min\": %lu, \"mean\": %lu",
+                     ( unsigned long ) ulSampleCount,
+                     ( unsigned long ) ulSamples[ 0 ],
+                     ( unsigned long ) ulMean );
+
+    /* Nearest rank percentiles. */
+    for( x = 0; x < sizeof( ulPercentiles ) / sizeof( ulPercentiles[ 0 ] ); x++ )
+    {
+        ulRank = ( ( ulSampleCount * ulPercentiles[ x ] ) + 99U ) / 100U;
+        ( void ) printf( ", \"p%lu\": %lu", ( unsigned long ) ulPercentiles[ x ], ( unsigned long ) ulSamples[ ulRank - 1U ] );
+    }
+
+    ( void ) printf( ", \"max\": %lu", ( unsigned long ) ulSamples[ ulSampleCount - 1U ] );
+
+    if( ( ulBytes > 0U ) && ( ulMean > 0U ) )
+    {
+        /* Bytes per nanosecond is GB/s, so scale by 1000 to get MB/s. */
+        ( void ) printf( ", \"mb_per_s\": %.1f", ( ( double ) ulBytes * 1000.0 ) / ( double ) ulMean );
+    }
+
+    ( void ) printf( " }" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReportISRLatency( const char * pcName,
+                                 UBaseType_t uxSourceID )
+{
+    static const UBaseType_t uxPercentiles[] = { 50U, 90U, 99U };
+    TaskWakeLatency_t xLatency;
+    size_t x;
+
+    vTaskGetISRWakeLatency( uxSourceID, &xLatency );
+
+    ( void ) printf( "%s\n    { \"name\": \"%s\"", ( xFirstResult != pdFALSE ) ? "" : ",", pcName );
+    xFirstResult = pdFALSE;
+
+    /* The run time stats clock counts microseconds. */
+    ( void ) printf( ", \"samples\": %lu, \"min\": %lu",
+                     ( unsigned long ) xLatency.ulSamples,
+                     ( unsigned long ) ( xLatency.ulMinimum * 1000U ) );
+
+    for( x = 0; x < sizeof( uxPercentiles ) / sizeof( uxPercentiles[ 0 ] ); x++ )
+    {
+        ( void ) printf( ", \"p%lu\": %lu",
+                         ( unsigned long ) uxPercentiles[ x ],
+                         ( unsigned long ) ( ulTaskGetWakeLatencyPercentile( &xLatency, uxPercentiles[ x ] ) * 1000U ) );
+    }
+
+    ( void ) printf( ", \"max\": %lu, \"histogram\": [", ( unsigned long ) ( xLatency.ulMaximum * 1000U ) );
+
+    for( x = 0; x < configTASK_WAKE_LATENCY_BUCKETS; x++ )
+    {
+        ( void ) printf( "%s%lu", ( x == 0U ) ? " " : ", ", ( unsigned long ) xLatency.ulBuckets[ x ] );
+    }
+
+    ( void ) printf( " ] }" );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvCreateHelper( TaskFunction_t pxFunction,
+                                     const char * pcName,
+                                     UBaseType_t uxPriority,
+                                     void * pvParameters )
+{
+    TaskHandle_t xTask = NULL;
+
+    if( xTaskCreate( pxFunction, pcName, configMINIMAL_STACK_SIZE, pvParameters, uxPriority, &xTask ) != pdPASS )
+    {
+        ( void ) printf( "Could not create a task - increase configTOTAL_HEAP_SIZE\n" );
+        exit( 1 );
+    }
+
+    return xTask;
+}
+/*-----------------------------------------------------------*/
+
+/* The helper tasks below run for benchITERATIONS iterations of the benchmark
+ * they serve, then suspend themselves rather than being deleted. */
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    while( xYieldDone == pdFALSE )
+    {
+        taskYIELD();
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueEchoTask( void * pvParameters )
+{
+    uint32_t ulIteration, ulItem;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ( void ) xQueueReceive( xPingQueue, &ulItem, portMAX_DELAY );
+        ( void ) xQueueSend( xPongQueue, &ulItem, 0 );
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyEchoTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ( void ) xTaskNotifyGive( xControlTask );
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexHolderTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        /* Take the mutex, then wake the control task so it blocks on the
+         * mutex and this task inherits its priority. */
+        ( void ) xSemaphoreTake( xBenchmarkMutex, portMAX_DELAY );
+        ( void ) xTaskNotifyGive( xControlTask );
+        ( void ) xSemaphoreGive( xBenchmarkMutex );
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBufferReaderTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+    size_t xReceived;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        /* The whole block is written before this task is unblocked, so it is
+         * always received in one go. */
+        if( xBufferIsMessageBuffer != pdFALSE )
+        {
+            xReceived = xMessageBufferReceive( xBuffer, ucReadBlock, sizeof( ucReadBlock ), portMAX_DELAY );
+        }
+        else
+        {
+            xReceived = xStreamBufferReceive( xBuffer, ucReadBlock, xBufferBlockBytes, portMAX_DELAY );
+        }
+
+        configASSERT( xReceived == xBufferBlockBytes );
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFanOutTask( void * pvParameters )
+{
+    const EventBits_t uxBit = ( EventBits_t ) 1U << ( uintptr_t ) pvParameters;
+    uint32_t ulIteration;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ( void ) xEventGroupWaitBits( xFanOutGroup, uxBit, pdTRUE, pdFALSE, portMAX_DELAY );
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    ullTimerCallbackNs = prvGetTimeNs();
+    ( void ) xTaskNotifyGive( xControlTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvISRWaiterTask( void * pvParameters )
+{
+    const UBaseType_t uxSourceID = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+    uint32_t ulIteration, ulItem;
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        switch( uxSourceID )
+        {
+            case benchISR_QUEUE_SOURCE:
+                ( void ) xQueueReceive( xISRQueue, &ulItem, portMAX_DELAY );
+                break;
+
+            case benchISR_NOTIFY_SOURCE:
+                ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+                break;
+
+            default:
+                ( void ) xSemaphoreTake( xISRSemaphore, portMAX_DELAY );
+                break;
+        }
+
+        /* The latency of each wake is recorded as this task is switched in,
+         * so discard those of the warm up iterations. */
+        if( ulIteration == ( benchWARMUP - 1U ) )
+        {
+            vTaskResetISRWakeLatency( uxSourceID );
+        }
+    }
+
+    ( void ) xTaskNotifyGive( xControlTask );
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* The emulated interrupt handlers.  Each returns pdTRUE if it woke a task that
+ * should run before the interrupted task, in place of portYIELD_FROM_ISR(). */
+
+static BaseType_t prvQueueStimulus( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ulItem = 0;
+
+    ( void ) xQueueSendFromISR( xISRQueue, &ulItem, &xHigherPriorityTaskWoken );
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyStimulus( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR( xISRNotifyTask, &xHigherPriorityTaskWoken );
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSemaphoreStimulus( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    ( void ) xSemaphoreGiveFromISR( xISRSemaphore, &xHigherPriorityTaskWoken );
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkYield( void )
+{
+    uint32_t ulIteration;
+    uint64_t ullStart;
+
+    xYieldDone = pdFALSE;
+    ( void ) prvCreateHelper( prvYieldTask, "yield", benchCONTROL_PRIORITY, NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        taskYIELD();
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "yield", NULL, 0, benchSAMPLES, 0 );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        vTaskDelay( 0 );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "delay_0", NULL, 0, benchSAMPLES, 0 );
+
+    /* Let the helper see it is done. */
+    xYieldDone = pdTRUE;
+    taskYIELD();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkQueue( void )
+{
+    uint32_t ulIteration, ulItem;
+    uint64_t ullStart;
+
+    xPingQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xPongQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( ( xPingQueue != NULL ) && ( xPongQueue != NULL ) );
+
+    ( void ) prvCreateHelper( prvQueueEchoTask, "queue", benchHIGH_PRIORITY, NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        ( void ) xQueueSend( xPingQueue, &ulIteration, portMAX_DELAY );
+        ( void ) xQueueReceive( xPongQueue, &ulItem, portMAX_DELAY );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "queue_ping_pong", NULL, 0, benchSAMPLES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkSemaphore( void )
+{
+    SemaphoreHandle_t xSemaphore;
+    uint32_t ulIteration;
+    uint64_t ullStart;
+
+    xSemaphore = xSemaphoreCreateBinary();
+    configASSERT( xSemaphore != NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        ( void ) xSemaphoreGive( xSemaphore );
+        ( void ) xSemaphoreTake( xSemaphore, 0 );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "semaphore_give_take", NULL, 0, benchSAMPLES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkNotify( void )
+{
+    TaskHandle_t xEchoTask;
+    uint32_t ulIteration;
+    uint64_t ullStart;
+
+    xEchoTask = prvCreateHelper( prvNotifyEchoTask, "notify", benchHIGH_PRIORITY, NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        ( void ) xTaskNotifyGive( xEchoTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "notify_ping_pong", NULL, 0, benchSAMPLES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMutex( void )
+{
+    uint32_t ulIteration;
+    uint64_t ullStart;
+
+    xBenchmarkMutex = xSemaphoreCreateMutex();
+    configASSERT( xBenchmarkMutex != NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        ( void ) xSemaphoreTake( xBenchmarkMutex, 0 );
+        ( void ) xSemaphoreGive( xBenchmarkMutex );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "mutex_take_give", NULL, 0, benchSAMPLES, 0 );
+
+    /* Run above the holder so it is preempted as soon as it wakes this task,
+     * while it holds the mutex. */
+    vTaskPrioritySet( NULL, benchHIGH_PRIORITY );
+    ( void ) prvCreateHelper( prvMutexHolderTask, "mutex", benchLOW_PRIORITY, NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        ullStart = prvGetTimeNs();
+        ( void ) xSemaphoreTake( xBenchmarkMutex, portMAX_DELAY );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+
+        ( void ) xSemaphoreGive( xBenchmarkMutex );
+    }
+
+    vTaskPrioritySet( NULL, benchCONTROL_PRIORITY );
+
+    prvReport( "mutex_inheritance", NULL, 0, benchSAMPLES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkBuffers( void )
+{
+    static const uint32_t ulBlockBytes[] = { 16U, 128U, 1024U, benchMAX_BLOCK_BYTES };
+    uint32_t ulIteration;
+    uint64_t ullStart;
+    size_t x;
+
+    for( xBufferIsMessageBuffer = pdFALSE; xBufferIsMessageBuffer <= pdTRUE; xBufferIsMessageBuffer++ )
+    {
+        if( xBufferIsMessageBuffer != pdFALSE )
+        {
+            xBuffer = xMessageBufferCreate( benchBUFFER_BYTES );
+        }
+        else
+        {
+            xBuffer = xStreamBufferCreate( benchBUFFER_BYTES, 1 );
+        }
+
+        configASSERT( xBuffer != NULL );
+
+        for( x = 0; x < sizeof( ulBlockBytes ) / sizeof( ulBlockBytes[ 0 ] ); x++ )
+        {
+            xBufferBlockBytes = ulBlockBytes[ x ];
+            ( void ) prvCreateHelper( prvBufferReaderTask, "reader", benchHIGH_PRIORITY, NULL );
+
+            for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+            {
+                ullStart = prvGetTimeNs();
+
+                if( xBufferIsMessageBuffer != pdFALSE )
+                {
+                    ( void ) xMessageBufferSend( xBuffer, ucWriteBlock, xBufferBlockBytes, portMAX_DELAY );
+                }
+                else
+                {
+                    ( void ) xStreamBufferSend( xBuffer, ucWriteBlock, xBufferBlockBytes, portMAX_DELAY );
+                }
+
+                prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+            }
+
+            prvReport( ( xBufferIsMessageBuffer != pdFALSE ) ? "message_buffer" : "stream_buffer", "bytes", ulBlockBytes[ x ], benchSAMPLES, ulBlockBytes[ x ] );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTimers( void )
+{
+    TimerHandle_t xTimer;
+    uint32_t ulIteration;
+    uint64_t ullStart;
+
+    /* A period long enough that the timer does not expire while xTimerStart()
+     * is being timed. */
+    xTimer = xTimerCreate( "bench", pdMS_TO_TICKS( 10000 ), pdFALSE, NULL, prvTimerCallback );
+    configASSERT( xTimer != NULL );
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvGetTimeNs();
+        ( void ) xTimerStart( xTimer, portMAX_DELAY );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "timer_start", NULL, 0, benchSAMPLES, 0 );
+
+    ( void ) xTimerStop( xTimer, portMAX_DELAY );
+    ( void ) xTimerChangePeriod( xTimer, 1, portMAX_DELAY );
+    ( void ) xTimerStop( xTimer, portMAX_DELAY );
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+    for( ulIteration = 0; ulIteration < benchWARMUP + benchTIMER_EXPIRIES; ulIteration++ )
+    {
+        ( void ) xTimerStart( xTimer, portMAX_DELAY );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* The tick hook runs in the tick on which the timer expires, before
+         * the timer task is switched in. */
+        prvRecord( ulIteration, ullLastTickNs, ullTimerCallbackNs );
+    }
+
+    prvReport( "timer_expire", NULL, 0, benchTIMER_EXPIRIES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkEventGroup( void )
+{
+    const EventBits_t uxAllBits = ( ( EventBits_t ) 1U << benchFAN_OUT_TASKS ) - 1U;
+    uint32_t ulIteration;
+    uint64_t ullStart;
+    uintptr_t uxTask;
+
+    xFanOutGroup = xEventGroupCreate();
+    configASSERT( xFanOutGroup != NULL );
+
+    for( uxTask = 0; uxTask < benchFAN_OUT_TASKS; uxTask++ )
+    {
+        ( void ) prvCreateHelper( prvFanOutTask, "fan_out", benchHIGH_PRIORITY, ( void * ) uxTask );
+    }
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        /* Returns once every waiting task has run and cleared its bit. */
+        ullStart = prvGetTimeNs();
+        ( void ) xEventGroupSetBits( xFanOutGroup, uxAllBits );
+        prvRecord( ulIteration, ullStart, prvGetTimeNs() );
+    }
+
+    prvReport( "event_group_fan_out", "tasks", benchFAN_OUT_TASKS, benchSAMPLES, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkHeap( void )
+{
+    static const uint32_t ulBlockBytes[] = { 16U, 64U, 256U, 1024U };
+    static void * pvBlocks[ benchSAMPLES ];
+    static uint32_t ulFreeSamples[ benchSAMPLES ];
+    uint32_t ulBlock, ulIndex;
+    uint64_t ullStart;
+    size_t x;
+
+    for( x = 0; x < sizeof( ulBlockBytes ) / sizeof( ulBlockBytes[ 0 ] ); x++ )
+    {
+        /* Allocate every block before freeing any, so the free list is not
+         * always empty. */
+        for( ulBlock = 0; ulBlock < benchSAMPLES; ulBlock++ )
+        {
+            ullStart = prvGetTimeNs();
+            pvBlocks[ ulBlock ] = pvPortMalloc( ulBlockBytes[ x ] );
+            prvRecord( ulBlock + benchWARMUP, ullStart, prvGetTimeNs() );
+
+            if( pvBlocks[ ulBlock ] == NULL )
+            {
+                ( void ) printf( "Could not allocate a block - increase configTOTAL_HEAP_SIZE\n" );
+                exit( 1 );
+            }
+        }
+
+        prvReport( "heap_malloc", "bytes", ulBlockBytes[ x ], benchSAMPLES, 0 );
+
+        #if ( KERNEL_BENCHMARK_HEAP != 1 )
+        {
+            /* Free every other block first, so the heaps that combine adjacent
+             * free blocks have to do so for the second half. */
+            for( ulBlock = 0; ulBlock < benchSAMPLES; ulBlock++ )
+            {
+                ulIndex = ( ulBlock < ( benchSAMPLES / 2U ) ) ? ( ulBlock * 2U ) : ( ( ( ulBlock - ( benchSAMPLES / 2U ) ) * 2U ) + 1U );
+
+                ullStart = prvGetTimeNs();
+                vPortFree( pvBlocks[ ulIndex ] );
+                ulFreeSamples[ ulBlock ] = ( uint32_t ) ( prvGetTimeNs() - ullStart );
+            }
+
+            ( void ) memcpy( ulSamples, ulFreeSamples, sizeof( ulSamples ) );
+            prvReport( "heap_free", "bytes", ulBlockBytes[ x ], benchSAMPLES, 0 );
+        }
+        #endif /* KERNEL_BENCHMARK_HEAP */
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkISR( void )
+{
+    static const struct
+    {
+        const char * pcName;
+        UBaseType_t uxSourceID;
+        PortISRStimulusHandler_t pxHandler;
+    } xBenchmarks[] =
+    {
+        { "isr_queue_send",     benchISR_QUEUE_SOURCE,     prvQueueStimulus     },
+        { "isr_notify_give",    benchISR_NOTIFY_SOURCE,    prvNotifyStimulus    },
+        { "isr_semaphore_give", benchISR_SEMAPHORE_SOURCE, prvSemaphoreStimulus }
+    };
+    TaskHandle_t xWaiter;
+    size_t x;
+
+    xISRQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xISRSemaphore = xSemaphoreCreateBinary();
+    configASSERT( ( xISRQueue != NULL ) && ( xISRSemaphore != NULL ) );
+
+    for( x = 0; x < sizeof( xBenchmarks ) / sizeof( xBenchmarks[ 0 ] ); x++ )
+    {
+        xWaiter = prvCreateHelper( prvISRWaiterTask, "isr", benchHIGH_PRIORITY, ( void * ) ( uintptr_t ) xBenchmarks[ x ].uxSourceID );
+
+        if( xBenchmarks[ x ].uxSourceID == benchISR_NOTIFY_SOURCE )
+        {
+            xISRNotifyTask = xWaiter;
+        }
+
+        /* The waiter notifies this task once it has been woken benchITERATIONS
+         * times. */
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+        if( xPortStartISRStimulus( xBenchmarks[ x ].uxSourceID, xBenchmarks[ x ].pxHandler, benchISR_PERIOD_US ) != pdPASS )
+        {
+            ( void ) printf( "Could not start the interrupt stimulus\n" );
+            exit( 1 );
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        vPortStopISRStimulus( xBenchmarks[ x ].uxSourceID );
+
+        prvReportISRLatency( xBenchmarks[ x ].pcName, xBenchmarks[ x ].uxSourceID );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    ( void ) printf( "{\n  \"kernel\": \"%s\",\n  \"port\": \"GCC_POSIX\",\n  \"heap\": %d,\n  \"unit\": \"ns\",\n  \"results\": [",
+                     tskKERNEL_VERSION_NUMBER,
+                     ( int ) KERNEL_BENCHMARK_HEAP );
+
+    prvBenchmarkYield();
+    prvBenchmarkQueue();
+    prvBenchmarkSemaphore();
+    prvBenchmarkNotify();
+    prvBenchmarkMutex();
+    prvBenchmarkBuffers();
+    prvBenchmarkTimers();
+    prvBenchmarkEventGroup();
+    prvBenchmarkHeap();
+    prvBenchmarkISR();
+
+    ( void ) printf( "\n  ]\n}\n" );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    #if ( ( KERNEL_BENCHMARK_HEAP == 5 ) || ( KERNEL_BENCHMARK_HEAP == 6 ) )
+    {
+        static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+        HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeap, sizeof( ucHeap ) },
+            { NULL,   0                }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+    #endif /* KERNEL_BENCHMARK_HEAP */
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask );
+
+    /* Start the scheduler. */
+    vTaskStartScheduler();
+
+    for( ; ; )
+    {
+        /* Should not reach here. */
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    ullLastTickNs = prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * pcTaskName )
+{
+    ( void ) xTask;
+
+    ( void ) printf( "Stack overflow in %s\n", pcTaskName );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    ( void ) printf( "Assert failed at %s:%lu\n", pcFile, ulLine );
+    abort();
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,177 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of creating and deleting tasks on the POSIX port.
+ *
+ * A control task repeatedly creates a batch of lower priority tasks, each of
+ * which deletes itself as soon as it runs, then waits for the idle task to
+ * free them.  The average time taken by xTaskCreate(), and the average time to
+ * create, run and free each task, are printed at the end.  Build with
+ * -DTASK_CHURN_SINGLE_ALLOCATION=1 and/or -DTASK_CHURN_LAZY_STACK_FILL=1 to
+ * compare the task creation options, and -DTASK_CHURN_STACK_BYTES=<n> to
+ * change the stack size of the created tasks.
+ *
+ * Note that on the POSIX port each task is also a pthread, so the times
+ * include the cost of creating and joining a thread.
+ */
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+/* The number of tasks created before waiting for them to be deleted, and the
+ * number of times that is repeated. */
+#define churnBATCH_SIZE                  ( 16U )
+#define churnBATCHES                     ( 200U )
+
+#define churnWORKER_STACK_DEPTH          ( ( configSTACK_DEPTH_TYPE ) ( TASK_CHURN_STACK_BYTES / sizeof( StackType_t ) ) )
+#define churnWORKER_PRIORITY             ( tskIDLE_PRIORITY + 1U )
+#define churnCONTROL_PRIORITY            ( tskIDLE_PRIORITY + 2U )
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void );
+static void prvWorkerTask( void * pvParameters );
+static void prvControlTask( void * pvParameters ) __attribute__( ( noreturn ) );
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    UBaseType_t uxBaseTasks, uxTask;
+    uint32_t ulBatch;
+    uint64_t ullStart, ullCreated, ullCreateTime = 0, ullChurnTime = 0;
+    const uint32_t ulTasks = churnBATCH_SIZE * churnBATCHES;
+
+    ( void ) pvParameters;
+
+    uxBaseTasks = uxTaskGetNumberOfTasks();
+
+    for( ulBatch = 0; ulBatch < churnBATCHES; ulBatch++ )
+    {
+        ullStart = prvGetTimeNs();
+
+        for( uxTask = 0; uxTask < churnBATCH_SIZE; uxTask++ )
+        {
+            if( xTaskCreate( prvWorkerTask, "worker", churnWORKER_STACK_DEPTH, NULL, churnWORKER_PRIORITY, NULL ) != pdPASS )
+            {
+                ( void ) printf( "Could not create a task - increase configTOTAL_HEAP_SIZE\n" );
+                exit( 1 );
+            }
+        }
+
+        ullCreated = prvGetTimeNs();
+        ullCreateTime += ullCreated - ullStart;
+
+        /* Drop to the idle priority so the workers can run and delete
+         * themselves, and the idle task can free them, without waiting for a
+         * tick. */
+        vTaskPrioritySet( NULL, tskIDLE_PRIORITY );
+
+        while( uxTaskGetNumberOfTasks() > uxBaseTasks )
+        {
+            taskYIELD();
+        }
+
+        vTaskPrioritySet( NULL, churnCONTROL_PRIORITY );
+
+        ullChurnTime += prvGetTimeNs() - ullStart;
+    }
+
+    ( void ) printf( "configUSE_TASK_SINGLE_ALLOCATION %d, configUSE_LAZY_STACK_FILL %d, %u byte stacks\n",
+                     ( int ) configUSE_TASK_SINGLE_ALLOCATION,
+                     ( int ) configUSE_LAZY_STACK_FILL,
+                     ( unsigned ) TASK_CHURN_STACK_BYTES );
+    ( void ) printf( "%lu tasks, xTaskCreate() %lu ns, create to free %lu ns, control task high water mark %lu words\n",
+                     ( unsigned long ) ulTasks,
+                     ( unsigned long ) ( ullCreateTime / ulTasks ),
+                     ( unsigned long ) ( ullChurnTime / ulTasks ),
+                     ( unsigned long ) uxTaskGetStackHighWaterMark( NULL ) );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, churnCONTROL_PRIORITY, NULL );
+
+    /* Start the scheduler. */
+    vTaskStartScheduler();
+
+    for( ; ; )
+    {
+        /* Should not reach here. */
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * pcTaskName )
+{
+    ( void ) xTask;
+
+    ( void ) printf( "Stack overflow in %s\n", pcTaskName );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    ( void ) printf( "Assert failed at %s:%lu\n", pcFile, ulLine );
+    abort();
+}
+/*-----------------------------------------------------------*/
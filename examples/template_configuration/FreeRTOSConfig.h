@@ -253,6 +253,41 @@
 
 #define configUSE_EVENT_GROUPS    1
 
+/* Set configUSE_EVENT_GROUP_DIRECT_FROM_ISR to 1 to have
+ * xEventGroupSetBitsFromISR() and xEventGroupClearBitsFromISR() update the
+ * event group, and unblock waiting tasks, directly from the interrupt rather
+ * than deferring the operation to the timer task.  This removes the dependency
+ * on the timer task priority, at the cost of interrupt execution time that
+ * grows with the number of tasks blocked on the event group.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_EVENT_GROUP_DIRECT_FROM_ISR    0
+
+/* By default all the tasks blocked on an event group are held in one list, and
+ * every task in the list is evaluated each time a bit is set.  Set
+ * configEVENT_GROUP_WAITER_LISTS to a value greater than 0 to give each event
+ * group that number of additional lists, with bit N using list
+ * (N % configEVENT_GROUP_WAITER_LISTS), so setting a bit only evaluates the tasks
+ * waiting for that bit (or for a bit that shares its list).  Setting it to the
+ * number of usable event bits (8, 24 or 56 depending on
+ * configTICK_TYPE_WIDTH_IN_BITS) gives one list per bit.  Each list increases
+ * the size of every event group by the size of a List_t.  Defaults to 0 if left
+ * undefined. */
+#define configEVENT_GROUP_WAITER_LISTS           0
+
+/* Set configUSE_WIDE_EVENT_GROUPS to 1 to include the wide event group API
+ * (xWideEventGroupCreate() and friends), which provides event groups with any
+ * number of event bits.  Tasks that block on a wide event group are unblocked
+ * using the direct to task notification at index
+ * configWIDE_EVENT_GROUP_NOTIFICATION_INDEX, which must be between 1 and
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 and should not otherwise be used by
+ * those tasks.  Requires configUSE_TASK_NOTIFICATIONS to be 1 and
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES to be at least 2.
+ * configUSE_WIDE_EVENT_GROUPS defaults to 0, and
+ * configWIDE_EVENT_GROUP_NOTIFICATION_INDEX to
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, if left undefined. */
+#define configUSE_WIDE_EVENT_GROUPS                 0
+#define configWIDE_EVENT_GROUP_NOTIFICATION_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+
 /******************************************************************************/
 /* Stream Buffer related definitions. *****************************************/
 /******************************************************************************/
@@ -283,6 +318,19 @@
  * https://www.freertos.org/Static_Vs_Dynamic_Memory_Allocation.html. */
 #define configSUPPORT_DYNAMIC_ALLOCATION             1
 
+/* Set configUSE_ARENAS to 1 to include the arena API, which allocates groups of
+ * FreeRTOS objects from a single block of memory that is released in one
+ * operation, in the build.  Requires configSUPPORT_STATIC_ALLOCATION to be 1,
+ * and arena.c must be included in the project.  See arena.h.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_ARENAS                             0
+
+/* Set configUSE_TASK_SINGLE_ALLOCATION to 1 to have xTaskCreate() allocate a
+ * task's stack and TCB with one call to pvPortMallocStack(), and free them with
+ * one call to vPortFreeStack(), rather than making two allocations.  The TCB
+ * is then not taken from the object pools.  Defaults to 0 if left undefined. */
+#define configUSE_TASK_SINGLE_ALLOCATION             0
+
 /* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
  * or heap_4.c are included in the build.  This value is defaulted to 4096 bytes
  * but it must be tailored to each application.  Note the heap will appear in
@@ -307,6 +355,85 @@
  * catch pointer corruptions. Defaults to 0 if left undefined. */
 #define configENABLE_HEAP_PROTECTOR                  0
 
+/* Set configUSE_HEAP_CORE_CACHES to 1 to give each core a cache of small free
+ * blocks in front of the heap in heap_4.c and heap_5.c.  Blocks in the calling
+ * core's cache are allocated and freed with interrupts masked on that core,
+ * without suspending the scheduler, which on SMP serialises all the cores.
+ * Caches are refilled from, and returned to, the heap in batches.  Memory held
+ * in a cache is not included in xPortGetFreeHeapSize().  Defaults to 0 if left
+ * undefined. */
+#define configUSE_HEAP_CORE_CACHES                   0
+
+/* When configUSE_HEAP_CORE_CACHES is 1, blocks of up to
+ * configHEAP_CORE_CACHE_MAX_BLOCK_SIZE bytes, including the heap's per block
+ * header, are cached, and each core caches up to configHEAP_CORE_CACHE_DEPTH
+ * blocks of each size.  configHEAP_CORE_CACHE_MAX_BLOCK_SIZE must be a multiple
+ * of portBYTE_ALIGNMENT.  Default to 256 and 8 respectively if left
+ * undefined. */
+#define configHEAP_CORE_CACHE_MAX_BLOCK_SIZE         256
+#define configHEAP_CORE_CACHE_DEPTH                  8
+
+/* Set configUSE_KERNEL_OBJECT_POOLS to 1 to allocate task control blocks,
+ * semaphores, mutexes, software timers and event groups from per-type pools of
+ * fixed size objects, rather than directly from the heap.  Deleted objects are
+ * kept in their pool for reuse.  portable/MemMang/object_pools.c must be built
+ * along with the heap implementation.  Defaults to 0 if left undefined. */
+#define configUSE_KERNEL_OBJECT_POOLS                0
+
+/* When configUSE_KERNEL_OBJECT_POOLS is 1, set
+ * configKERNEL_OBJECT_POOL_GROW_ON_DEMAND to 0 to only use objects added to the
+ * pools by xPortObjectPoolReserve(), or 1 to allocate an object from the heap
+ * when its pool is empty.  Defaults to 1 if left undefined. */
+#define configKERNEL_OBJECT_POOL_GROW_ON_DEMAND      1
+
+/* configHEAP_TLSF_FL_INDEX_MAX and configHEAP_TLSF_SL_INDEX_COUNT_LOG2 size the
+ * free list array used by heap_6.c.  Blocks must be smaller than
+ * 2^configHEAP_TLSF_FL_INDEX_MAX bytes, and each power of two range of block
+ * sizes is divided into 2^configHEAP_TLSF_SL_INDEX_COUNT_LOG2 free lists.
+ * Larger values use more RAM.  Default to 24 and 4 respectively if left
+ * undefined. */
+#define configHEAP_TLSF_FL_INDEX_MAX                 24
+#define configHEAP_TLSF_SL_INDEX_COUNT_LOG2          4
+
+/* Set configKERNEL_BUFFER_ALIGNMENT to a power of two larger than
+ * portBYTE_ALIGNMENT, for example the cache line size, to have the task stacks
+ * and the queue and stream buffer storage areas allocated by the kernel start
+ * at a multiple of that many bytes.  Requires a heap implementation that
+ * provides pvPortMallocAligned(), such as heap_4.c or heap_5.c.  Defaults to 0,
+ * which leaves them portBYTE_ALIGNMENT aligned, if left undefined. */
+#define configKERNEL_BUFFER_ALIGNMENT                0
+
+/* Set configUSE_HEAP_REGION_PLACEMENT to 1 to give each HeapRegion_t passed to
+ * vPortDefineHeapRegions() a uxTag member, 0 for the fastest memory and larger
+ * values for slower memory.  Task control blocks, stacks, queues, stream
+ * buffers, timers, event groups and other allocations are then each taken from
+ * the regions with the tag set by vPortSetHeapPlacement(), falling back to
+ * other regions when those are full.  Only supported by heap_5.c, which
+ * records up to configHEAP_PLACEMENT_MAX_REGIONS regions.  Cannot be used with
+ * configUSE_HEAP_CORE_CACHES or configUSE_HEAP_PROFILER.  Default to 0 and 8
+ * respectively if left undefined. */
+#define configUSE_HEAP_REGION_PLACEMENT              0
+#define configHEAP_PLACEMENT_MAX_REGIONS             8
+
+/* Set configUSE_HEAP_PROFILER to 1 to record the live bytes of each call site
+ * and each task, and histograms of allocation sizes and times, in front of the
+ * heap implementation.  Read the results with vPortHeapProfilerGetSnapshot(),
+ * declared in heap_profiler.h.  portable/MemMang/heap_profiler.c must be built
+ * along with the heap implementation, and an application supplied heap must
+ * define HEAP_IMPLEMENTATION_FILE before including FreeRTOS.h.  Defaults to 0
+ * if left undefined. */
+#define configUSE_HEAP_PROFILER                      0
+
+/* When configUSE_HEAP_PROFILER is 1, configHEAP_PROFILER_MAX_CALL_SITES and
+ * configHEAP_PROFILER_MAX_TASKS set the number of call sites and tasks the
+ * profiler can tell apart.  Allocations that do not fit are counted together.
+ * Set configHEAP_PROFILER_INCLUDE_HEAP_STATS to 0 if the heap implementation
+ * does not provide vPortGetHeapStats().  Default to 32, 16 and 1 respectively
+ * if left undefined. */
+#define configHEAP_PROFILER_MAX_CALL_SITES           32
+#define configHEAP_PROFILER_MAX_TASKS                16
+#define configHEAP_PROFILER_INCLUDE_HEAP_STATS       1
+
 /******************************************************************************/
 /* Interrupt nesting behaviour configuration. *********************************/
 /******************************************************************************/
@@ -350,6 +477,12 @@
  * with application provided callbacks. Defaults to 0 if left undefined. */
 #define configUSE_SB_COMPLETED_CALLBACK       0
 
+/* Set configUSE_SB_MAX_LATENCY to 1 to make xStreamBufferSetMaxLatency()
+ * available.  xStreamBufferSetMaxLatency() sets the longest time data can wait
+ * in a stream batching buffer before a blocked reader is unblocked, even if the
+ * trigger level has not been reached.  Defaults to 0 if left undefined. */
+#define configUSE_SB_MAX_LATENCY              0
+
 /* Set configCHECK_FOR_STACK_OVERFLOW to 1 or 2 for FreeRTOS to check for a
  * stack overflow at the time of a context switch.  Set to 0 to not look for a
  * stack overflow.  If configCHECK_FOR_STACK_OVERFLOW is 1 then the check only
@@ -388,6 +521,97 @@
  * undefined. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* Set configUSE_STACK_HIGH_WATER_MARK_CACHE to 1 to have each task remember
+ * the stack high water mark found the last time its stack was scanned.  A
+ * task's stack is then only scanned again if the task has run since the last
+ * scan, and the scan stops at the previous mark, which makes calling
+ * uxTaskGetStackHighWaterMark(), uxTaskGetSystemState() or vTaskListTasks()
+ * periodically much cheaper.  Adds a few bytes to each task and one store to
+ * each context switch.  Defaults to 0 if left undefined. */
+#define configUSE_STACK_HIGH_WATER_MARK_CACHE    0
+
+/* Set configUSE_LAZY_STACK_FILL to 1 to only fill the few words at the far end
+ * of a new task's stack with the known value used for stack overflow checking
+ * and high water marks, rather than the whole stack, which makes creating
+ * tasks with large stacks much faster.  The rest of the unused stack is filled
+ * once, the first time the task's high water mark is requested by another task,
+ * so the high water mark only reflects stack used after that point.  Defaults
+ * to 0 if left undefined. */
+#define configUSE_LAZY_STACK_FILL                0
+
+/* Set configUSE_TASK_WAKE_LATENCY to 1 to have each task keep a histogram of
+ * the time between it leaving the Blocked or Suspended state and it running,
+ * which can be read with vTaskGetWakeLatency().  Latencies are measured with
+ * the run time stats clock, so configGENERATE_RUN_TIME_STATS must also be 1.
+ * configTASK_WAKE_LATENCY_BUCKETS sets the number of power of 2 sized buckets
+ * in each histogram.  Defaults to 0 if left undefined. */
+#define configUSE_TASK_WAKE_LATENCY              0
+#define configTASK_WAKE_LATENCY_BUCKETS          16
+
+/* Set configUSE_CRITICAL_PROFILER to 1 to measure how long critical sections
+ * and scheduler suspension are held on each core, and which code held them
+ * longest.  The results are read with vCriticalProfilerGetStats().
+ * critical_profiler.c must be included in the build.  Hold times are measured
+ * with configCRITICAL_PROFILER_GET_TIME(), which defaults to the port's high
+ * resolution clock if it has one, otherwise to the run time stats clock.  See
+ * critical_profiler.h.  Defaults to 0 if left undefined. */
+#define configUSE_CRITICAL_PROFILER              0
+#define configCRITICAL_PROFILER_BUCKETS          32
+#define configCRITICAL_PROFILER_WORST_CALLERS    4
+
+/* Set configUSE_QUEUE_STATS to 1 to count the sends, receives, blocks and wait
+ * times of each queue, semaphore and mutex, along with the peak number of items
+ * queued and, for mutexes, hold times and priority inheritance events.  Read
+ * them with vQueueGetStats(), or for every queue in the queue registry at once
+ * with uxQueueGetRegistryStats().  Set configUSE_STREAM_BUFFER_STATS to 1 to
+ * keep similar statistics for stream and message buffers, read with
+ * vStreamBufferGetStats().  Both default to 0 if left undefined. */
+#define configUSE_QUEUE_STATS                    0
+#define configUSE_STREAM_BUFFER_STATS            0
+
+/* Set configUSE_TASK_SNAPSHOT to 1 to include vTaskSnapshotBegin() and
+ * uxTaskSnapshotNext(), which read the state of every task as fixed size binary
+ * records, a few at a time, without suspending the scheduler for longer than it
+ * takes to fill each chunk.  Requires configUSE_TRACE_FACILITY to be 1.
+ * Defaults to 0 if left undefined. */
+#define configUSE_TASK_SNAPSHOT                  0
+
+/* Set configUSE_PRIORITY_INVERSION_STATS to 1 to have each task record how
+ * often and for how long it ran at an inherited priority, how long it waited
+ * for mutexes held by other tasks, and the chain of mutex holders behind its
+ * longest wait.  Read them with vTaskGetInversionStats(), or for every task with
+ * vTaskListInversionChains().  configPRIORITY_INVERSION_CHAIN_DEPTH sets the
+ * number of holders kept per chain.  Requires configUSE_MUTEXES and
+ * configGENERATE_RUN_TIME_STATS to be 1.  Defaults to 0 and 4 respectively if
+ * left undefined. */
+#define configUSE_PRIORITY_INVERSION_STATS       0
+#define configPRIORITY_INVERSION_CHAIN_DEPTH     4
+
+/* Set configUSE_ISR_WAKE_LATENCY to 1 to record, for each interrupt source, a
+ * histogram of the time from a *FromISR() API function waking a task to the
+ * task running.  An interrupt marks itself as a source by calling
+ * uxTaskSetISRWakeSourceFromISR(), and the histograms are read with
+ * vTaskGetISRWakeLatency().  configISR_WAKE_LATENCY_SOURCES sets the number of
+ * sources, and configTASK_WAKE_LATENCY_BUCKETS the number of buckets in each
+ * histogram.  Requires configGENERATE_RUN_TIME_STATS to be 1.  Defaults to 0
+ * and 8 respectively if left undefined. */
+#define configUSE_ISR_WAKE_LATENCY               0
+#define configISR_WAKE_LATENCY_SOURCES           8
+
+/* Set configUSE_TRACE_RECORDER to 1 to record kernel events, such as context
+ * switches and queue operations, into a RAM buffer that can be written out with
+ * xTraceRecorderDump() and viewed on a timeline.  trace_recorder.c must be
+ * included in the build.  configTRACE_RECORDER_BUFFER_EVENTS sets the number of
+ * 16 byte events kept per core and must be a power of 2.
+ * configTRACE_RECORDER_GET_TIMESTAMP() defaults to
+ * portGET_RUN_TIME_COUNTER_VALUE(), and configTRACE_RECORDER_TIMESTAMP_HZ
+ * should be set to its frequency.  See examples/trace_recorder.  Defaults to 0
+ * if left undefined. */
+#define configUSE_TRACE_RECORDER                 0
+#define configTRACE_RECORDER_BUFFER_EVENTS       1024
+#define configTRACE_RECORDER_MAX_OBJECTS         32
+#define configTRACE_RECORDER_TIMESTAMP_HZ        0
+
 /******************************************************************************/
 /* Co-routine related definitions. ********************************************/
 /******************************************************************************/
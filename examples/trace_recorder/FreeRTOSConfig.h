@@ -0,0 +1,75 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Configuration used by the trace recorder demo, which runs on the POSIX port.
+ * See examples/template_configuration/FreeRTOSConfig.h for a description of
+ * each setting. */
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configTICK_RATE_HZ                      1000
+#define configMINIMAL_STACK_SIZE                ( ( configSTACK_DEPTH_TYPE ) 1024 )
+#define configMAX_PRIORITIES                    5
+#define configMAX_TASK_NAME_LEN                 16
+#define configTICK_TYPE_WIDTH_IN_BITS           TICK_TYPE_WIDTH_64_BITS
+#define configSTACK_DEPTH_TYPE                  size_t
+#define configUSE_MUTEXES                       1
+#define configUSE_TIMERS                        0
+#define configQUEUE_REGISTRY_SIZE               4
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) 1024 * 1024 )
+#define configCHECK_FOR_STACK_OVERFLOW          2
+
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskDelay                      1
+
+/* Record kernel events with microsecond timestamps from the host's monotonic
+ * clock. */
+#define configUSE_TRACE_RECORDER                1
+#define configTRACE_RECORDER_BUFFER_EVENTS      4096
+#define configTRACE_RECORDER_GET_TIMESTAMP()    ulTraceTimestampMicroseconds()
+#define configTRACE_RECORDER_TIMESTAMP_HZ       1000000
+
+#define configASSERT( x )                       \
+    if( ( x ) == 0 )                            \
+    {                                           \
+        vAssertCalled( __FILE__, __LINE__ );    \
+    }
+
+#include <stdint.h>
+
+extern uint32_t ulTraceTimestampMicroseconds( void );
+extern void vAssertCalled( const char * pcFile,
+                           unsigned long ulLine );
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,238 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Demonstrates the trace recorder on the POSIX port.
+ *
+ * A producer task sends a sample to a queue every millisecond, a consumer task
+ * receives the samples and notifies a reporter task after every tenth sample,
+ * and the reporter records a user event with the running total.  After
+ * traceRUN_TIME_MS milliseconds the control task stops the recorder and writes
+ * the recording to the file named on the command line, or to trace.bin, which
+ * can then be converted for Perfetto with:
+ *
+ *     trace_converter trace.bin trace.json
+ */
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define traceRUN_TIME_MS             ( 200U )
+#define traceQUEUE_LENGTH            ( 8U )
+#define traceSAMPLES_PER_REPORT      ( 10U )
+
+/* The ID of the user event recorded by the reporter task. */
+#define traceREPORT_EVENT_ID         ( ( uint16_t ) 1U )
+
+#define traceCONTROL_PRIORITY        ( tskIDLE_PRIORITY + 4U )
+#define traceREPORTER_PRIORITY       ( tskIDLE_PRIORITY + 3U )
+#define traceCONSUMER_PRIORITY       ( tskIDLE_PRIORITY + 2U )
+#define tracePRODUCER_PRIORITY       ( tskIDLE_PRIORITY + 1U )
+
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters ) __attribute__( ( noreturn ) );
+static void prvConsumerTask( void * pvParameters ) __attribute__( ( noreturn ) );
+static void prvReporterTask( void * pvParameters ) __attribute__( ( noreturn ) );
+static void prvControlTask( void * pvParameters ) __attribute__( ( noreturn ) );
+static BaseType_t prvWriteToFile( const void * pvData,
+                                  size_t xLength,
+                                  void * pvContext );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xSampleQueue = NULL;
+static TaskHandle_t xReporterTask = NULL;
+static const char * pcTraceFileName = "trace.bin";
+
+/*-----------------------------------------------------------*/
+
+uint32_t ulTraceTimestampMicroseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( uint32_t ) ( ( ( uint64_t ) xNow.tv_sec * 1000000ULL ) + ( ( uint64_t ) xNow.tv_nsec / 1000ULL ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    uint32_t ulSample = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueSend( xSampleQueue, &ulSample, portMAX_DELAY );
+        ulSample++;
+        vTaskDelay( pdMS_TO_TICKS( 1 ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    uint32_t ulSample;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( xQueueReceive( xSampleQueue, &ulSample, portMAX_DELAY ) == pdPASS )
+        {
+            if( ( ulSample % traceSAMPLES_PER_REPORT ) == ( traceSAMPLES_PER_REPORT - 1U ) )
+            {
+                xTaskNotifyGive( xReporterTask );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReporterTask( void * pvParameters )
+{
+    uint32_t ulReports = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulReports += ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        vTraceRecorderUserEvent( traceREPORT_EVENT_ID, ulReports * traceSAMPLES_PER_REPORT );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteToFile( const void * pvData,
+                                  size_t xLength,
+                                  void * pvContext )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    if( fwrite( pvData, 1, xLength, ( FILE * ) pvContext ) == xLength )
+    {
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    FILE * pxFile;
+    BaseType_t xResult = pdFAIL;
+
+    ( void ) pvParameters;
+
+    vTaskDelay( pdMS_TO_TICKS( traceRUN_TIME_MS ) );
+
+    /* The recording must be stopped before it is written out. */
+    vTraceRecorderStop();
+
+    pxFile = fopen( pcTraceFileName, "wb" );
+
+    if( pxFile != NULL )
+    {
+        xResult = xTraceRecorderDump( prvWriteToFile, pxFile );
+
+        if( fclose( pxFile ) != 0 )
+        {
+            xResult = pdFAIL;
+        }
+    }
+
+    if( xResult == pdPASS )
+    {
+        ( void ) printf( "Trace written to %s\n", pcTraceFileName );
+        exit( 0 );
+    }
+
+    ( void ) printf( "Could not write the trace to %s\n", pcTraceFileName );
+    exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    if( argc > 1 )
+    {
+        pcTraceFileName = argv[ 1 ];
+    }
+
+    xSampleQueue = xQueueCreate( traceQUEUE_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xSampleQueue );
+
+    /* Registered queues are shown by name in the trace. */
+    vQueueAddToRegistry( xSampleQueue, "samples" );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, traceCONTROL_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvReporterTask, "reporter", configMINIMAL_STACK_SIZE, NULL, traceREPORTER_PRIORITY, &xReporterTask );
+    ( void ) xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE, NULL, traceCONSUMER_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, NULL, tracePRODUCER_PRIORITY, NULL );
+
+    /* Start the scheduler. */
+    vTaskStartScheduler();
+
+    for( ; ; )
+    {
+        /* Should not reach here. */
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * pcTaskName )
+{
+    ( void ) xTask;
+
+    ( void ) printf( "Stack overflow in %s\n", pcTaskName );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    ( void ) printf( "Assert failed at %s:%lu\n", pcFile, ulLine );
+    abort();
+}
+/*-----------------------------------------------------------*/
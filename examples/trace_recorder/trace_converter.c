@@ -0,0 +1,403 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Converts a recording written by xTraceRecorderDump() to the JSON trace event
+ * format, which can be opened in Perfetto (https://ui.perfetto.dev) or
+ * chrome://tracing.  This is a host program and does not use FreeRTOS.
+ *
+ * Usage: trace_converter <recording> [<output.json>]
+ *
+ * Each core is shown as a track.  The time between one task being switched in
+ * and the next is shown as a slice named after the task, and every other event
+ * is shown as an instant event with its object and value as arguments.  The
+ * binary format is described in include/trace_recorder.h.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define convHEADER_BYTES      ( 20U )
+#define convEVENT_BYTES       ( 16U )
+#define convFORMAT_VERSION    ( 1U )
+#define convMAX_NAME_LEN      ( 256U )
+
+/* Values from include/trace_recorder.h. */
+#define convEVENT_TASK_SWITCHED_IN    ( 1U )
+#define convEVENT_USER                ( 60U )
+
+typedef struct ConverterObject
+{
+    uint32_t ulObject;
+    uint8_t ucObjectType;
+    char cName[ convMAX_NAME_LEN + 1U ];
+} ConverterObject_t;
+
+typedef struct ConverterEvent
+{
+    uint32_t ulTimestamp;
+    uint8_t ucEventCode;
+    uint8_t ucCoreID;
+    uint16_t usParameter;
+    uint32_t ulObject;
+    uint32_t ulValue;
+} ConverterEvent_t;
+
+/*-----------------------------------------------------------*/
+
+static ConverterObject_t * pxObjects = NULL;
+static uint32_t ulObjectCount = 0;
+static double dTicksPerMicrosecond = 1.0;
+
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcMessage )
+{
+    ( void ) fprintf( stderr, "trace_converter: %s\n", pcMessage );
+    exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvGetUint32( const uint8_t * pucSource )
+{
+    return ( uint32_t ) pucSource[ 0 ] |
+           ( ( uint32_t ) pucSource[ 1 ] << 8 ) |
+           ( ( uint32_t ) pucSource[ 2 ] << 16 ) |
+           ( ( uint32_t ) pucSource[ 3 ] << 24 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRead( FILE * pxFile,
+                     uint8_t * pucBuffer,
+                     size_t xLength )
+{
+    if( fread( pucBuffer, 1, xLength, pxFile ) != xLength )
+    {
+        prvFail( "the recording is truncated" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static const char * prvEventName( uint8_t ucEventCode )
+{
+    switch( ucEventCode )
+    {
+        case 1: return "switched in";
+        case 2: return "ready";
+        case 3: return "task create";
+        case 4: return "task delete";
+        case 5: return "delay";
+        case 6: return "delay until";
+        case 7: return "suspend";
+        case 8: return "resume";
+        case 9: return "resume from ISR";
+        case 10: return "priority set";
+        case 11: return "priority inherit";
+        case 12: return "priority disinherit";
+        case 13: return "notify";
+        case 14: return "notify from ISR";
+        case 15: return "notify wait (blocking)";
+        case 16: return "notify wait";
+        case 20: return "queue create";
+        case 21: return "queue delete";
+        case 22: return "queue send";
+        case 23: return "queue send from ISR";
+        case 24: return "queue send failed";
+        case 25: return "queue receive";
+        case 26: return "queue receive from ISR";
+        case 27: return "queue receive failed";
+        case 28: return "queue peek";
+        case 29: return "queue send (blocking)";
+        case 30: return "queue receive (blocking)";
+        case 31: return "mutex create";
+        case 40: return "ISR enter";
+        case 41: return "ISR exit";
+        case 42: return "ISR exit to scheduler";
+        case 50: return "timer expired";
+        case 51: return "event group set bits";
+        case 52: return "event group wait (blocking)";
+        case 60: return "user event";
+        default: return "unknown event";
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Writes the name of ulObject as a JSON string. */
+static void prvWriteObjectName( FILE * pxOutput,
+                                uint32_t ulObject )
+{
+    uint32_t ulIndex;
+    const char * pcName = NULL;
+    const char * pc;
+
+    for( ulIndex = 0; ulIndex < ulObjectCount; ulIndex++ )
+    {
+        if( pxObjects[ ulIndex ].ulObject == ulObject )
+        {
+            pcName = pxObjects[ ulIndex ].cName;
+            break;
+        }
+    }
+
+    if( pcName == NULL )
+    {
+        ( void ) fprintf( pxOutput, "\"0x%08lx\"", ( unsigned long ) ulObject );
+    }
+    else
+    {
+        ( void ) fputc( '"', pxOutput );
+
+        for( pc = pcName; *pc != '\0'; pc++ )
+        {
+            if( ( *pc == '"' ) || ( *pc == '\\' ) )
+            {
+                ( void ) fputc( '\\', pxOutput );
+                ( void ) fputc( *pc, pxOutput );
+            }
+            else if( ( ( unsigned char ) *pc ) < 0x20U )
+            {
+                ( void ) fputc( '?', pxOutput );
+            }
+            else
+            {
+                ( void ) fputc( *pc, pxOutput );
+            }
+        }
+
+        ( void ) fputc( '"', pxOutput );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSlice( FILE * pxOutput,
+                           uint32_t ulCore,
+                           const ConverterEvent_t * pxSwitchedIn,
+                           uint64_t ullStart,
+                           uint64_t ullEnd )
+{
+    ( void ) fprintf( pxOutput, ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                      ( unsigned long ) ulCore,
+                      ( double ) ullStart / dTicksPerMicrosecond,
+                      ( double ) ( ullEnd - ullStart ) / dTicksPerMicrosecond );
+    prvWriteObjectName( pxOutput, pxSwitchedIn->ulObject );
+    ( void ) fprintf( pxOutput, ",\"args\":{\"priority\":%lu}}", ( unsigned long ) pxSwitchedIn->ulValue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteInstant( FILE * pxOutput,
+                             uint32_t ulCore,
+                             const ConverterEvent_t * pxEvent,
+                             uint64_t ullTime )
+{
+    ( void ) fprintf( pxOutput, ",\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%lu,\"ts\":%.3f,\"name\":\"%s",
+                      ( unsigned long ) ulCore,
+                      ( double ) ullTime / dTicksPerMicrosecond,
+                      prvEventName( pxEvent->ucEventCode ) );
+
+    if( pxEvent->ucEventCode == convEVENT_USER )
+    {
+        ( void ) fprintf( pxOutput, " %u", ( unsigned ) pxEvent->usParameter );
+    }
+
+    ( void ) fprintf( pxOutput, "\",\"args\":{" );
+
+    if( pxEvent->ulObject != 0U )
+    {
+        ( void ) fprintf( pxOutput, "\"object\":" );
+        prvWriteObjectName( pxOutput, pxEvent->ulObject );
+        ( void ) fprintf( pxOutput, "," );
+    }
+
+    ( void ) fprintf( pxOutput, "\"value\":%lu}}", ( unsigned long ) pxEvent->ulValue );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    FILE * pxInput;
+    FILE * pxOutput = stdout;
+    uint8_t ucHeader[ convHEADER_BYTES ];
+    uint8_t ucRecord[ 5U + convMAX_NAME_LEN ];
+    uint8_t ucEvent[ convEVENT_BYTES ];
+    uint32_t ulCores, ulNameLength, ulHz, ulIndex, ulCore, ulEventsWritten, ulEvents;
+    ConverterEvent_t xEvent, xSwitchedIn;
+    uint64_t ullTime, ullSwitchedInTime = 0;
+    uint32_t ulLastTimestamp = 0;
+    int iHaveSwitchedIn;
+
+    if( ( argc < 2 ) || ( argc > 3 ) )
+    {
+        ( void ) fprintf( stderr, "Usage: %s <recording> [<output.json>]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    pxInput = fopen( argv[ 1 ], "rb" );
+
+    if( pxInput == NULL )
+    {
+        prvFail( "cannot open the recording" );
+    }
+
+    if( argc == 3 )
+    {
+        pxOutput = fopen( argv[ 2 ], "w" );
+
+        if( pxOutput == NULL )
+        {
+            prvFail( "cannot open the output file" );
+        }
+    }
+
+    prvRead( pxInput, ucHeader, sizeof( ucHeader ) );
+
+    if( ( memcmp( ucHeader, "FRTR", 4 ) != 0 ) ||
+        ( ucHeader[ 4 ] != convFORMAT_VERSION ) ||
+        ( ucHeader[ 7 ] != convEVENT_BYTES ) )
+    {
+        prvFail( "not a version 1 trace recorder recording" );
+    }
+
+    ulCores = ucHeader[ 5 ];
+    ulNameLength = ucHeader[ 6 ];
+    ulHz = prvGetUint32( &( ucHeader[ 8 ] ) );
+    ulObjectCount = prvGetUint32( &( ucHeader[ 16 ] ) );
+
+    /* A frequency of 0 means it is not known, in which case timestamps are
+     * shown as if they were microseconds. */
+    if( ulHz != 0U )
+    {
+        dTicksPerMicrosecond = ( double ) ulHz / 1000000.0;
+    }
+
+    pxObjects = calloc( ulObjectCount + 1U, sizeof( ConverterObject_t ) );
+
+    if( pxObjects == NULL )
+    {
+        prvFail( "out of memory" );
+    }
+
+    for( ulIndex = 0; ulIndex < ulObjectCount; ulIndex++ )
+    {
+        prvRead( pxInput, ucRecord, 5U + ulNameLength );
+        pxObjects[ ulIndex ].ulObject = prvGetUint32( ucRecord );
+        pxObjects[ ulIndex ].ucObjectType = ucRecord[ 4 ];
+        memcpy( pxObjects[ ulIndex ].cName, &( ucRecord[ 5 ] ), ulNameLength );
+        pxObjects[ ulIndex ].cName[ ulNameLength ] = '\0';
+    }
+
+    ( void ) fprintf( pxOutput, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+    ( void ) fprintf( pxOutput, "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"FreeRTOS\"}}" );
+
+    for( ulCore = 0; ulCore < ulCores; ulCore++ )
+    {
+        uint8_t ucCoreHeader[ 8 ];
+
+        prvRead( pxInput, ucCoreHeader, sizeof( ucCoreHeader ) );
+        ulEventsWritten = prvGetUint32( ucCoreHeader );
+        ulEvents = prvGetUint32( &( ucCoreHeader[ 4 ] ) );
+
+        ( void ) fprintf( pxOutput, ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%lu,\"name\":\"thread_name\",\"args\":{\"name\":\"Core %lu\"}}",
+                          ( unsigned long ) ulCore, ( unsigned long ) ulCore );
+
+        if( ulEventsWritten > ulEvents )
+        {
+            ( void ) fprintf( stderr, "trace_converter: core %lu: the oldest %lu events were overwritten\n",
+                              ( unsigned long ) ulCore, ( unsigned long ) ( ulEventsWritten - ulEvents ) );
+        }
+
+        iHaveSwitchedIn = 0;
+        ullTime = 0;
+
+        for( ulIndex = 0; ulIndex < ulEvents; ulIndex++ )
+        {
+            prvRead( pxInput, ucEvent, sizeof( ucEvent ) );
+            xEvent.ulTimestamp = prvGetUint32( ucEvent );
+            xEvent.ucEventCode = ucEvent[ 4 ];
+            xEvent.ucCoreID = ucEvent[ 5 ];
+            xEvent.usParameter = ( uint16_t ) ( ucEvent[ 6 ] | ( ucEvent[ 7 ] << 8 ) );
+            xEvent.ulObject = prvGetUint32( &( ucEvent[ 8 ] ) );
+            xEvent.ulValue = prvGetUint32( &( ucEvent[ 12 ] ) );
+
+            /* Timestamps are 32 bits so wrap.  They are extended to 64 bits by
+             * accumulating the difference between consecutive events, which is
+             * correct as long as no two consecutive events are more than 2^32
+             * ticks apart. */
+            if( ulIndex == 0U )
+            {
+                ullTime = xEvent.ulTimestamp;
+            }
+            else
+            {
+                ullTime += ( uint32_t ) ( xEvent.ulTimestamp - ulLastTimestamp );
+            }
+
+            ulLastTimestamp = xEvent.ulTimestamp;
+
+            if( xEvent.ucEventCode == convEVENT_TASK_SWITCHED_IN )
+            {
+                if( iHaveSwitchedIn != 0 )
+                {
+                    prvWriteSlice( pxOutput, ulCore, &xSwitchedIn, ullSwitchedInTime, ullTime );
+                }
+
+                xSwitchedIn = xEvent;
+                ullSwitchedInTime = ullTime;
+                iHaveSwitchedIn = 1;
+            }
+            else
+            {
+                prvWriteInstant( pxOutput, ulCore, &xEvent, ullTime );
+            }
+        }
+
+        /* The task that was running when recording stopped runs until the
+         * last event recorded on the core. */
+        if( iHaveSwitchedIn != 0 )
+        {
+            prvWriteSlice( pxOutput, ulCore, &xSwitchedIn, ullSwitchedInTime, ullTime );
+        }
+    }
+
+    ( void ) fprintf( pxOutput, "\n]}\n" );
+
+    ( void ) fclose( pxInput );
+
+    if( ( pxOutput != stdout ) && ( fclose( pxOutput ) != 0 ) )
+    {
+        prvFail( "cannot write the output file" );
+    }
+
+    free( pxObjects );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
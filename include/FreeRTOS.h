@@ -123,6 +123,19 @@
 
 #endif /* if ( configUSE_PICOLIBC_TLS == 1 ) */
 
+/* Must be defaulted before configUSE_TRACE_RECORDER is used below. */
+#ifndef configUSE_TRACE_RECORDER
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+/* The trace recorder defines the trace macros, so must be included before the
+ * trace macros are defaulted below. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #include "trace_recorder.h"
+
+#endif /* if ( configUSE_TRACE_RECORDER == 1 ) */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -322,6 +335,18 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+#ifndef configUSE_EVENT_GROUP_DIRECT_FROM_ISR
+    #define configUSE_EVENT_GROUP_DIRECT_FROM_ISR    0
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_LISTS
+    #define configEVENT_GROUP_WAITER_LISTS    0
+#endif
+
+#ifndef configUSE_WIDE_EVENT_GROUPS
+    #define configUSE_WIDE_EVENT_GROUPS    0
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
@@ -706,6 +731,58 @@
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
 
+#ifndef configUSE_STACK_HIGH_WATER_MARK_CACHE
+    #define configUSE_STACK_HIGH_WATER_MARK_CACHE    0
+#endif
+
+#ifndef configUSE_TASK_SINGLE_ALLOCATION
+    #define configUSE_TASK_SINGLE_ALLOCATION    0
+#endif
+
+#ifndef configUSE_LAZY_STACK_FILL
+    #define configUSE_LAZY_STACK_FILL    0
+#endif
+
+#ifndef configUSE_TASK_WAKE_LATENCY
+    #define configUSE_TASK_WAKE_LATENCY    0
+#endif
+
+#ifndef configTASK_WAKE_LATENCY_BUCKETS
+    #define configTASK_WAKE_LATENCY_BUCKETS    16
+#endif
+
+#ifndef configUSE_CRITICAL_PROFILER
+    #define configUSE_CRITICAL_PROFILER    0
+#endif
+
+#ifndef configUSE_QUEUE_STATS
+    #define configUSE_QUEUE_STATS    0
+#endif
+
+#ifndef configUSE_TASK_SNAPSHOT
+    #define configUSE_TASK_SNAPSHOT    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_STATS
+    #define configUSE_STREAM_BUFFER_STATS    0
+#endif
+
+#ifndef configUSE_PRIORITY_INVERSION_STATS
+    #define configUSE_PRIORITY_INVERSION_STATS    0
+#endif
+
+#ifndef configPRIORITY_INVERSION_CHAIN_DEPTH
+    #define configPRIORITY_INVERSION_CHAIN_DEPTH    4
+#endif
+
+#ifndef configUSE_ISR_WAKE_LATENCY
+    #define configUSE_ISR_WAKE_LATENCY    0
+#endif
+
+#ifndef configISR_WAKE_LATENCY_SOURCES
+    #define configISR_WAKE_LATENCY_SOURCES    8
+#endif
+
 #ifndef configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
     #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H    0
 #endif
@@ -1052,6 +1129,14 @@
     #define traceRETURN_xEventGroupCreateStatic( pxEventBits )
 #endif
 
+#ifndef traceENTER_xEventGroupCreateInArena
+    #define traceENTER_xEventGroupCreateInArena( xArena )
+#endif
+
+#ifndef traceRETURN_xEventGroupCreateInArena
+    #define traceRETURN_xEventGroupCreateInArena( pxEventBits )
+#endif
+
 #ifndef traceENTER_xEventGroupCreate
     #define traceENTER_xEventGroupCreate()
 #endif
@@ -1148,6 +1233,70 @@
     #define traceRETURN_xEventGroupSetBitsFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xWideEventGroupCreate
+    #define traceENTER_xWideEventGroupCreate( uxNumberOfBits )
+#endif
+
+#ifndef traceRETURN_xWideEventGroupCreate
+    #define traceRETURN_xWideEventGroupCreate( pxEventBits )
+#endif
+
+#ifndef traceENTER_xWideEventGroupCreateStatic
+    #define traceENTER_xWideEventGroupCreateStatic( uxNumberOfBits, puxEventBitsBuffer, pxEventGroupBuffer )
+#endif
+
+#ifndef traceRETURN_xWideEventGroupCreateStatic
+    #define traceRETURN_xWideEventGroupCreateStatic( pxEventBits )
+#endif
+
+#ifndef traceENTER_xWideEventGroupWaitBits
+    #define traceENTER_xWideEventGroupWaitBits( xEventGroup, puxBitsToWaitFor, puxEventBits, xClearOnExit, xWaitForAllBits, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xWideEventGroupWaitBits
+    #define traceRETURN_xWideEventGroupWaitBits( xReturn )
+#endif
+
+#ifndef traceENTER_vWideEventGroupSetBits
+    #define traceENTER_vWideEventGroupSetBits( xEventGroup, puxBitsToSet )
+#endif
+
+#ifndef traceRETURN_vWideEventGroupSetBits
+    #define traceRETURN_vWideEventGroupSetBits()
+#endif
+
+#ifndef traceENTER_vWideEventGroupClearBits
+    #define traceENTER_vWideEventGroupClearBits( xEventGroup, puxBitsToClear )
+#endif
+
+#ifndef traceRETURN_vWideEventGroupClearBits
+    #define traceRETURN_vWideEventGroupClearBits()
+#endif
+
+#ifndef traceENTER_vWideEventGroupGetBits
+    #define traceENTER_vWideEventGroupGetBits( xEventGroup, puxEventBits )
+#endif
+
+#ifndef traceRETURN_vWideEventGroupGetBits
+    #define traceRETURN_vWideEventGroupGetBits()
+#endif
+
+#ifndef traceENTER_uxWideEventGroupGetNumberOfWords
+    #define traceENTER_uxWideEventGroupGetNumberOfWords( xEventGroup )
+#endif
+
+#ifndef traceRETURN_uxWideEventGroupGetNumberOfWords
+    #define traceRETURN_uxWideEventGroupGetNumberOfWords( uxNumberOfWords )
+#endif
+
+#ifndef traceENTER_vWideEventGroupDelete
+    #define traceENTER_vWideEventGroupDelete( xEventGroup )
+#endif
+
+#ifndef traceRETURN_vWideEventGroupDelete
+    #define traceRETURN_vWideEventGroupDelete()
+#endif
+
 #ifndef traceENTER_uxEventGroupGetNumber
     #define traceENTER_uxEventGroupGetNumber( xEventGroup )
 #endif
@@ -1180,6 +1329,14 @@
     #define traceRETURN_xQueueGenericCreateStatic( pxNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueGenericCreateInArena
+    #define traceENTER_xQueueGenericCreateInArena( xArena, uxQueueLength, uxItemSize, ucQueueType )
+#endif
+
+#ifndef traceRETURN_xQueueGenericCreateInArena
+    #define traceRETURN_xQueueGenericCreateInArena( pxNewQueue )
+#endif
+
 #ifndef traceENTER_xQueueGenericGetStaticBuffers
     #define traceENTER_xQueueGenericGetStaticBuffers( xQueue, ppucQueueStorage, ppxStaticQueue )
 #endif
@@ -1212,6 +1369,14 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateMutexInArena
+    #define traceENTER_xQueueCreateMutexInArena( xArena, ucQueueType )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexInArena
+    #define traceRETURN_xQueueCreateMutexInArena( xNewQueue )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1252,6 +1417,14 @@
     #define traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle )
 #endif
 
+#ifndef traceENTER_xQueueCreateCountingSemaphoreInArena
+    #define traceENTER_xQueueCreateCountingSemaphoreInArena( xArena, uxMaxCount, uxInitialCount )
+#endif
+
+#ifndef traceRETURN_xQueueCreateCountingSemaphoreInArena
+    #define traceRETURN_xQueueCreateCountingSemaphoreInArena( xHandle )
+#endif
+
 #ifndef traceENTER_xQueueCreateCountingSemaphore
     #define traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount )
 #endif
@@ -1540,6 +1713,14 @@
     #define traceRETURN_xTimerCreateStatic( pxNewTimer )
 #endif
 
+#ifndef traceENTER_xTimerCreateInArena
+    #define traceENTER_xTimerCreateInArena( xArena, pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction )
+#endif
+
+#ifndef traceRETURN_xTimerCreateInArena
+    #define traceRETURN_xTimerCreateInArena( pxNewTimer )
+#endif
+
 #ifndef traceENTER_xTimerGenericCommandFromTask
     #define traceENTER_xTimerGenericCommandFromTask( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait )
 #endif
@@ -1692,6 +1873,14 @@
     #define traceRETURN_xTaskCreateStaticAffinitySet( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreateInArena
+    #define traceENTER_xTaskCreateInArena( xArena, pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreateInArena
+    #define traceRETURN_xTaskCreateInArena( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateRestrictedStatic
     #define traceENTER_xTaskCreateRestrictedStatic( pxTaskDefinition, pxCreatedTask )
 #endif
@@ -2016,6 +2205,22 @@
     #define traceRETURN_vTaskSetApplicationTaskTag()
 #endif
 
+#ifndef traceENTER_vTaskSetDefaultArena
+    #define traceENTER_vTaskSetDefaultArena( xTask, xArena )
+#endif
+
+#ifndef traceRETURN_vTaskSetDefaultArena
+    #define traceRETURN_vTaskSetDefaultArena()
+#endif
+
+#ifndef traceENTER_xTaskGetDefaultArena
+    #define traceENTER_xTaskGetDefaultArena( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetDefaultArena
+    #define traceRETURN_xTaskGetDefaultArena( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskGetApplicationTaskTag
     #define traceENTER_xTaskGetApplicationTaskTag( xTask )
 #endif
@@ -2088,6 +2293,14 @@
     #define traceRETURN_vTaskRemoveFromUnorderedEventList()
 #endif
 
+#ifndef traceENTER_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue )
+#endif
+
+#ifndef traceRETURN_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskSetTimeOutState
     #define traceENTER_vTaskSetTimeOutState( pxTimeOut )
 #endif
@@ -2104,6 +2317,14 @@
     #define traceRETURN_vTaskInternalSetTimeOutState()
 #endif
 
+#ifndef traceENTER_vTaskInternalSetWideEventWaitItem
+    #define traceENTER_vTaskInternalSetWideEventWaitItem( pxWaitItem )
+#endif
+
+#ifndef traceRETURN_vTaskInternalSetWideEventWaitItem
+    #define traceRETURN_vTaskInternalSetWideEventWaitItem()
+#endif
+
 #ifndef traceENTER_xTaskCheckForTimeOut
     #define traceENTER_xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait )
 #endif
@@ -2424,6 +2645,14 @@
     #define traceRETURN_xStreamBufferGenericCreateStatic( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferGenericCreateInArena
+    #define traceENTER_xStreamBufferGenericCreateInArena( xArena, xBufferSizeBytes, xTriggerLevelBytes, xStreamBufferType, pxSendCompletedCallback, pxReceiveCompletedCallback )
+#endif
+
+#ifndef traceRETURN_xStreamBufferGenericCreateInArena
+    #define traceRETURN_xStreamBufferGenericCreateInArena( xReturn )
+#endif
+
 #ifndef traceENTER_xStreamBufferGetStaticBuffers
     #define traceENTER_xStreamBufferGetStaticBuffers( xStreamBuffer, ppucStreamBufferStorageArea, ppxStaticStreamBuffer )
 #endif
@@ -2464,6 +2693,14 @@
     #define traceRETURN_xStreamBufferSetTriggerLevel( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferSetMaxLatency
+    #define traceENTER_xStreamBufferSetMaxLatency( xStreamBuffer, xMaxLatencyTicks )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetMaxLatency
+    #define traceRETURN_xStreamBufferSetMaxLatency( xReturn )
+#endif
+
 #ifndef traceENTER_xStreamBufferSpacesAvailable
     #define traceENTER_xStreamBufferSpacesAvailable( xStreamBuffer )
 #endif
@@ -2504,6 +2741,14 @@
     #define traceRETURN_xStreamBufferReceive( xReceivedLength )
 #endif
 
+#ifndef traceENTER_xStreamBufferReceiveMessages
+    #define traceENTER_xStreamBufferReceiveMessages( xStreamBuffer, pvRxData, xBufferLengthBytes, pxRecords, xMaxRecords, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveMessages
+    #define traceRETURN_xStreamBufferReceiveMessages( xReceivedMessages )
+#endif
+
 #ifndef traceENTER_xStreamBufferNextMessageLengthBytes
     #define traceENTER_xStreamBufferNextMessageLengthBytes( xStreamBuffer )
 #endif
@@ -2664,6 +2909,198 @@
     #define traceRETURN_xCoRoutineRemoveFromEventList( xReturn )
 #endif
 
+#ifndef traceENTER_xArenaCreate
+    #define traceENTER_xArenaCreate( xArenaSizeBytes )
+#endif
+
+#ifndef traceRETURN_xArenaCreate
+    #define traceRETURN_xArenaCreate( pxArena )
+#endif
+
+#ifndef traceENTER_xArenaCreateStatic
+    #define traceENTER_xArenaCreateStatic( pucArenaBuffer, xArenaBufferSizeBytes )
+#endif
+
+#ifndef traceRETURN_xArenaCreateStatic
+    #define traceRETURN_xArenaCreateStatic( pxArena )
+#endif
+
+#ifndef traceENTER_pvArenaMallocAligned
+    #define traceENTER_pvArenaMallocAligned( xArena, xWantedSize, xAlignment )
+#endif
+
+#ifndef traceRETURN_pvArenaMallocAligned
+    #define traceRETURN_pvArenaMallocAligned( pvReturn )
+#endif
+
+#ifndef traceENTER_xArenaGetFreeSize
+    #define traceENTER_xArenaGetFreeSize( xArena )
+#endif
+
+#ifndef traceRETURN_xArenaGetFreeSize
+    #define traceRETURN_xArenaGetFreeSize( xReturn )
+#endif
+
+#ifndef traceENTER_xArenaGetMinimumEverFreeSize
+    #define traceENTER_xArenaGetMinimumEverFreeSize( xArena )
+#endif
+
+#ifndef traceRETURN_xArenaGetMinimumEverFreeSize
+    #define traceRETURN_xArenaGetMinimumEverFreeSize( xReturn )
+#endif
+
+#ifndef traceENTER_vArenaReset
+    #define traceENTER_vArenaReset( xArena )
+#endif
+
+#ifndef traceRETURN_vArenaReset
+    #define traceRETURN_vArenaReset()
+#endif
+
+#ifndef traceENTER_vArenaDelete
+    #define traceENTER_vArenaDelete( xArena )
+#endif
+
+#ifndef traceRETURN_vArenaDelete
+    #define traceRETURN_vArenaDelete()
+#endif
+
+#ifndef traceENTER_vTaskGetWakeLatency
+    #define traceENTER_vTaskGetWakeLatency( xTask, pxWakeLatency )
+#endif
+
+#ifndef traceRETURN_vTaskGetWakeLatency
+    #define traceRETURN_vTaskGetWakeLatency()
+#endif
+
+#ifndef traceENTER_vTaskResetWakeLatency
+    #define traceENTER_vTaskResetWakeLatency( xTask )
+#endif
+
+#ifndef traceRETURN_vTaskResetWakeLatency
+    #define traceRETURN_vTaskResetWakeLatency()
+#endif
+
+#ifndef traceENTER_ulTaskGetWakeLatencyPercentile
+    #define traceENTER_ulTaskGetWakeLatencyPercentile( pxWakeLatency, uxPercentile )
+#endif
+
+#ifndef traceRETURN_ulTaskGetWakeLatencyPercentile
+    #define traceRETURN_ulTaskGetWakeLatencyPercentile( ulReturn )
+#endif
+
+#ifndef traceENTER_vTaskSnapshotBegin
+    #define traceENTER_vTaskSnapshotBegin( pxSnapshot )
+#endif
+
+#ifndef traceRETURN_vTaskSnapshotBegin
+    #define traceRETURN_vTaskSnapshotBegin()
+#endif
+
+#ifndef traceENTER_uxTaskSnapshotNext
+    #define traceENTER_uxTaskSnapshotNext( pxSnapshot, pxRecords, uxMaxRecords )
+#endif
+
+#ifndef traceRETURN_uxTaskSnapshotNext
+    #define traceRETURN_uxTaskSnapshotNext( uxReturn )
+#endif
+
+#ifndef traceENTER_vTaskGetInversionStats
+    #define traceENTER_vTaskGetInversionStats( xTask, pxStats )
+#endif
+
+#ifndef traceRETURN_vTaskGetInversionStats
+    #define traceRETURN_vTaskGetInversionStats()
+#endif
+
+#ifndef traceENTER_vTaskResetInversionStats
+    #define traceENTER_vTaskResetInversionStats( xTask )
+#endif
+
+#ifndef traceRETURN_vTaskResetInversionStats
+    #define traceRETURN_vTaskResetInversionStats()
+#endif
+
+#ifndef traceENTER_vTaskListInversionChains
+    #define traceENTER_vTaskListInversionChains( pcWriteBuffer, uxBufferLength )
+#endif
+
+#ifndef traceRETURN_vTaskListInversionChains
+    #define traceRETURN_vTaskListInversionChains()
+#endif
+
+#ifndef traceENTER_uxTaskSetISRWakeSourceFromISR
+    #define traceENTER_uxTaskSetISRWakeSourceFromISR( uxSourceID )
+#endif
+
+#ifndef traceRETURN_uxTaskSetISRWakeSourceFromISR
+    #define traceRETURN_uxTaskSetISRWakeSourceFromISR( uxReturn )
+#endif
+
+#ifndef traceENTER_vTaskRestoreISRWakeSourceFromISR
+    #define traceENTER_vTaskRestoreISRWakeSourceFromISR( uxSavedSource )
+#endif
+
+#ifndef traceRETURN_vTaskRestoreISRWakeSourceFromISR
+    #define traceRETURN_vTaskRestoreISRWakeSourceFromISR()
+#endif
+
+#ifndef traceENTER_vTaskGetISRWakeLatency
+    #define traceENTER_vTaskGetISRWakeLatency( uxSourceID, pxWakeLatency )
+#endif
+
+#ifndef traceRETURN_vTaskGetISRWakeLatency
+    #define traceRETURN_vTaskGetISRWakeLatency()
+#endif
+
+#ifndef traceENTER_vTaskResetISRWakeLatency
+    #define traceENTER_vTaskResetISRWakeLatency( uxSourceID )
+#endif
+
+#ifndef traceRETURN_vTaskResetISRWakeLatency
+    #define traceRETURN_vTaskResetISRWakeLatency()
+#endif
+
+#ifndef traceENTER_vQueueGetStats
+    #define traceENTER_vQueueGetStats( xQueue, pxStats )
+#endif
+
+#ifndef traceRETURN_vQueueGetStats
+    #define traceRETURN_vQueueGetStats()
+#endif
+
+#ifndef traceENTER_vQueueResetStats
+    #define traceENTER_vQueueResetStats( xQueue )
+#endif
+
+#ifndef traceRETURN_vQueueResetStats
+    #define traceRETURN_vQueueResetStats()
+#endif
+
+#ifndef traceENTER_uxQueueGetRegistryStats
+    #define traceENTER_uxQueueGetRegistryStats( pxStatsArray, uxArraySize )
+#endif
+
+#ifndef traceRETURN_uxQueueGetRegistryStats
+    #define traceRETURN_uxQueueGetRegistryStats( uxReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferGetStats
+    #define traceENTER_vStreamBufferGetStats( xStreamBuffer, pxStats )
+#endif
+
+#ifndef traceRETURN_vStreamBufferGetStats
+    #define traceRETURN_vStreamBufferGetStats()
+#endif
+
+#ifndef traceENTER_vStreamBufferResetStats
+    #define traceENTER_vStreamBufferResetStats( xStreamBuffer )
+#endif
+
+#ifndef traceRETURN_vStreamBufferResetStats
+    #define traceRETURN_vStreamBufferResetStats()
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -2682,6 +3119,34 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_TASK_WAKE_LATENCY requires configGENERATE_RUN_TIME_STATS to be 1, as latencies are measured with the run time stats clock.
+#endif
+
+#if ( ( configUSE_ISR_WAKE_LATENCY == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_ISR_WAKE_LATENCY requires configGENERATE_RUN_TIME_STATS to be 1, as latencies are measured with the run time stats clock.
+#endif
+
+#if ( ( configUSE_ISR_WAKE_LATENCY == 1 ) && ( configISR_WAKE_LATENCY_SOURCES < 1 ) )
+    #error configISR_WAKE_LATENCY_SOURCES must be at least 1.
+#endif
+
+#if ( ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) ) && ( ( configTASK_WAKE_LATENCY_BUCKETS < 2 ) || ( configTASK_WAKE_LATENCY_BUCKETS > 64 ) ) )
+    #error configTASK_WAKE_LATENCY_BUCKETS must be between 2 and 64.
+#endif
+
+#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_TASK_SNAPSHOT requires configUSE_TRACE_FACILITY to be 1.
+#endif
+
+#if ( ( configUSE_PRIORITY_INVERSION_STATS == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( configGENERATE_RUN_TIME_STATS != 1 ) ) )
+    #error configUSE_PRIORITY_INVERSION_STATS requires configUSE_MUTEXES and configGENERATE_RUN_TIME_STATS to be 1, as times are measured with the run time stats clock.
+#endif
+
+#if ( ( configUSE_PRIORITY_INVERSION_STATS == 1 ) && ( configPRIORITY_INVERSION_CHAIN_DEPTH < 1 ) )
+    #error configPRIORITY_INVERSION_CHAIN_DEPTH must be at least 1.
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -2794,6 +3259,28 @@
     #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
 #endif
 
+#ifndef configWIDE_EVENT_GROUP_NOTIFICATION_INDEX
+    #define configWIDE_EVENT_GROUP_NOTIFICATION_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use wide event groups
+    #endif
+
+    #if ( configTASK_NOTIFICATION_ARRAY_ENTRIES < 2 )
+        #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 2 to use wide event groups, so the notification they use is not shared with index 0
+    #endif
+
+    #if ( configWIDE_EVENT_GROUP_NOTIFICATION_INDEX == 0 )
+        #error configWIDE_EVENT_GROUP_NOTIFICATION_INDEX must not be 0, as index 0 is used by xTaskNotifyGive(), ulTaskNotifyTake() and stream buffers
+    #endif
+
+    #if ( configWIDE_EVENT_GROUP_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configWIDE_EVENT_GROUP_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
     #define configUSE_POSIX_ERRNO    0
 #endif
@@ -2804,6 +3291,13 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+#ifndef configUSE_SB_MAX_LATENCY
+
+/* By default stream batching buffers only unblock a reader when the trigger
+ * level is exceeded. */
+    #define configUSE_SB_MAX_LATENCY    0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -2822,6 +3316,10 @@
     #define configSUPPORT_DYNAMIC_ALLOCATION    1
 #endif
 
+#ifndef configUSE_ARENAS
+    #define configUSE_ARENAS    0
+#endif
+
 #if ( ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
     #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
 #endif
@@ -2864,6 +3362,10 @@
     #error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if ( ( configUSE_ARENAS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION != 1 ) )
+    #error configSUPPORT_STATIC_ALLOCATION must be set to 1 to use arenas
+#endif
+
 #if ( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -3201,6 +3703,38 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_ARENAS == 1 )
+        void * pvDummy23;
+    #endif
+    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        configSTACK_DEPTH_TYPE uxDummy27;
+        uint8_t ucDummy28;
+    #endif
+    #if ( configUSE_LAZY_STACK_FILL == 1 )
+        configSTACK_DEPTH_TYPE uxDummy29[ 2 ];
+    #endif
+    #if ( configUSE_TASK_WAKE_LATENCY == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy30[ 3 ];
+        uint32_t ulDummy31[ configTASK_WAKE_LATENCY_BUCKETS + 1 ];
+        uint8_t ucDummy32;
+    #endif
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        uint32_t ulDummy33;
+    #endif
+    #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy34[ 5 ];
+        void * pxDummy35[ 1 + ( 2 * configPRIORITY_INVERSION_CHAIN_DEPTH ) ];
+        UBaseType_t uxDummy36[ 3 ];
+        uint32_t ulDummy37[ 2 ];
+        uint8_t ucDummy38;
+    #endif
+    #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy39;
+        UBaseType_t uxDummy40;
+    #endif
+    #if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+        void * pvDummy41;
+    #endif
 } StaticTask_t;
 
 /*
@@ -3243,6 +3777,16 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        struct
+        {
+            uint32_t ulDummy10[ 5 ];
+            UBaseType_t uxDummy11;
+            TickType_t xDummy12[ 6 ];
+        } xDummy13;
+        TickType_t xDummy14;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -3272,8 +3816,34 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        UBaseType_t uxDummy5;
+        TickType_t xDummy6;
+    #endif
+
+    #if ( configEVENT_GROUP_WAITER_LISTS > 0 )
+        StaticList_t xDummy7[ configEVENT_GROUP_WAITER_LISTS ];
+        TickType_t xDummy8;
+    #endif
 } StaticEventGroup_t;
 
+/*
+ * The StaticWideEventGroup_t structure is provided for the same purpose as
+ * StaticEventGroup_t, but for wide event groups.  The event bits themselves are
+ * held in a separate array provided to xWideEventGroupCreateStatic().
+ */
+typedef struct xSTATIC_WIDE_EVENT_GROUP
+{
+    StaticList_t xDummy1;
+    UBaseType_t uxDummy2;
+    void * pvDummy3;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy4;
+    #endif
+} StaticWideEventGroup_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3327,6 +3897,17 @@ typedef struct xSTATIC_STREAM_BUFFER
         void * pvDummy5[ 2 ];
     #endif
     UBaseType_t uxDummy6;
+    #if ( configUSE_SB_MAX_LATENCY == 1 )
+        TickType_t xDummy7[ 2 ];
+    #endif
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        struct
+        {
+            uint32_t ulDummy8[ 4 ];
+            size_t uxDummy9;
+            TickType_t xDummy10[ 4 ];
+        } xDummy11;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
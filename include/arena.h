@@ -0,0 +1,244 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An arena is a block of memory from which kernel objects, and any other data
+ * used by a group of tasks, are allocated by incrementing a pointer.  Memory
+ * allocated from an arena is never freed individually - instead the whole
+ * arena is released by a single call to vArenaDelete() or vArenaReset(), so
+ * tearing down a group of short lived tasks along with the queues, semaphores,
+ * stream buffers, event groups and timers they use does not fragment the heap.
+ *
+ * Objects are created in an arena either explicitly, by the *CreateInArena()
+ * functions such as xTaskCreateInArena() and xQueueCreateInArena(), or
+ * implicitly, by calling the normal dynamic create functions such as
+ * xTaskCreate() and xQueueCreate() from a task that has a default arena.  See
+ * vTaskSetDefaultArena().  A task created in an arena has that arena as its
+ * default arena, so the objects it creates come from the same arena.
+ *
+ * Objects created in an arena are treated by the kernel as statically
+ * allocated objects, so must still be deleted using the normal delete
+ * functions before the arena is deleted or reset, but deleting them does not
+ * return any memory to the heap.
+ *
+ * The configUSE_ARENAS configuration constant must be set to 1, and
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1, for the arena API to be
+ * available.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include arena.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#if ( configUSE_ARENAS == 1 )
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+/* *INDENT-ON* */
+
+/**
+ * arena.h
+ * @code{c}
+ * ArenaHandle_t xArenaCreate( size_t xArenaSizeBytes );
+ * @endcode
+ *
+ * Creates a new arena that can hold xArenaSizeBytes bytes of allocations,
+ * including any padding needed to align them.  The arena and its control
+ * structure are allocated from the FreeRTOS heap in a single call to
+ * pvPortMalloc(), so vArenaDelete() returns the whole arena to the heap with a
+ * single call to vPortFree().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xArenaCreate() to be available.
+ *
+ * @param xArenaSizeBytes The number of bytes that can be allocated from the
+ * arena.
+ *
+ * @return If the arena was created then a handle to the arena is returned.
+ * If there was insufficient heap memory available to create the arena then NULL
+ * is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * void vJobTask( void * pvParameters )
+ * {
+ * ArenaHandle_t xArena;
+ *
+ *  // Create an arena large enough for the workers and their queues.
+ *  xArena = xArenaCreate( 4096 );
+ *
+ *  if( xArena != NULL )
+ *  {
+ *      // Objects created by this task now come from the arena, as do the
+ *      // objects created by the tasks it creates.
+ *      vTaskSetDefaultArena( NULL, xArena );
+ *
+ *      xQueue = xQueueCreate( 10, sizeof( uint32_t ) );
+ *      xTaskCreate( vWorkerTask, "Worker", 256, xQueue, 1, &xWorker );
+ *
+ *      // ... Run the job, then delete the workers and their queue ...
+ *
+ *      vTaskDelete( xWorker );
+ *      vQueueDelete( xQueue );
+ *
+ *      // Return everything the job allocated to the heap at once.
+ *      vTaskSetDefaultArena( NULL, NULL );
+ *      vArenaDelete( xArena );
+ *  }
+ * }
+ * @endcode
+ */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        ArenaHandle_t xArenaCreate( size_t xArenaSizeBytes ) PRIVILEGED_FUNCTION;
+    #endif
+
+/**
+ * arena.h
+ * @code{c}
+ * ArenaHandle_t xArenaCreateStatic( uint8_t * pucArenaBuffer,
+ *                                   size_t xArenaBufferSizeBytes );
+ * @endcode
+ *
+ * Creates a new arena in a buffer provided by the application writer.  The
+ * arena's control structure is placed at the start of the buffer, so fewer
+ * than xArenaBufferSizeBytes bytes can be allocated from the arena.
+ *
+ * @param pucArenaBuffer The buffer from which the arena is allocated.
+ *
+ * @param xArenaBufferSizeBytes The size, in bytes, of pucArenaBuffer.
+ *
+ * @return If the arena was created then a handle to the arena is returned.  If
+ * the buffer is too small to hold the arena's control structure then NULL is
+ * returned.
+ */
+    ArenaHandle_t xArenaCreateStatic( uint8_t * pucArenaBuffer,
+                                      size_t xArenaBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * @code{c}
+ * void * pvArenaMallocAligned( ArenaHandle_t xArena,
+ *                              size_t xWantedSize,
+ *                              size_t xAlignment );
+ * @endcode
+ *
+ * Allocates xWantedSize bytes from the arena xArena, aligned to xAlignment
+ * bytes.  xAlignment must be zero or a power of two - values smaller than
+ * portBYTE_ALIGNMENT are rounded up to portBYTE_ALIGNMENT.  Allocation takes
+ * constant time.  Must not be called from an interrupt.
+ *
+ * @return A pointer to the allocated memory, or NULL if xWantedSize is zero or
+ * there is not enough free space in the arena.
+ */
+    void * pvArenaMallocAligned( ArenaHandle_t xArena,
+                                 size_t xWantedSize,
+                                 size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * @code{c}
+ * void * pvArenaMalloc( ArenaHandle_t xArena, size_t xWantedSize );
+ * @endcode
+ *
+ * Allocates xWantedSize bytes from the arena xArena, aligned to
+ * portBYTE_ALIGNMENT bytes.  See pvArenaMallocAligned().
+ */
+    #define pvArenaMalloc( xArena, xWantedSize )    pvArenaMallocAligned( ( xArena ), ( xWantedSize ), 0U )
+
+/**
+ * arena.h
+ * @code{c}
+ * size_t xArenaGetFreeSize( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * @return The number of bytes that have not yet been allocated from the arena.
+ * Padding may make the largest allocation that can succeed slightly smaller.
+ */
+    size_t xArenaGetFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * @code{c}
+ * size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * @return The smallest number of free bytes the arena has had since it was
+ * created, which can be used to size the arena.
+ */
+    size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * @code{c}
+ * void vArenaReset( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Releases everything allocated from the arena, in constant time, so the arena
+ * can be used again.  Every kernel object created in the arena must have been
+ * deleted first.  See vArenaDelete().
+ */
+    void vArenaReset( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * @code{c}
+ * void vArenaDelete( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Deletes an arena, releasing everything allocated from it in constant time.
+ * An arena created by xArenaCreate() is returned to the heap with a single
+ * call to vPortFree().  The memory of an arena created by xArenaCreateStatic()
+ * can be reused by the application once this function returns.
+ *
+ * The kernel does not track the objects created in an arena, so every task,
+ * queue, semaphore, stream buffer, message buffer, event group and timer
+ * created in the arena must be deleted before the arena is deleted, and no
+ * task may still use the arena as its default arena.  Note that a task that
+ * deletes itself is only removed from the kernel's lists once the idle task
+ * has run, and a timer is only deleted once the timer service task has
+ * processed the delete command.
+ */
+    void vArenaDelete( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        }
+    #endif
+/* *INDENT-ON* */
+
+#endif /* configUSE_ARENAS */
+
+#endif /* ARENA_H */
@@ -0,0 +1,178 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The critical section profiler measures how long the kernel and the
+ * application keep interrupts masked in task level critical sections, and keep
+ * the scheduler suspended, as both delay the response to interrupts and to
+ * tasks becoming ready.  Only the outermost critical section or scheduler
+ * suspension is timed, from the moment it is entered until the moment it is
+ * left.
+ *
+ * For each core and each kind of region the profiler keeps the number of
+ * regions timed, the longest hold time, a histogram of hold times with power of
+ * 2 sized buckets, and the return addresses of the code that entered the
+ * configCRITICAL_PROFILER_WORST_CALLERS regions with the longest hold times.
+ * The addresses can be turned into function names with addr2line or the
+ * linker map file.
+ *
+ * Scheduler suspension is always profiled.  Critical sections are profiled on
+ * SMP builds, on ports that keep the critical nesting count in the TCB, and on
+ * the POSIX port.  Other ports can be profiled by calling
+ * vCriticalProfilerEnter() and vCriticalProfilerExit() from their
+ * vPortEnterCritical() and vPortExitCritical() implementations.  The POSIX
+ * port switches threads inside a critical section, so on that port
+ * vPortYield() is reported as holding a critical section for the time taken to
+ * switch tasks.
+ *
+ * Hold times are measured with configCRITICAL_PROFILER_GET_TIME(), which
+ * defaults to portGET_HIGH_RESOLUTION_TIME() if the port provides it (the
+ * POSIX port provides it in nanoseconds), otherwise to
+ * portGET_RUN_TIME_COUNTER_VALUE().  Only the low 32 bits are used, so a
+ * region held for longer than 2^32 counts is reported incorrectly.
+ *
+ * The configUSE_CRITICAL_PROFILER configuration constant must be set to 1, and
+ * critical_profiler.c added to the build, for the profiler to be available.
+ */
+
+#ifndef CRITICAL_PROFILER_H
+#define CRITICAL_PROFILER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include critical_profiler.h"
+#endif
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+    #ifndef configCRITICAL_PROFILER_GET_TIME
+        #if defined( portGET_HIGH_RESOLUTION_TIME )
+            #define configCRITICAL_PROFILER_GET_TIME()    portGET_HIGH_RESOLUTION_TIME()
+        #elif defined( portGET_RUN_TIME_COUNTER_VALUE )
+            #define configCRITICAL_PROFILER_GET_TIME()    portGET_RUN_TIME_COUNTER_VALUE()
+        #else
+            #error configUSE_CRITICAL_PROFILER is 1 but neither configCRITICAL_PROFILER_GET_TIME(), portGET_HIGH_RESOLUTION_TIME() nor portGET_RUN_TIME_COUNTER_VALUE() is defined.
+        #endif
+    #endif
+
+/* Evaluates to the return address of the function in which it is used, which
+ * identifies the code that entered a region. */
+    #ifndef configCRITICAL_PROFILER_GET_CALLER
+        #if defined( __GNUC__ )
+            #define configCRITICAL_PROFILER_GET_CALLER()    __builtin_return_address( 0 )
+        #else
+            #define configCRITICAL_PROFILER_GET_CALLER()    NULL
+        #endif
+    #endif
+
+/* The number of buckets in each hold time histogram. */
+    #ifndef configCRITICAL_PROFILER_BUCKETS
+        #define configCRITICAL_PROFILER_BUCKETS    32
+    #endif
+
+/* The number of worst callers kept for each kind of region on each core. */
+    #ifndef configCRITICAL_PROFILER_WORST_CALLERS
+        #define configCRITICAL_PROFILER_WORST_CALLERS    4
+    #endif
+
+    #if ( ( configCRITICAL_PROFILER_BUCKETS < 2 ) || ( configCRITICAL_PROFILER_BUCKETS > 33 ) )
+        #error configCRITICAL_PROFILER_BUCKETS must be between 2 and 33.
+    #endif
+
+    #if ( configCRITICAL_PROFILER_WORST_CALLERS < 1 )
+        #error configCRITICAL_PROFILER_WORST_CALLERS must be at least 1.
+    #endif
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+/* *INDENT-ON* */
+
+/* The kinds of region that are profiled. */
+    typedef enum
+    {
+        eCriticalSectionRegion = 0, /* Task level critical sections, entered with taskENTER_CRITICAL(). */
+        eSchedulerSuspendedRegion   /* Scheduler suspension, entered with vTaskSuspendAll(). */
+    } eCriticalProfilerRegion;
+
+/* One of the code locations that held a region for longest. */
+    typedef struct xCRITICAL_PROFILER_CALLER
+    {
+        const void * pvCaller; /* The return address of the call that entered the region, or NULL if the entry is unused. */
+        uint32_t ulMaximum;    /* The longest time a region entered from pvCaller was held. */
+    } CriticalProfilerCaller_t;
+
+/* The hold times recorded for one kind of region on one core. */
+    typedef struct xCRITICAL_PROFILER_STATS
+    {
+        uint32_t ulCount;                                                        /* The number of regions timed. */
+        uint32_t ulMaximum;                                                      /* The longest hold time. */
+        uint32_t ulBuckets[ configCRITICAL_PROFILER_BUCKETS ];                   /* ulBuckets[ 0 ] counts hold times of 0, and ulBuckets[ n ] counts hold times from 2^(n-1) to (2^n)-1, except the last bucket, which also counts all longer hold times. */
+        CriticalProfilerCaller_t xWorstCallers[ configCRITICAL_PROFILER_WORST_CALLERS ]; /* The callers with the longest hold times, longest first, each listed once. */
+    } CriticalProfilerStats_t;
+
+/*
+ * Called by the kernel and port when the outermost region of kind eRegion is
+ * entered on the calling core, with pvCaller set to
+ * configCRITICAL_PROFILER_GET_CALLER() evaluated in the function that was
+ * called to enter the region.  Must be called with interrupts masked, or in
+ * the case of scheduler suspension with the scheduler already suspended.
+ */
+    void vCriticalProfilerEnter( eCriticalProfilerRegion eRegion,
+                                 const void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel and port when the outermost region of kind eRegion is
+ * left on the calling core, before interrupts are unmasked.  Does nothing if
+ * there is no matching call to vCriticalProfilerEnter(), which can happen if
+ * a context switch takes place inside a critical section.
+ */
+    void vCriticalProfilerExit( eCriticalProfilerRegion eRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the hold times recorded for regions of kind eRegion on core xCoreID
+ * into *pxStats.
+ */
+    void vCriticalProfilerGetStats( BaseType_t xCoreID,
+                                    eCriticalProfilerRegion eRegion,
+                                    CriticalProfilerStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Discards the hold times recorded for all regions on all cores.
+ */
+    void vCriticalProfilerReset( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        }
+    #endif
+/* *INDENT-ON* */
+
+#endif /* configUSE_CRITICAL_PROFILER */
+
+#endif /* CRITICAL_PROFILER_H */
@@ -229,6 +229,30 @@ typedef TickType_t               EventBits_t;
     EventGroupHandle_t xEventGroupCreateStatic( StaticEventGroup_t * pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * event_groups.h
+ * @code{c}
+ * EventGroupHandle_t xEventGroupCreateInArena( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * A version of xEventGroupCreate() that allocates the event group from the
+ * arena xArena rather than from the FreeRTOS heap - see arena.h.  The event
+ * group must be deleted before the arena is deleted or reset, but deleting the
+ * event group does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for
+ * xEventGroupCreateInArena() to be available.
+ *
+ * @param xArena The arena from which the event group is allocated.
+ *
+ * @return If the event group was created then a handle to the event group is
+ * returned.  If there was insufficient free space in the arena then NULL is
+ * returned.
+ */
+#if ( configUSE_ARENAS == 1 )
+    EventGroupHandle_t xEventGroupCreateInArena( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * event_groups.h
  * @code{c}
@@ -410,6 +434,10 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h then
+ * the bits are cleared directly from within the interrupt instead, the timer
+ * task is not used, and the function always returns pdPASS.
+ *
  * @note If this function returns pdPASS then the timer task is ready to run
  * and a portYIELD_FROM_ISR(pdTRUE) should be executed to perform the needed
  * clear on the event group.  This behavior is different from
@@ -452,7 +480,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) )
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
@@ -554,6 +582,17 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h then
+ * the timer task is not used.  Instead the bits are set, and the tasks waiting
+ * for them are unblocked, directly from within the interrupt, so a task waiting
+ * for the bits runs after a single context switch.  The time spent in the
+ * interrupt grows with the number of tasks blocked on the event group.  If a
+ * task is accessing the event group when the interrupt executes then the bits
+ * are still set immediately, but the waiting tasks are unblocked by that task
+ * when it finishes accessing the event group.  In this mode the function always
+ * returns pdPASS, and *pxHigherPriorityTaskWoken is set to pdTRUE if a task
+ * that has a priority above the interrupted task was unblocked.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -610,7 +649,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -835,6 +874,233 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
                                            StaticEventGroup_t ** ppxEventGroupBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/*-----------------------------------------------------------
+* WIDE EVENT GROUP API
+*----------------------------------------------------------*/
+
+/*
+ * A wide event group is an event group that holds an application defined
+ * number of event bits, rather than the 8, 24 or 56 bits that fit in an
+ * EventBits_t.  The bits are stored in an array of WideEventBits_t words, bit N
+ * being bit ( N % eventWIDE_BITS_PER_WORD ) of word
+ * ( N / eventWIDE_BITS_PER_WORD ).  Masks passed to and returned from the wide
+ * event group API functions are arrays of the same number of words as the event
+ * group itself.
+ *
+ * Tasks blocked on a wide event group store the bits they are waiting for in
+ * their own stack frame rather than in an event list item, and are unblocked
+ * using the direct to task notification at index
+ * configWIDE_EVENT_GROUP_NOTIFICATION_INDEX, so that index must not be used for
+ * anything else by tasks that wait on a wide event group.  The index defaults to
+ * the last one, configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, and cannot be 0, the
+ * index used by xTaskNotifyGive(), ulTaskNotifyTake() and stream buffers.  Wide
+ * event groups cannot be accessed from interrupts.
+ *
+ * The configUSE_WIDE_EVENT_GROUPS configuration constant must be set to 1 for
+ * the wide event group API functions to be available.
+ */
+#if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+
+/**
+ * event_groups.h
+ *
+ * Type by which wide event groups are referenced.
+ *
+ * \defgroup WideEventGroupHandle_t WideEventGroupHandle_t
+ * \ingroup EventGroup
+ */
+    struct WideEventGroupDef_t;
+    typedef struct WideEventGroupDef_t * WideEventGroupHandle_t;
+
+/*
+ * The type of each word of a wide event group.
+ */
+    typedef UBaseType_t                  WideEventBits_t;
+
+    #define eventWIDE_BITS_PER_WORD    ( ( UBaseType_t ) ( sizeof( WideEventBits_t ) * 8U ) )
+
+/*
+ * The number of WideEventBits_t words needed to hold uxNumberOfBits bits.  Use
+ * to dimension masks, and the storage passed to xWideEventGroupCreateStatic().
+ */
+    #define eventWIDE_WORDS_FOR_BITS( uxNumberOfBits ) \
+    ( ( ( UBaseType_t ) ( uxNumberOfBits ) + eventWIDE_BITS_PER_WORD - ( UBaseType_t ) 1U ) / eventWIDE_BITS_PER_WORD )
+
+/**
+ * event_groups.h
+ * @code{c}
+ * WideEventGroupHandle_t xWideEventGroupCreate( UBaseType_t uxNumberOfBits );
+ * @endcode
+ *
+ * Create a wide event group that holds at least uxNumberOfBits event bits.  The
+ * number of bits is rounded up to a whole number of WideEventBits_t words.  The
+ * event group structure and its bits are allocated in a single block.
+ *
+ * @param uxNumberOfBits The number of event bits the event group must hold.
+ *
+ * @return A handle to the created event group, or NULL if there was
+ * insufficient FreeRTOS heap available.
+ *
+ * \defgroup xWideEventGroupCreate xWideEventGroupCreate
+ * \ingroup EventGroup
+ */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        WideEventGroupHandle_t xWideEventGroupCreate( UBaseType_t uxNumberOfBits ) PRIVILEGED_FUNCTION;
+    #endif
+
+/**
+ * event_groups.h
+ * @code{c}
+ * WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxNumberOfBits,
+ *                                                     WideEventBits_t * puxEventBitsBuffer,
+ *                                                     StaticWideEventGroup_t * pxEventGroupBuffer );
+ * @endcode
+ *
+ * Create a wide event group without using any dynamic memory allocation.
+ *
+ * @param uxNumberOfBits The number of event bits the event group must hold.
+ *
+ * @param puxEventBitsBuffer An array of at least
+ * eventWIDE_WORDS_FOR_BITS( uxNumberOfBits ) words that will hold the event
+ * bits.
+ *
+ * @param pxEventGroupBuffer A StaticWideEventGroup_t variable that will hold
+ * the event group's data structure.
+ *
+ * @return A handle to the created event group, or NULL if either buffer is
+ * NULL.
+ *
+ * \defgroup xWideEventGroupCreateStatic xWideEventGroupCreateStatic
+ * \ingroup EventGroup
+ */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxNumberOfBits,
+                                                            WideEventBits_t * puxEventBitsBuffer,
+                                                            StaticWideEventGroup_t * pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+    #endif
+
+/**
+ * event_groups.h
+ * @code{c}
+ * BaseType_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup,
+ *                                     const WideEventBits_t * puxBitsToWaitFor,
+ *                                     WideEventBits_t * puxEventBits,
+ *                                     const BaseType_t xClearOnExit,
+ *                                     const BaseType_t xWaitForAllBits,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * The wide event group equivalent of xEventGroupWaitBits().  Blocks until one
+ * (xWaitForAllBits set to pdFALSE) or all (xWaitForAllBits set to pdTRUE) of
+ * the bits in puxBitsToWaitFor are set, or until xTicksToWait ticks pass.
+ *
+ * @param xEventGroup The event group in which the bits are being tested.
+ *
+ * @param puxBitsToWaitFor The mask of bits to wait for.  At least one bit must
+ * be set.  The array must remain valid until the function returns.
+ *
+ * @param puxEventBits If not NULL, used to return the value of the event bits
+ * at the time either the wait condition was met (before any bits were cleared
+ * on exit) or the block time expired.
+ *
+ * @param xClearOnExit If pdTRUE the bits in puxBitsToWaitFor are cleared when
+ * the wait condition is met.
+ *
+ * @param xWaitForAllBits See above.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the wait condition to be met.
+ *
+ * @return pdTRUE if the wait condition was met, otherwise pdFALSE.
+ *
+ * \defgroup xWideEventGroupWaitBits xWideEventGroupWaitBits
+ * \ingroup EventGroup
+ */
+    BaseType_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup,
+                                        const WideEventBits_t * puxBitsToWaitFor,
+                                        WideEventBits_t * puxEventBits,
+                                        const BaseType_t xClearOnExit,
+                                        const BaseType_t xWaitForAllBits,
+                                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ * void vWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup,
+ *                              const WideEventBits_t * puxBitsToSet );
+ * @endcode
+ *
+ * Set the bits in puxBitsToSet, then unblock the tasks whose wait condition is
+ * met.  All the bits waited for by unblocked tasks that specified xClearOnExit
+ * are cleared after every waiting task has been evaluated.
+ *
+ * @param xEventGroup The event group in which the bits are to be set.
+ *
+ * @param puxBitsToSet The mask of bits to set.
+ *
+ * \defgroup vWideEventGroupSetBits vWideEventGroupSetBits
+ * \ingroup EventGroup
+ */
+    void vWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup,
+                                 const WideEventBits_t * puxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ * void vWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup,
+ *                                const WideEventBits_t * puxBitsToClear );
+ * @endcode
+ *
+ * Clear the bits in puxBitsToClear.
+ *
+ * \defgroup vWideEventGroupClearBits vWideEventGroupClearBits
+ * \ingroup EventGroup
+ */
+    void vWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup,
+                                   const WideEventBits_t * puxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ * void vWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup,
+ *                              WideEventBits_t * puxEventBits );
+ * @endcode
+ *
+ * Copy the current value of the event bits into puxEventBits.
+ *
+ * \defgroup vWideEventGroupGetBits vWideEventGroupGetBits
+ * \ingroup EventGroup
+ */
+    void vWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup,
+                                 WideEventBits_t * puxEventBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ * UBaseType_t uxWideEventGroupGetNumberOfWords( WideEventGroupHandle_t xEventGroup );
+ * @endcode
+ *
+ * @return The number of WideEventBits_t words in the event group, and therefore
+ * in every mask passed to or returned from it.
+ */
+    UBaseType_t uxWideEventGroupGetNumberOfWords( WideEventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ * void vWideEventGroupDelete( WideEventGroupHandle_t xEventGroup );
+ * @endcode
+ *
+ * Delete a wide event group.  Tasks that are blocked on the event group are
+ * unblocked, and xWideEventGroupWaitBits() returns pdFALSE in those tasks.
+ *
+ * \defgroup vWideEventGroupDelete vWideEventGroupDelete
+ * \ingroup EventGroup
+ */
+    void vWideEventGroupDelete( WideEventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_WIDE_EVENT_GROUPS */
+
 /* For internal use only. */
 void vEventGroupSetBitsCallback( void * pvEventGroup,
                                  uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
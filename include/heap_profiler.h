@@ -0,0 +1,196 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The heap profiler sits in front of whichever heap implementation is used.
+ * When configUSE_HEAP_PROFILER is 1 portable.h maps pvPortMalloc(),
+ * pvPortCalloc(), pvPortRealloc(), pvPortMallocAligned() and vPortFree() onto
+ * the profiled versions implemented in portable/MemMang/heap_profiler.c, which
+ * record:
+ *
+ * + The bytes and allocations that are live for each call site, identified by
+ *   the return address of the call to pvPortMalloc().
+ * + The bytes that are live for each task, identified by its handle.  A task's
+ *   entry is released when the task is deleted, or once its last allocation is
+ *   freed if it is deleted while some of its allocations are still live.
+ * + A histogram of requested allocation sizes.
+ * + A histogram of the time taken by the underlying pvPortMalloc().
+ *
+ * Each allocation is prefixed by a small header that records its call site and
+ * task, so freeing a block costs no more than allocating one.  The tables have
+ * a fixed size, and each lookup probes a bounded number of entries.  Call sites
+ * and tasks that do not fit in the tables are counted in entry 0 of the table
+ * instead, which has a NULL key.
+ *
+ * The profiled pvPortRealloc() always moves the block, and the profiled
+ * pvPortMallocAligned() aligns memory obtained from pvPortMalloc(), so both
+ * work with heap implementations that do not provide them.
+ *
+ * Files that implement pvPortMalloc() and vPortFree() must define
+ * HEAP_IMPLEMENTATION_FILE before including FreeRTOS.h so their definitions
+ * are not renamed.  heap_1.c to heap_6.c already do so.
+ */
+
+#ifndef HEAP_PROFILER_H
+#define HEAP_PROFILER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include heap_profiler.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#if ( configUSE_HEAP_PROFILER == 1 )
+
+/* The number of entries in the call site table, including the overflow entry. */
+    #ifndef configHEAP_PROFILER_MAX_CALL_SITES
+        #define configHEAP_PROFILER_MAX_CALL_SITES    32
+    #endif
+
+/* The number of entries in the task table, including the overflow entry. */
+    #ifndef configHEAP_PROFILER_MAX_TASKS
+        #define configHEAP_PROFILER_MAX_TASKS    16
+    #endif
+
+/* Both histograms have log2 buckets - bucket n counts values in the range
+ * [ 2^n, 2^(n+1) ), except that bucket 0 also counts 0 and the last bucket also
+ * counts everything larger. */
+    #define heapPROFILER_HISTOGRAM_BUCKETS    16U
+
+/* The size of the fixed part of the output of xPortHeapProfilerDump(). */
+    #define heapPROFILER_DUMP_HEADER_SIZE     60U
+
+/* The largest number of bytes xPortHeapProfilerDump() can write. */
+    #define heapPROFILER_DUMP_MAX_SIZE                                                                    \
+    ( ( size_t ) heapPROFILER_DUMP_HEADER_SIZE +                                                      \
+      ( ( size_t ) heapPROFILER_HISTOGRAM_BUCKETS * 8U ) +                                            \
+      ( ( size_t ) configHEAP_PROFILER_MAX_CALL_SITES * ( sizeof( void * ) + 12U ) ) +                \
+      ( ( size_t ) configHEAP_PROFILER_MAX_TASKS * ( sizeof( void * ) + configMAX_TASK_NAME_LEN + 12U ) ) )
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+/* *INDENT-ON* */
+
+/* The allocations made from one call site. */
+    typedef struct xHEAP_PROFILER_CALL_SITE
+    {
+        void * pvCallSite;        /* The return address of the call to pvPortMalloc(), or NULL for the overflow entry. */
+        size_t xLiveBytes;        /* The bytes requested by allocations from this call site that have not been freed. */
+        size_t xLiveAllocations;  /* The number of allocations from this call site that have not been freed. */
+        size_t xTotalAllocations; /* The number of successful allocations made from this call site. */
+    } HeapProfilerCallSite_t;
+
+/* The allocations made by one task. */
+    typedef struct xHEAP_PROFILER_TASK
+    {
+        TaskHandle_t xTask;                          /* The task that made the allocations, or NULL for the overflow entry and for tasks that have been deleted. */
+        char pcTaskName[ configMAX_TASK_NAME_LEN ];  /* The name of the task when its first allocation was made. */
+        size_t xLiveBytes;                           /* The bytes requested by the task that have not been freed. */
+        size_t xPeakLiveBytes;                       /* The highest value xLiveBytes has had. */
+        size_t xTotalAllocations;                    /* The number of successful allocations made by the task. */
+    } HeapProfilerTask_t;
+
+/* Used to pass the state of the profiler out of vPortHeapProfilerGetSnapshot(). */
+    typedef struct xHEAP_PROFILER_SNAPSHOT
+    {
+        size_t xLiveBytes;                                              /* The bytes requested by allocations that have not been freed, excluding heap overhead. */
+        size_t xPeakLiveBytes;                                          /* The highest value xLiveBytes has had. */
+        size_t xLiveAllocations;                                        /* The number of allocations that have not been freed. */
+        size_t xTotalAllocations;                                       /* The number of successful calls to pvPortMalloc() and pvPortCalloc(). */
+        size_t xTotalFrees;                                             /* The number of calls to vPortFree() with a non NULL pointer. */
+        size_t xFailedAllocations;                                      /* The number of calls to pvPortMalloc() and pvPortCalloc() that returned NULL. */
+        HeapStats_t xHeapStats;                                         /* Filled by vPortGetHeapStats(), or zeroed if configHEAP_PROFILER_INCLUDE_HEAP_STATS is 0. */
+        UBaseType_t uxFragmentationIndex;                               /* 1000 * ( 1 - ( largest free block / free bytes ) ), so 0 when all the free memory is one block. */
+        uint32_t ulSizeHistogram[ heapPROFILER_HISTOGRAM_BUCKETS ];     /* Requested allocation sizes, in bytes. */
+        uint32_t ulLatencyHistogram[ heapPROFILER_HISTOGRAM_BUCKETS ];  /* Allocation times, in configHEAP_PROFILER_GET_TIME() units. */
+        UBaseType_t uxNumberOfCallSites;                                /* The number of valid entries in xCallSites. */
+        HeapProfilerCallSite_t xCallSites[ configHEAP_PROFILER_MAX_CALL_SITES ];
+        UBaseType_t uxNumberOfTasks;                                    /* The number of valid entries in xTasks. */
+        HeapProfilerTask_t xTasks[ configHEAP_PROFILER_MAX_TASKS ];
+    } HeapProfilerSnapshot_t;
+
+/*
+ * Copies the current state of the profiler into pxSnapshot.  The profiler
+ * tables are copied inside a critical section, so the snapshot is consistent.
+ * Only the call site and task entries that have been used are copied.
+ */
+    void vPortHeapProfilerGetSnapshot( HeapProfilerSnapshot_t * pxSnapshot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes pxSnapshot into pucBuffer in a compact binary format that can be sent
+ * off target for analysis.  Returns the number of bytes written, or 0 if
+ * xBufferLengthBytes is too small - heapPROFILER_DUMP_MAX_SIZE bytes is always
+ * large enough.
+ *
+ * All values are little endian, and sizes and counts are written as 32-bit
+ * values that saturate at 0xffffffff.  The format is:
+ *
+ * Offset  Size  Content
+ * 0       4     The characters 'F', 'R', 'H', 'P'.
+ * 4       1     Format version, currently 1.
+ * 5       1     P, the size of a pointer in bytes.
+ * 6       1     B, the number of histogram buckets.
+ * 7       1     N, configMAX_TASK_NAME_LEN.
+ * 8       2     C, the number of call site records.
+ * 10      2     T, the number of task records.
+ * 12      48    xLiveBytes, xPeakLiveBytes, xLiveAllocations,
+ *               xTotalAllocations, xTotalFrees, xFailedAllocations, then the
+ *               xHeapStats members xAvailableHeapSpaceInBytes,
+ *               xSizeOfLargestFreeBlockInBytes, xSizeOfSmallestFreeBlockInBytes,
+ *               xNumberOfFreeBlocks and xMinimumEverFreeBytesRemaining, then
+ *               uxFragmentationIndex.
+ * 60      4 * B The size histogram.
+ *         4 * B The latency histogram.
+ *         C records of P bytes call site address followed by xLiveBytes,
+ *         xLiveAllocations and xTotalAllocations.
+ *         T records of P bytes task handle, N bytes task name, followed by
+ *         xLiveBytes, xPeakLiveBytes and xTotalAllocations.
+ */
+    size_t xPortHeapProfilerDump( const HeapProfilerSnapshot_t * pxSnapshot,
+                                  uint8_t * pucBuffer,
+                                  size_t xBufferLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * This function resets the internal state of the heap profiler.  It must be
+ * called by the application before restarting the scheduler, along with
+ * vPortHeapResetState(), and only when no profiled allocations are live.
+ */
+    void vPortHeapProfilerResetState( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        }
+    #endif
+/* *INDENT-ON* */
+
+#endif /* configUSE_HEAP_PROFILER */
+
+#endif /* HEAP_PROFILER_H */
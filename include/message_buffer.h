@@ -250,6 +250,29 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateInArena( ArenaHandle_t xArena, size_t xBufferSizeBytes );
+ * @endcode
+ *
+ * A version of xMessageBufferCreate() that allocates the message buffer from
+ * the arena xArena rather than from the FreeRTOS heap - see arena.h.  The
+ * message buffer must be deleted before the arena is deleted or reset, but
+ * deleting the message buffer does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferCreateInArena() to be available.
+ *
+ * \defgroup xMessageBufferCreateInArena xMessageBufferCreateInArena
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define xMessageBufferCreateInArena( xArena, xBufferSizeBytes ) \
+    xStreamBufferGenericCreateInArena( ( xArena ), ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MESSAGE_BUFFER, NULL, NULL )
+#endif
+
 /**
  * message_buffer.h
  *
@@ -587,6 +610,87 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) \
     xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveMultiple( MessageBufferHandle_t xMessageBuffer,
+ *                                       void *pvRxData,
+ *                                       size_t xBufferLengthBytes,
+ *                                       MessageBufferRecord_t *pxRecords,
+ *                                       size_t xMaxRecords,
+ *                                       TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives as many complete messages from a message buffer as fit in the
+ * buffer pointed to by pvRxData, up to a maximum of xMaxRecords messages.  The
+ * messages are copied to pvRxData back to back, in the order they were sent,
+ * and the offset and length of each is written to the corresponding entry of
+ * pxRecords.  Reading several messages with one call removes them from the
+ * message buffer with a single update, and notifies a task blocked waiting for
+ * space in the message buffer once rather than once per message.
+ *
+ * The same restriction on the number of readers applies as for
+ * xMessageBufferReceive().  There is no interrupt safe version of this
+ * function.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xMessageBufferReceiveMultiple() to be available.
+ *
+ * @param xMessageBuffer The handle of the message buffer from which messages
+ * are being received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received messages are
+ * to be copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by the pvRxData
+ * parameter.  Receiving stops at the first message that does not fit in the
+ * remaining space, which is left in the message buffer.
+ *
+ * @param pxRecords An array of at least xMaxRecords entries into which the
+ * offset and length of each received message is written.
+ *
+ * @param xMaxRecords The maximum number of messages to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message, should the message buffer be empty, as
+ * for xMessageBufferReceive().  The task does not wait for more messages once
+ * at least one is available.
+ *
+ * @return The number of messages received, which is the number of entries of
+ * pxRecords that were written.  Zero is returned if no message became available
+ * before the block time expired, or the next message is longer than
+ * xBufferLengthBytes.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer )
+ * {
+ * uint8_t ucRxData[ 256 ];
+ * MessageBufferRecord_t xRecords[ 16 ];
+ * size_t xMessages, x;
+ *
+ *  // Receive up to 16 messages, waiting up to 100ms for the first one.
+ *  xMessages = xMessageBufferReceiveMultiple( xMessageBuffer,
+ *                                             ( void * ) ucRxData,
+ *                                             sizeof( ucRxData ),
+ *                                             xRecords,
+ *                                             16,
+ *                                             pdMS_TO_TICKS( 100 ) );
+ *
+ *  for( x = 0; x < xMessages; x++ )
+ *  {
+ *      // Process the message that is xRecords[ x ].xLength bytes long and
+ *      // starts at &( ucRxData[ xRecords[ x ].xOffset ] ) here....
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMessageBufferReceiveMultiple xMessageBufferReceiveMultiple
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveMultiple( xMessageBuffer, pvRxData, xBufferLengthBytes, pxRecords, xMaxRecords, xTicksToWait ) \
+    xStreamBufferReceiveMessages( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxRecords ), ( xMaxRecords ), ( xTicksToWait ) )
+
 
 /**
  * message_buffer.h
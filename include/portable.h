@@ -94,6 +94,30 @@
 #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP 0
 #endif
 
+#ifndef configUSE_KERNEL_OBJECT_POOLS
+#define configUSE_KERNEL_OBJECT_POOLS 0
+#endif
+
+#ifndef configUSE_HEAP_PROFILER
+#define configUSE_HEAP_PROFILER 0
+#endif
+
+#ifndef configKERNEL_BUFFER_ALIGNMENT
+#define configKERNEL_BUFFER_ALIGNMENT 0
+#endif
+
+#if ((configKERNEL_BUFFER_ALIGNMENT & (configKERNEL_BUFFER_ALIGNMENT - 1)) != 0)
+#error configKERNEL_BUFFER_ALIGNMENT must be a power of two
+#endif
+
+#ifndef configUSE_HEAP_REGION_PLACEMENT
+#define configUSE_HEAP_REGION_PLACEMENT 0
+#endif
+
+#if ((configUSE_HEAP_REGION_PLACEMENT == 1) && (configUSE_HEAP_PROFILER == 1))
+#error configUSE_HEAP_REGION_PLACEMENT cannot be used with configUSE_HEAP_PROFILER
+#endif
+
 #include "mpu_wrappers.h"
 
 /* *INDENT-OFF* */
@@ -129,11 +153,15 @@ StackType_t* pxPortInitialiseStack(StackType_t* pxTopOfStack, TaskFunction_t pxC
 #endif
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
-/* Used by heap_5.c to define the start address and size of each memory region
- * that together comprise the total FreeRTOS heap space. */
+/* Used by heap_5.c and heap_6.c to define the start address and size of each
+ * memory region that together comprise the total FreeRTOS heap space. */
 typedef struct HeapRegion {
     uint8_t* pucStartAddress;
     size_t   xSizeInBytes;
+#if (configUSE_HEAP_REGION_PLACEMENT == 1)
+    UBaseType_t uxTag; /* Used by heap_5.c to choose where memory is placed - 0 for the fastest memory, with larger values
+                          for slower memory. */
+#endif
 } HeapRegion_t;
 
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
@@ -155,8 +183,8 @@ typedef struct xHeapStats {
 } HeapStats_t;
 
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
- * must be called before any calls to pvPortMalloc() - not creating a task,
+ * Used to define multiple heap regions for use by heap_5.c and heap_6.c.  This
+ * function must be called before any calls to pvPortMalloc() - not creating a task,
  * queue, semaphore, mutex, software timer, event group, etc. will result in
  * pvPortMalloc being called.
  *
@@ -183,12 +211,209 @@ void   vPortInitialiseBlocks(void) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize(void) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize(void) PRIVILEGED_FUNCTION;
 
+/*
+ * Change the size of the block pv to xWantedSize bytes, keeping its contents.
+ * The block is resized in place when it is shrinking or when it is followed
+ * in memory by a large enough free block, and is otherwise moved to a newly
+ * allocated block.  As with realloc(), pv can be NULL, a xWantedSize of 0
+ * frees pv, and pv is left unchanged if NULL is returned.  Only heap_4.c and
+ * heap_5.c provide pvPortRealloc().
+ */
+void* pvPortRealloc(void* pv, size_t xWantedSize) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate xWantedSize bytes starting at an address that is a multiple of
+ * xAlignment, which must be a power of two.  The memory is freed with
+ * vPortFree().  pvPortRealloc() does not preserve the alignment if it has to
+ * move the block.  Only heap_4.c and heap_5.c provide pvPortMallocAligned().
+ */
+void* pvPortMallocAligned(size_t xWantedSize, size_t xAlignment) PRIVILEGED_FUNCTION;
+
+#if (configUSE_HEAP_PROFILER == 1)
+
+/*
+ * The profiled versions of the memory management routines, implemented in
+ * heap_profiler.c.  They record each allocation then call the routines above.
+ * Every file other than the heap implementation is mapped onto them, so files
+ * that implement pvPortMalloc() must define HEAP_IMPLEMENTATION_FILE before
+ * including FreeRTOS.h.  See heap_profiler.h.
+ */
+void* pvPortMallocProfiled(size_t xWantedSize) PRIVILEGED_FUNCTION;
+void* pvPortCallocProfiled(size_t xNum, size_t xSize) PRIVILEGED_FUNCTION;
+void  vPortFreeProfiled(void* pv) PRIVILEGED_FUNCTION;
+void* pvPortReallocProfiled(void* pv, size_t xWantedSize) PRIVILEGED_FUNCTION;
+void* pvPortMallocAlignedProfiled(size_t xWantedSize, size_t xAlignment) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel when a task is deleted, before its TCB is freed, to
+ * release the task's entry in the profiler's task table.  task.h, which defines
+ * TaskHandle_t, is not included yet, so the structure it points to is used.
+ */
+struct tskTaskControlBlock;
+void vPortHeapProfilerTaskDeleted(struct tskTaskControlBlock* xTask) PRIVILEGED_FUNCTION;
+
+#ifndef HEAP_IMPLEMENTATION_FILE
+#define pvPortMalloc        pvPortMallocProfiled
+#define pvPortCalloc        pvPortCallocProfiled
+#define vPortFree           vPortFreeProfiled
+#define pvPortRealloc       pvPortReallocProfiled
+#define pvPortMallocAligned pvPortMallocAlignedProfiled
+#endif
+#endif
+
+/* The kernel objects that are a fixed size, so can be allocated from a pool of
+ * free objects rather than from the heap.  Only queues with no storage area
+ * (semaphores and mutexes) use the queue pool. */
+typedef enum {
+    eObjectPoolTask = 0,   /* TCB_t, the same size as StaticTask_t. */
+    eObjectPoolQueue,      /* Queue_t, the same size as StaticQueue_t. */
+    eObjectPoolTimer,      /* Timer_t, the same size as StaticTimer_t. */
+    eObjectPoolEventGroup, /* EventGroup_t, the same size as StaticEventGroup_t. */
+    eObjectPoolCount
+} eObjectPool;
+
+#if (configUSE_HEAP_REGION_PLACEMENT == 1)
+
+/* The types of memory allocated by the kernel, each of which heap_5.c can place
+ * in a different heap region.  The first four match eObjectPool, so a pool can
+ * be converted to its placement with a cast. */
+typedef enum {
+    eHeapPlacementTask = eObjectPoolTask,             /* Task control blocks. */
+    eHeapPlacementQueue = eObjectPoolQueue,           /* Queues, semaphores and mutexes, including queue storage areas. */
+    eHeapPlacementTimer = eObjectPoolTimer,           /* Software timers. */
+    eHeapPlacementEventGroup = eObjectPoolEventGroup, /* Event groups. */
+    eHeapPlacementStack,                              /* Task stacks. */
+    eHeapPlacementStreamBuffer,                       /* Stream and message buffers, including their storage areas. */
+    eHeapPlacementDefault,                            /* Everything else, including calls to pvPortMalloc(). */
+    eHeapPlacementCount
+} eHeapPlacement;
+
+/* Used to pass information about one heap region out of
+ * xPortGetHeapRegionStats(). */
+typedef struct xHeapRegionStats {
+    uint8_t*    pucStartAddress;                /* The start of the region, after alignment. */
+    size_t      xSizeInBytes;                   /* The size of the region, after alignment. */
+    UBaseType_t uxTag;                          /* The tag given to the region in its HeapRegion_t. */
+    size_t      xAvailableBytes;                /* The sum of the free blocks in the region. */
+    size_t      xSizeOfLargestFreeBlockInBytes; /* The largest free block in the region. */
+    size_t      xNumberOfFreeBlocks;            /* The number of free blocks in the region. */
+    size_t      xNumberOfSuccessfulAllocations; /* The number of blocks allocated from the region. */
+    size_t      xNumberOfFallbackAllocations;   /* The number of those blocks that were placed in the region because
+                                                   the regions with the preferred tag had no large enough block. */
+} HeapRegionStats_t;
+
+/*
+ * Allocate xWantedSize bytes for memory of type ePlacement, aligned to
+ * xAlignment bytes if xAlignment is larger than portBYTE_ALIGNMENT.  The
+ * regions with the tag set for ePlacement by vPortSetHeapPlacement() are tried
+ * first, followed by the regions with each slower tag in turn, then the
+ * regions with each faster tag.  pvPortMalloc() uses eHeapPlacementDefault.
+ * The memory is freed with vPortFree().  Only heap_5.c provides the heap
+ * region placement functions.
+ */
+void* pvPortMallocPlaced(eHeapPlacement ePlacement, size_t xWantedSize, size_t xAlignment) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate xWantedSize bytes from a region with the tag uxTag, or return NULL
+ * if none of those regions has a large enough block.
+ */
+void* pvPortMallocFromRegion(size_t xWantedSize, UBaseType_t uxTag) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the tag of the regions that memory of type ePlacement is allocated from
+ * first.  All types start with tag 0, the fastest memory.
+ */
+void vPortSetHeapPlacement(eHeapPlacement ePlacement, UBaseType_t uxTag) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills pxRegionStats with information about the uxRegion'th region passed to
+ * vPortDefineHeapRegions().  Returns pdFAIL if there is no such region,
+ * otherwise pdPASS.
+ */
+BaseType_t xPortGetHeapRegionStats(UBaseType_t uxRegion, HeapRegionStats_t* pxRegionStats);
+#endif /* configUSE_HEAP_REGION_PLACEMENT */
+
+/*
+ * When configKERNEL_BUFFER_ALIGNMENT is larger than portBYTE_ALIGNMENT, the
+ * task stacks and the queue and stream buffer storage areas allocated by the
+ * kernel are aligned to configKERNEL_BUFFER_ALIGNMENT bytes, for example to
+ * keep them in their own cache lines.  portKERNEL_BUFFER_OFFSET() rounds the
+ * size of a structure up so a storage area that follows it in the same
+ * allocation is also aligned.
+ */
+#if (configKERNEL_BUFFER_ALIGNMENT > portBYTE_ALIGNMENT)
+#define portKERNEL_BUFFER_OFFSET(xSize)                                                                                \
+    (((xSize) + ((size_t)configKERNEL_BUFFER_ALIGNMENT - (size_t)1)) & ~((size_t)configKERNEL_BUFFER_ALIGNMENT - (size_t)1))
+#else
+#define portKERNEL_BUFFER_OFFSET(xSize) (xSize)
+#endif
+
+#if (configUSE_HEAP_REGION_PLACEMENT == 1)
+#define pvPortMallocKernelBuffer(ePlacement, xSize)                                                                    \
+    pvPortMallocPlaced((ePlacement), (xSize), (size_t)configKERNEL_BUFFER_ALIGNMENT)
+#elif (configKERNEL_BUFFER_ALIGNMENT > portBYTE_ALIGNMENT)
+#define pvPortMallocKernelBuffer(ePlacement, xSize) pvPortMallocAligned((xSize), (size_t)configKERNEL_BUFFER_ALIGNMENT)
+#else
+#define pvPortMallocKernelBuffer(ePlacement, xSize) pvPortMalloc(xSize)
+#endif
+
 #if (configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1)
 void* pvPortMallocStack(size_t xSize) PRIVILEGED_FUNCTION;
 void  vPortFreeStack(void* pv) PRIVILEGED_FUNCTION;
 #else
-#define pvPortMallocStack pvPortMalloc
-#define vPortFreeStack    vPortFree
+#define pvPortMallocStack(xSize) pvPortMallocKernelBuffer(eHeapPlacementStack, (xSize))
+#define vPortFreeStack           vPortFree
+#endif
+
+#if (configUSE_KERNEL_OBJECT_POOLS == 1)
+
+/* Used to pass information about a pool out of vPortGetObjectPoolStats(). */
+typedef struct xObjectPoolStats {
+    size_t xObjectSizeInBytes;         /* The size of each object in the pool, after rounding for alignment. */
+    size_t xNumberOfObjectsInUse;      /* The number of objects currently allocated from the pool. */
+    size_t xNumberOfFreeObjects;       /* The number of objects in the pool that are not in use. */
+    size_t xMaximumEverObjectsInUse;   /* The most objects that have been in use at once since the system booted. */
+    size_t xNumberOfObjectsFromHeap;   /* The number of objects the pool has obtained from pvPortMalloc(), either
+                                          by xPortObjectPoolReserve() or by growing on demand. */
+    size_t xNumberOfFailedAllocations; /* The number of calls to pvPortMallocObject() that returned NULL. */
+} ObjectPoolStats_t;
+
+/*
+ * Allocate and free fixed size kernel objects.  pvPortMallocObject() pops an
+ * object from the free list of ePool, only falling back to pvPortMalloc() when
+ * the list is empty and configKERNEL_OBJECT_POOL_GROW_ON_DEMAND is 1.
+ * vPortFreeObject() pushes the object back onto the list - pool memory is never
+ * returned to the heap.  xSize must not be larger than the pool's object size.
+ */
+void* pvPortMallocObject(eObjectPool ePool, size_t xSize) PRIVILEGED_FUNCTION;
+void  vPortFreeObject(eObjectPool ePool, void* pv) PRIVILEGED_FUNCTION;
+
+/*
+ * Add xNumberOfObjects objects to the free list of ePool using a single call to
+ * pvPortMalloc(), so later creates and deletes of that type of object do not
+ * use the heap at all.  Returns pdPASS if the memory was allocated, otherwise
+ * pdFAIL.
+ */
+BaseType_t xPortObjectPoolReserve(eObjectPool ePool, size_t xNumberOfObjects) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns an ObjectPoolStats_t structure filled with information about the
+ * current state of the pool ePool.
+ */
+void vPortGetObjectPoolStats(eObjectPool ePool, ObjectPoolStats_t* pxPoolStats);
+
+/*
+ * This function resets the internal state of the object pools.  It must be
+ * called by the application before restarting the scheduler, along with
+ * vPortHeapResetState().
+ */
+void vPortObjectPoolResetState(void) PRIVILEGED_FUNCTION;
+#elif (configUSE_HEAP_REGION_PLACEMENT == 1)
+#define pvPortMallocObject(ePool, xSize) pvPortMallocPlaced((eHeapPlacement)(ePool), (xSize), 0U)
+#define vPortFreeObject(ePool, pv)       vPortFree(pv)
+#else
+#define pvPortMallocObject(ePool, xSize) pvPortMalloc(xSize)
+#define vPortFreeObject(ePool, pv)       vPortFree(pv)
 #endif
 
 /*
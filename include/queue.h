@@ -64,6 +64,41 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Used with vQueueGetStats() to obtain the contention and blocking statistics
+ * of a queue, semaphore or mutex.  Only available when configUSE_QUEUE_STATS
+ * is 1.  Wait times are measured in ticks from the time a call first found the
+ * queue full (or empty) until it completed or timed out.
+ */
+typedef struct xQUEUE_STATS
+{
+    uint32_t ulSends;                    /* The number of items successfully sent, or the number of times the semaphore or mutex was given. */
+    uint32_t ulReceives;                 /* The number of items successfully received, or the number of times the semaphore or mutex was taken. */
+    uint32_t ulSendBlocks;               /* The number of sends that found the queue full and had to wait. */
+    uint32_t ulReceiveBlocks;            /* The number of receives (and peeks) that found the queue empty and had to wait. */
+    uint32_t ulPriorityInheritances;     /* The number of times a task blocking on the mutex raised the priority of the mutex holder. */
+    UBaseType_t uxPeakMessagesWaiting;   /* The largest number of items the queue has held. */
+    TickType_t xSendWaitTicks;           /* The total time senders spent waiting for space. */
+    TickType_t xMaxSendWaitTicks;        /* The longest time a single send waited for space. */
+    TickType_t xReceiveWaitTicks;        /* The total time receivers spent waiting for data. */
+    TickType_t xMaxReceiveWaitTicks;     /* The longest time a single receive waited for data. */
+    TickType_t xMutexHoldTicks;          /* The total time the mutex has been held. */
+    TickType_t xMaxMutexHoldTicks;       /* The longest time the mutex was held before being given back. */
+} QueueStats_t;
+
+/**
+ * Used with uxQueueGetRegistryStats() to obtain the statistics of every queue
+ * in the queue registry in one call.
+ */
+typedef struct xQUEUE_REGISTRY_STATS
+{
+    QueueHandle_t xHandle;             /* The handle of the queue. */
+    const char * pcQueueName;          /* The name the queue was given when it was added to the registry. */
+    UBaseType_t uxLength;              /* The number of items the queue can hold. */
+    UBaseType_t uxMessagesWaiting;     /* The number of items in the queue at the time of the snapshot. */
+    QueueStats_t xStats;               /* The statistics of the queue at the time of the snapshot. */
+} QueueRegistryStats_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
@@ -235,6 +270,33 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateInArena(
+ *                            ArenaHandle_t xArena,
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a new queue instance, and returns a handle by which the new queue
+ * can be referenced.  The queue structure and storage area are allocated from
+ * the arena xArena rather than from the FreeRTOS heap - see arena.h.  The queue
+ * must be deleted before the arena is deleted or reset, but deleting the queue
+ * does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for this macro to be
+ * available.  The other parameters and the return value are the same as for
+ * xQueueCreate().
+ *
+ * \defgroup xQueueCreateInArena xQueueCreateInArena
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define xQueueCreateInArena( xArena, uxQueueLength, uxItemSize )    xQueueGenericCreateInArena( ( xArena ), ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_BASE ) )
+#endif /* configUSE_ARENAS */
+
 /**
  * queue. h
  * @code{c}
@@ -1513,6 +1575,17 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_ARENAS == 1 ) )
+    QueueHandle_t xQueueCreateMutexInArena( ArenaHandle_t xArena,
+                                            const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configUSE_ARENAS == 1 ) )
+    QueueHandle_t xQueueCreateCountingSemaphoreInArena( ArenaHandle_t xArena,
+                                                        const UBaseType_t uxMaxCount,
+                                                        const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
+#endif
+
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
@@ -1595,6 +1668,50 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Copies the contention and blocking statistics of a queue, semaphore or mutex
+ * into *pxStats.  configUSE_QUEUE_STATS must be set to 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * @param xQueue The handle of the queue being queried.
+ * @param pxStats The structure into which the statistics are copied.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Clears the statistics of a queue, semaphore or mutex.  The peak number of
+ * items waiting restarts from the number of items currently in the queue.
+ * configUSE_QUEUE_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle of the queue being reset.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueResetStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Takes a snapshot of the statistics of every queue, semaphore and mutex in
+ * the queue registry.  Each entry is copied atomically, but the entries are
+ * not copied at the same instant, so the snapshot is not a consistent view of
+ * the whole system.  configUSE_QUEUE_STATS must be set to 1 and
+ * configQUEUE_REGISTRY_SIZE must be greater than 0 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param pxStatsArray Array into which a QueueRegistryStats_t structure is
+ * written for each registered queue.
+ * @param uxArraySize The number of structures pxStatsArray can hold.
+ * @return The number of structures written to pxStatsArray.  Zero is returned
+ * if uxArraySize is smaller than the number of registered queues.
+ */
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t * const pxStatsArray,
+                                         const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1619,6 +1736,18 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
                                              const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Generic version of the function used to create a queue in an arena.  This is
+ * called by other functions and macros that create other RTOS objects that use
+ * the queue structure as their base.
+ */
+#if ( configUSE_ARENAS == 1 )
+    QueueHandle_t xQueueGenericCreateInArena( ArenaHandle_t xArena,
+                                              const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to retrieve the buffers of statically
  * created queues. This is called by other functions and macros that retrieve
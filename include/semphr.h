@@ -228,6 +228,25 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateBinaryStatic( pxStaticSemaphore )    xQueueGenericCreateStatic( ( UBaseType_t ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxStaticSemaphore ), queueQUEUE_TYPE_BINARY_SEMAPHORE )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateBinaryInArena( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * A version of xSemaphoreCreateBinary() that allocates the semaphore from the
+ * arena xArena rather than from the FreeRTOS heap - see arena.h.  The
+ * semaphore must be deleted before the arena is deleted or reset, but deleting
+ * the semaphore does not free any memory.  configUSE_ARENAS must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateBinaryInArena xSemaphoreCreateBinaryInArena
+ * \ingroup Semaphores
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define xSemaphoreCreateBinaryInArena( xArena )    xQueueGenericCreateInArena( ( xArena ), ( UBaseType_t ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_BINARY_SEMAPHORE )
+#endif /* configUSE_ARENAS */
+
 /**
  * semphr. h
  * @code{c}
@@ -798,6 +817,25 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexInArena( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * A version of xSemaphoreCreateMutex() that allocates the mutex from the arena
+ * xArena rather than from the FreeRTOS heap - see arena.h.  The mutex must be
+ * deleted before the arena is deleted or reset, but deleting the mutex does
+ * not free any memory.  configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateMutexInArena xSemaphoreCreateMutexInArena
+ * \ingroup Semaphores
+ */
+#if ( ( configUSE_ARENAS == 1 ) && ( configUSE_MUTEXES == 1 ) )
+    #define xSemaphoreCreateMutexInArena( xArena )    xQueueCreateMutexInArena( ( xArena ), queueQUEUE_TYPE_MUTEX )
+#endif /* configUSE_ARENAS */
+
 
 /**
  * semphr. h
@@ -943,6 +981,25 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateRecursiveMutexStatic( pxStaticSemaphore )    xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxStaticSemaphore ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRecursiveMutexInArena( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * A version of xSemaphoreCreateRecursiveMutex() that allocates the mutex from
+ * the arena xArena rather than from the FreeRTOS heap - see arena.h.  The mutex
+ * must be deleted before the arena is deleted or reset, but deleting the mutex
+ * does not free any memory.  configUSE_ARENAS must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexInArena xSemaphoreCreateRecursiveMutexInArena
+ * \ingroup Semaphores
+ */
+#if ( ( configUSE_ARENAS == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 ) )
+    #define xSemaphoreCreateRecursiveMutexInArena( xArena )    xQueueCreateMutexInArena( ( xArena ), queueQUEUE_TYPE_RECURSIVE_MUTEX )
+#endif /* configUSE_ARENAS */
+
 /**
  * semphr. h
  * @code{c}
@@ -1112,6 +1169,25 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer )    xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCountingInArena( ArenaHandle_t xArena, UBaseType_t uxMaxCount, UBaseType_t uxInitialCount );
+ * @endcode
+ *
+ * A version of xSemaphoreCreateCounting() that allocates the semaphore from the
+ * arena xArena rather than from the FreeRTOS heap - see arena.h.  The
+ * semaphore must be deleted before the arena is deleted or reset, but deleting
+ * the semaphore does not free any memory.  configUSE_ARENAS must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateCountingInArena xSemaphoreCreateCountingInArena
+ * \ingroup Semaphores
+ */
+#if ( ( configUSE_ARENAS == 1 ) && ( configUSE_COUNTING_SEMAPHORES == 1 ) )
+    #define xSemaphoreCreateCountingInArena( xArena, uxMaxCount, uxInitialCount )    xQueueCreateCountingSemaphoreInArena( ( xArena ), ( uxMaxCount ), ( uxInitialCount ) )
+#endif /* configUSE_ARENAS */
+
 /**
  * semphr. h
  * @code{c}
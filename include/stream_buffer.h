@@ -85,6 +85,34 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Describes one of the messages copied out of a message buffer by
+ * xMessageBufferReceiveMultiple().
+ */
+typedef struct xMESSAGE_BUFFER_RECORD
+{
+    size_t xOffset; /**< The offset of the message from the start of the receive buffer. */
+    size_t xLength; /**< The length of the message in bytes. */
+} MessageBufferRecord_t;
+
+/**
+ * Used with vStreamBufferGetStats() to obtain the contention and blocking
+ * statistics of a stream or message buffer.  Only available when
+ * configUSE_STREAM_BUFFER_STATS is 1.
+ */
+typedef struct xSTREAM_BUFFER_STATS
+{
+    uint32_t ulSends;                /**< The number of sends that wrote data to the buffer. */
+    uint32_t ulReceives;             /**< The number of receives that read data from the buffer. */
+    uint32_t ulSendBlocks;           /**< The number of sends that found too little space and had to wait. */
+    uint32_t ulReceiveBlocks;        /**< The number of receives that found too little data and had to wait. */
+    size_t xPeakBytesWaiting;        /**< The largest number of bytes the buffer has held, including message lengths. */
+    TickType_t xSendWaitTicks;       /**< The total time senders spent waiting for space. */
+    TickType_t xMaxSendWaitTicks;    /**< The longest time a single send waited for space. */
+    TickType_t xReceiveWaitTicks;    /**< The total time receivers spent waiting for data. */
+    TickType_t xMaxReceiveWaitTicks; /**< The longest time a single receive waited for data. */
+} StreamBufferStats_t;
+
 /**
  * stream_buffer.h
  *
@@ -271,6 +299,29 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBufferCreateInArena( ArenaHandle_t xArena, size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * @endcode
+ *
+ * A version of xStreamBufferCreate() that allocates the stream buffer from the
+ * arena xArena rather than from the FreeRTOS heap - see arena.h.  The stream
+ * buffer must be deleted before the arena is deleted or reset, but deleting the
+ * stream buffer does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferCreateInArena() to be available.
+ *
+ * \defgroup xStreamBufferCreateInArena xStreamBufferCreateInArena
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define xStreamBufferCreateInArena( xArena, xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreateInArena( ( xArena ), ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, NULL, NULL )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -459,6 +510,29 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BATCHING_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBatchingBufferCreateInArena( ArenaHandle_t xArena, size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * @endcode
+ *
+ * A version of xStreamBatchingBufferCreate() that allocates the stream batching
+ * buffer from the arena xArena rather than from the FreeRTOS heap - see
+ * arena.h.  The buffer must be deleted before the arena is deleted or reset,
+ * but deleting the buffer does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBatchingBufferCreateInArena() to be available.
+ *
+ * \defgroup xStreamBatchingBufferCreateInArena xStreamBatchingBufferCreateInArena
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define xStreamBatchingBufferCreateInArena( xArena, xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreateInArena( ( xArena ), ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BATCHING_BUFFER, NULL, NULL )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -1101,6 +1175,104 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILE
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                          size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetMaxLatency( StreamBufferHandle_t xStreamBuffer, TickType_t xMaxLatencyTicks );
+ * @endcode
+ *
+ * Sets the maximum latency of a stream batching buffer.  A task blocked on a
+ * read of a stream batching buffer is unblocked when the number of bytes in the
+ * buffer exceeds the trigger level, or when data has been waiting in the
+ * buffer for xMaxLatencyTicks ticks, whichever happens first, so data written
+ * just below the trigger level is not held until the reader's own block time
+ * expires.  The age of the data is measured from the time the buffer last went
+ * from empty to not empty, so is never less than the age of the oldest unread
+ * byte.  Setting xMaxLatencyTicks to 0 removes the maximum latency, which is
+ * the default.
+ *
+ * When a maximum latency is set the writer also notifies a blocked reader each
+ * time the buffer goes from empty to not empty, so the reader can shorten its
+ * block time to the point at which the data becomes too old.
+ *
+ * configUSE_SB_MAX_LATENCY must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSetMaxLatency() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream batching buffer being updated.
+ *
+ * @param xMaxLatencyTicks The maximum time, in ticks, data can wait in the
+ * buffer before a blocked reader is unblocked, or 0 for no maximum.
+ *
+ * @return pdPASS if the maximum latency was set, or pdFAIL if xStreamBuffer
+ * is not a stream batching buffer.
+ *
+ * \defgroup xStreamBufferSetMaxLatency xStreamBufferSetMaxLatency
+ * \ingroup StreamBatchingBufferManagement
+ */
+#if ( configUSE_SB_MAX_LATENCY == 1 )
+    BaseType_t xStreamBufferSetMaxLatency( StreamBufferHandle_t xStreamBuffer,
+                                           TickType_t xMaxLatencyTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, StreamBufferStats_t * pxStats );
+ * @endcode
+ *
+ * Copies the contention and blocking statistics of a stream buffer or message
+ * buffer into *pxStats.  Wait times are measured in ticks from the time a send
+ * or receive first had to block until it completed or timed out.  The
+ * statistics are cleared when the buffer is created or reset.
+ *
+ * Stream buffers are not added to the queue registry, so unlike queues there is
+ * no single call that returns the statistics of every stream buffer.
+ *
+ * The sending side of the statistics is only updated by the writer, and the
+ * receiving side only by the reader, so no critical section is needed to
+ * update them.  As a result the copy is not atomic if a send or receive is in
+ * progress on another core or in an interrupt.
+ *
+ * configUSE_STREAM_BUFFER_STATS must be set to 1 in FreeRTOSConfig.h for
+ * vStreamBufferGetStats() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * \defgroup vStreamBufferGetStats vStreamBufferGetStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                StreamBufferStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Clears the statistics of a stream buffer or message buffer.  The peak number
+ * of bytes waiting restarts from the number of bytes currently in the buffer.
+ * Must not be called while a send or receive is in progress.
+ *
+ * configUSE_STREAM_BUFFER_STATS must be set to 1 in FreeRTOSConfig.h for
+ * vStreamBufferResetStats() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being reset.
+ *
+ * \defgroup vStreamBufferResetStats vStreamBufferResetStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -1262,8 +1434,24 @@ StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_ARENAS == 1 )
+    StreamBufferHandle_t xStreamBufferGenericCreateInArena( ArenaHandle_t xArena,
+                                                            size_t xBufferSizeBytes,
+                                                            size_t xTriggerLevelBytes,
+                                                            BaseType_t xStreamBufferType,
+                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
+#endif
+
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+size_t xStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvRxData,
+                                     size_t xBufferLengthBytes,
+                                     MessageBufferRecord_t * const pxRecords,
+                                     size_t xMaxRecords,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer,
                                              UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
@@ -95,6 +95,17 @@ struct tskTaskControlBlock; /* The old naming convention is used to prevent brea
 typedef struct tskTaskControlBlock         * TaskHandle_t;
 typedef const struct tskTaskControlBlock   * ConstTaskHandle_t;
 
+/**
+ * task. h
+ *
+ * Type by which arenas are referenced.  See arena.h.
+ *
+ * \defgroup ArenaHandle_t ArenaHandle_t
+ * \ingroup Tasks
+ */
+struct ArenaDefinition;
+typedef struct ArenaDefinition * ArenaHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -180,6 +191,62 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+/* Used with vTaskGetWakeLatency() to obtain the wake latency histogram of a
+ * task.  The wake latency is the time from the task leaving the Blocked or
+ * Suspended state (or being created) until it next runs, measured with the run
+ * time stats clock.  Also used with vTaskGetISRWakeLatency() to obtain the
+ * latency histogram of an interrupt source. */
+typedef struct xTASK_WAKE_LATENCY
+{
+    uint32_t ulSamples;                                      /* The number of latencies recorded since the task was created or its latencies were last reset. */
+    configRUN_TIME_COUNTER_TYPE ulMinimum;                   /* The shortest latency recorded.  Only valid when ulSamples is not zero. */
+    configRUN_TIME_COUNTER_TYPE ulMaximum;                   /* The longest latency recorded.  Only valid when ulSamples is not zero. */
+    uint32_t ulBuckets[ configTASK_WAKE_LATENCY_BUCKETS ];   /* ulBuckets[ 0 ] counts latencies of 0, and ulBuckets[ n ] counts latencies from 2^(n-1) to (2^n)-1, except the last bucket, which also counts all longer latencies. */
+} TaskWakeLatency_t;
+
+/* Used with uxTaskSnapshotNext() to return a compact record of the state of a
+ * task.  Only available when configUSE_TASK_SNAPSHOT is 1. */
+typedef struct xTASK_SNAPSHOT_RECORD
+{
+    TaskHandle_t xHandle;                             /* The handle of the task. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;     /* The run time counter of the task, see TaskStatus_t.  Zero if configGENERATE_RUN_TIME_STATS is not 1. */
+    UBaseType_t uxTaskNumber;                         /* A number unique to the task. */
+    UBaseType_t uxCurrentPriority;                    /* The priority at which the task was running, which may be inherited. */
+    UBaseType_t uxBasePriority;                       /* The priority to which the task returns once it no longer holds a mutex.  Zero if configUSE_MUTEXES is not 1. */
+    uint32_t ulNotificationsPending;                  /* Bit n is set if notification index n has a notification the task has not yet received.  Only the first 32 indexes are reported. */
+    uint32_t ulNotificationsWaiting;                  /* Bit n is set if the task is blocked waiting on notification index n.  Only the first 32 indexes are reported. */
+    configSTACK_DEPTH_TYPE usStackHighWaterMark;      /* The minimum amount of stack space that has remained for the task since it was created, in words. */
+    uint8_t ucState;                                  /* The state of the task, one of the eTaskState values. */
+    char pcTaskName[ configMAX_TASK_NAME_LEN ];       /* A copy of the name of the task, so the record remains valid if the task is deleted. */
+} TaskSnapshotRecord_t;
+
+/* Holds the position of a snapshot started by vTaskSnapshotBegin().  The
+ * members are for internal use only. */
+typedef struct xTASK_SNAPSHOT
+{
+    uint32_t ulGeneration;
+    UBaseType_t uxNextList;
+    ListItem_t * pxNextItem;
+    UBaseType_t uxTaskNumber;
+} TaskSnapshot_t;
+
+/* Used with vTaskGetInversionStats() to obtain the priority inheritance
+ * statistics of a task.  The task is boosted while it runs with a priority
+ * inherited from a higher priority task that is blocked on a mutex it holds.
+ * Times are measured with the run time stats clock.  Only available when
+ * configUSE_PRIORITY_INVERSION_STATS is 1. */
+typedef struct xTASK_INVERSION_STATS
+{
+    uint32_t ulBoosts;                                                  /* The number of times the task was boosted. */
+    configRUN_TIME_COUNTER_TYPE ulBoostedTime;                          /* The total time the task has been boosted, including any boost still in progress. */
+    configRUN_TIME_COUNTER_TYPE ulMaxBoostedTime;                       /* The longest time the task has been boosted without returning to its base priority. */
+    uint32_t ulMutexBlocks;                                             /* The number of times the task blocked on a mutex held by another task. */
+    configRUN_TIME_COUNTER_TYPE ulMaxMutexBlockTime;                    /* The longest time from the task blocking on a mutex to it running again. */
+    UBaseType_t uxLongestChain;                                         /* The most mutex holders in a blocking chain when the task blocked on a mutex. */
+    UBaseType_t uxWorstChainLength;                                     /* The number of entries used in xWorstChain. */
+    TaskHandle_t xWorstChain[ configPRIORITY_INVERSION_CHAIN_DEPTH ];   /* The blocking chain when the task blocked for ulMaxMutexBlockTime.  xWorstChain[ 0 ] held the mutex the task blocked on, xWorstChain[ 1 ] held the mutex xWorstChain[ 0 ] was blocked on, and so on. */
+} TaskInversionStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -529,6 +596,44 @@ typedef enum
                                                UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateInArena( ArenaHandle_t xArena,
+ *                                TaskFunction_t pxTaskCode,
+ *                                const char * const pcName,
+ *                                const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                void *pvParameters,
+ *                                UBaseType_t uxPriority,
+ *                                TaskHandle_t *pxCreatedTask );
+ * @endcode
+ *
+ * Create a new task and add it to the list of tasks that are ready to run,
+ * allocating the task's stack and control block from the arena xArena rather
+ * than from the FreeRTOS heap.  xArena becomes the new task's default arena,
+ * so the objects the task creates also come from the arena - see
+ * vTaskSetDefaultArena().
+ *
+ * The task must be deleted before the arena is deleted or reset.  Deleting
+ * the task does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for this function to be
+ * available.  The other parameters and the return value are the same as for
+ * xTaskCreate().
+ *
+ * \defgroup xTaskCreateInArena xTaskCreateInArena
+ * \ingroup Tasks
+ */
+#if ( configUSE_ARENAS == 1 )
+    BaseType_t xTaskCreateInArena( ArenaHandle_t xArena,
+                                   TaskFunction_t pxTaskCode,
+                                   const char * const pcName,
+                                   const configSTACK_DEPTH_TYPE uxStackDepth,
+                                   void * const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1863,6 +1968,227 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetWakeLatency( TaskHandle_t xTask, TaskWakeLatency_t * pxWakeLatency );
+ * @endcode
+ *
+ * configUSE_TASK_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Copies the wake latency histogram of xTask into *pxWakeLatency.  A latency
+ * is recorded each time the task is switched in after being unblocked, resumed
+ * or created, and is the time it spent in the Ready state first.  Long
+ * latencies for a task usually mean higher priority tasks are using too much
+ * processing time, or the task's priority is too low.
+ *
+ * @param xTask Handle of the task to query.  Set xTask to NULL to query the
+ * calling task.
+ *
+ * @param pxWakeLatency The structure into which the histogram is copied.
+ */
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+    void vTaskGetWakeLatency( TaskHandle_t xTask,
+                              TaskWakeLatency_t * pxWakeLatency ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetWakeLatency( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TASK_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Discards the wake latencies recorded for xTask.
+ *
+ * @param xTask Handle of the task to reset.  Set xTask to NULL to reset the
+ * calling task.
+ */
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+    void vTaskResetWakeLatency( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetWakeLatencyPercentile( const TaskWakeLatency_t * pxWakeLatency, UBaseType_t uxPercentile );
+ * @endcode
+ *
+ * configUSE_TASK_WAKE_LATENCY or configUSE_ISR_WAKE_LATENCY must be set to 1
+ * in FreeRTOSConfig.h for this function to be available.
+ *
+ * Estimates a percentile of the latencies in a histogram obtained from
+ * vTaskGetWakeLatency() or vTaskGetISRWakeLatency().  As the histogram only records which power of 2
+ * range each latency fell in, the returned value is the upper end of the range
+ * that contains the percentile, limited to the longest latency recorded, so
+ * is at most twice the true value.
+ *
+ * @param pxWakeLatency The histogram.
+ *
+ * @param uxPercentile The percentile, from 0 to 100.  For example, 99 returns
+ * a latency that at least 99% of the recorded latencies did not exceed.
+ *
+ * @return The estimated percentile, in run time stats clock counts, or 0 if
+ * the histogram is empty.
+ */
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWakeLatencyPercentile( const TaskWakeLatency_t * pxWakeLatency,
+                                                                UBaseType_t uxPercentile ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetInversionStats( TaskHandle_t xTask, TaskInversionStats_t * pxStats );
+ * @endcode
+ *
+ * configUSE_PRIORITY_INVERSION_STATS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Copies the priority inheritance statistics of xTask into *pxStats.  They
+ * show both sides of a priority inversion: how often and for how long xTask
+ * was boosted because it held a mutex a higher priority task needed, and how
+ * long xTask itself was held up waiting for mutexes held by other tasks.
+ *
+ * When xTask blocks on a mutex, the task holding the mutex is recorded, then
+ * the task holding the mutex that task is blocked on, and so on, up to
+ * configPRIORITY_INVERSION_CHAIN_DEPTH tasks.  The chain recorded for the
+ * longest wait is kept in xWorstChain.  A chain that grows after xTask blocks
+ * is recorded against the task that blocked later.
+ *
+ * @param xTask Handle of the task to query.  Set xTask to NULL to query the
+ * calling task.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+    void vTaskGetInversionStats( TaskHandle_t xTask,
+                                 TaskInversionStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetInversionStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_PRIORITY_INVERSION_STATS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Discards the priority inheritance statistics recorded for xTask.
+ *
+ * @param xTask Handle of the task to reset.  Set xTask to NULL to reset the
+ * calling task.
+ */
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+    void vTaskResetInversionStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * UBaseType_t uxTaskSetISRWakeSourceFromISR( UBaseType_t uxSourceID );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Marks the rest of the calling interrupt as interrupt source uxSourceID.
+ * Each task that a *FromISR() API function, such as xQueueSendFromISR(),
+ * xSemaphoreGiveFromISR() or vTaskNotifyGiveFromISR(), unblocks while the
+ * source is set is stamped with the time, and the time from the stamp until
+ * the task runs is recorded in the latency histogram of the source.  Call
+ * vTaskRestoreISRWakeSourceFromISR() with the returned value before the
+ * interrupt requests a context switch, so that nested interrupts and tasks
+ * are not attributed to the source.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAnInterruptHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * UBaseType_t uxSavedSource;
+ *
+ *     uxSavedSource = uxTaskSetISRWakeSourceFromISR( mainUART_RX_SOURCE );
+ *     xQueueSendFromISR( xRxQueue, &cReceived, &xHigherPriorityTaskWoken );
+ *     vTaskRestoreISRWakeSourceFromISR( uxSavedSource );
+ *
+ *     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ *
+ * @param uxSourceID The interrupt source, from 0 to
+ * configISR_WAKE_LATENCY_SOURCES - 1.
+ *
+ * @return The previous source, to pass to vTaskRestoreISRWakeSourceFromISR().
+ */
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    UBaseType_t uxTaskSetISRWakeSourceFromISR( UBaseType_t uxSourceID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskRestoreISRWakeSourceFromISR( UBaseType_t uxSavedSource );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Ends the interrupt source set by uxTaskSetISRWakeSourceFromISR().
+ *
+ * @param uxSavedSource The value returned by the matching call to
+ * uxTaskSetISRWakeSourceFromISR().
+ */
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    void vTaskRestoreISRWakeSourceFromISR( UBaseType_t uxSavedSource ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetISRWakeLatency( UBaseType_t uxSourceID, TaskWakeLatency_t * pxWakeLatency );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Copies the latency histogram of interrupt source uxSourceID into
+ * *pxWakeLatency.  Each latency is the time from a *FromISR() API function
+ * unblocking a task, while the interrupt source was set, until the task runs.
+ * Use ulTaskGetWakeLatencyPercentile() to estimate percentiles.
+ *
+ * @param uxSourceID The interrupt source, from 0 to
+ * configISR_WAKE_LATENCY_SOURCES - 1.
+ *
+ * @param pxWakeLatency The structure into which the histogram is copied.
+ */
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    void vTaskGetISRWakeLatency( UBaseType_t uxSourceID,
+                                 TaskWakeLatency_t * pxWakeLatency ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetISRWakeLatency( UBaseType_t uxSourceID );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Discards the latencies recorded for interrupt source uxSourceID.
+ *
+ * @param uxSourceID The interrupt source, from 0 to
+ * configISR_WAKE_LATENCY_SOURCES - 1.
+ */
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    void vTaskResetISRWakeLatency( UBaseType_t uxSourceID ) PRIVILEGED_FUNCTION;
+#endif
+
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
  * so the following two prototypes will cause a compilation error.  This can be
@@ -1925,6 +2251,39 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_ARENAS == 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskSetDefaultArena( TaskHandle_t xTask, ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Sets the default arena of the task xTask.  While a task has a default arena,
+ * the tasks, queues, semaphores, stream buffers, message buffers, event groups
+ * and timers it creates using the dynamic create functions, such as
+ * xTaskCreate() and xQueueCreate(), are created in that arena, as if the
+ * matching *CreateInArena() function had been called.  Passing xArena as NULL
+ * returns the task to allocating from the FreeRTOS heap.  Passing xTask as NULL
+ * sets the default arena of the calling task.
+ */
+    void vTaskSetDefaultArena( TaskHandle_t xTask,
+                               ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * ArenaHandle_t xTaskGetDefaultArena( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Returns the default arena of the task xTask, or NULL if it does not have one.
+ * Passing xTask as NULL returns the default arena of the calling task, which is
+ * always NULL before the scheduler has been started.
+ */
+    ArenaHandle_t xTaskGetDefaultArena( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_ARENAS */
+
 #if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
 
 /**
@@ -2183,6 +2542,97 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Starts a snapshot of the state of every task.  The snapshot is then read in
+ * chunks by calling uxTaskSnapshotNext() until it returns 0.
+ *
+ * Unlike uxTaskGetSystemState(), which suspends the scheduler while it visits
+ * every task, uxTaskSnapshotNext() only suspends the scheduler while it fills
+ * the records it is given, so monitoring a system with many tasks does not
+ * delay higher priority tasks by more than the time taken to read one chunk.
+ * Each call continues from where the previous call stopped, so the time taken
+ * does not grow with the number of tasks already reported.  The snapshot is
+ * not atomic.  Each task is reported at most once, but a task that changes
+ * state while the snapshot is in progress, or occasionally a task next to one
+ * that does, may be missed, and tasks created after the snapshot started may
+ * or may not be reported.
+ *
+ * Only one snapshot can be in progress at a time.  Starting a new snapshot
+ * ends any snapshot already in progress, after which uxTaskSnapshotNext()
+ * returns 0 for the old one.
+ *
+ * @param pxSnapshot The structure that records the position of the snapshot.
+ *
+ * Example usage:
+ * @code{c}
+ *  void vTaskMonitor( void )
+ *  {
+ *  TaskSnapshot_t xSnapshot;
+ *  TaskSnapshotRecord_t xRecords[ 8 ];
+ *  UBaseType_t uxCount, x;
+ *
+ *      vTaskSnapshotBegin( &xSnapshot );
+ *
+ *      while( ( uxCount = uxTaskSnapshotNext( &xSnapshot, xRecords, 8 ) ) > 0 )
+ *      {
+ *          for( x = 0; x < uxCount; x++ )
+ *          {
+ *              // Send xRecords[ x ] to the host.
+ *          }
+ *
+ *          // Let other tasks run before reading the next chunk.
+ *          taskYIELD();
+ *      }
+ *  }
+ * @endcode
+ * \defgroup vTaskSnapshotBegin vTaskSnapshotBegin
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot, TaskSnapshotRecord_t * const pxRecords, const UBaseType_t uxMaxRecords );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Reads the next chunk of a snapshot started by vTaskSnapshotBegin().  Each
+ * record includes the task's stack high water mark, so a chunk takes longer
+ * to read when configUSE_STACK_HIGH_WATER_MARK_CACHE is 0.
+ *
+ * @param pxSnapshot The snapshot passed to vTaskSnapshotBegin().
+ *
+ * @param pxRecords Array into which a TaskSnapshotRecord_t is written for each
+ * task in the chunk.
+ *
+ * @param uxMaxRecords The number of records pxRecords can hold, which is the
+ * largest number of tasks the chunk will contain.
+ *
+ * @return The number of records written to pxRecords.  0 is returned once
+ * every task has been reported.
+ *
+ * \defgroup uxTaskSnapshotNext uxTaskSnapshotNext
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot,
+                                    TaskSnapshotRecord_t * const pxRecords,
+                                    const UBaseType_t uxMaxRecords ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2356,6 +2806,40 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                     size_t uxBufferLength ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskListInversionChains( char *pcWriteBuffer, size_t uxBufferLength );
+ * @endcode
+ *
+ * configUSE_PRIORITY_INVERSION_STATS, configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must all be defined as 1 for this
+ * function to be available.
+ *
+ * Writes a line for each task that has been boosted or has blocked on a mutex,
+ * giving in columns the number of times it blocked on a mutex, the longest
+ * time it waited, the number of times it was boosted, the total time it was
+ * boosted, and the names of the tasks in the blocking chain recorded for its
+ * longest wait, for example "Hi  3  120  0  0  Mid -> Lo".  Tasks in the chain
+ * that have since been deleted are shown as "?".
+ *
+ * Like vTaskListTasks(), this function is provided for convenience only and
+ * calls uxTaskGetSystemState() and snprintf().  Production systems should call
+ * vTaskGetInversionStats() directly.
+ *
+ * @param pcWriteBuffer A buffer into which the table will be written, in
+ * ASCII form.
+ *
+ * @param uxBufferLength Length of the pcWriteBuffer.
+ *
+ * \defgroup vTaskListInversionChains vTaskListInversionChains
+ * \ingroup TaskUtils
+ */
+#if ( ( configUSE_PRIORITY_INVERSION_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+    void vTaskListInversionChains( char * pcWriteBuffer,
+                                   size_t uxBufferLength ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3564,6 +4048,27 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that can be called from an
+ * interrupt.  It is used by the event groups implementation when
+ * configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1, in which case the event
+ * group guarantees that no task is accessing the event list at the same time.
+ * If the scheduler is suspended the unblocked task is held on the pending ready
+ * list until the scheduler is resumed.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was interrupted, otherwise pdFALSE.
+ */
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3687,6 +4192,17 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Records the list item that links the calling task's
+ * wait record into a wide event group, so the record can be removed from the
+ * event group if the task is deleted while it is blocked.  Pass NULL once the
+ * record is no longer in the event group.  Must be called with the scheduler
+ * suspended.
+ */
+#if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+    void vTaskInternalSetWideEventWaitItem( ListItem_t * pxWaitItem ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only. Same as portYIELD_WITHIN_API() in single core FreeRTOS.
  * For SMP this is not defined by the port.
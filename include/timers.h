@@ -365,6 +365,32 @@ typedef void (* PendedFunction_t)( void * arg1,
                                       StaticTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateInArena( ArenaHandle_t xArena,
+ *                                    const char * const pcTimerName,
+ *                                    TickType_t xTimerPeriodInTicks,
+ *                                    BaseType_t xAutoReload,
+ *                                    void * pvTimerID,
+ *                                    TimerCallbackFunction_t pxCallbackFunction );
+ *
+ * A version of xTimerCreate() that allocates the timer from the arena xArena
+ * rather than from the FreeRTOS heap - see arena.h.  The timer must be deleted,
+ * and the timer service task must have processed the delete command, before
+ * the arena is deleted or reset.  Deleting the timer does not free any memory.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for this function to be
+ * available.  The other parameters and the return value are the same as for
+ * xTimerCreate().
+ */
+#if ( configUSE_ARENAS == 1 )
+    TimerHandle_t xTimerCreateInArena( ArenaHandle_t xArena,
+                                       const char * const pcTimerName,
+                                       const TickType_t xTimerPeriodInTicks,
+                                       const BaseType_t xAutoReload,
+                                       void * const pvTimerID,
+                                       TimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_ARENAS */
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
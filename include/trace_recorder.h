@@ -0,0 +1,411 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The trace recorder records kernel events, such as context switches, tasks
+ * becoming ready and queue operations, into RAM as compact fixed size binary
+ * records, so the behaviour of an application can be examined on a timeline
+ * after the event.  It is included in the build by setting
+ * configUSE_TRACE_RECORDER to 1 in FreeRTOSConfig.h and adding
+ * trace_recorder.c to the project.  FreeRTOS.h then includes this header,
+ * which defines the kernel trace macros listed below to record events.  Any
+ * trace macro already defined in FreeRTOSConfig.h is left unchanged.
+ *
+ * Each core records into its own ring buffer of
+ * configTRACE_RECORDER_BUFFER_EVENTS events, overwriting the oldest events
+ * when the buffer is full.  Recording an event only masks interrupts on the
+ * calling core for the few instructions needed to write the record - no lock
+ * is taken and no kernel function is called.
+ *
+ * Timestamps are obtained from configTRACE_RECORDER_GET_TIMESTAMP(), which
+ * defaults to portGET_RUN_TIME_COUNTER_VALUE(), and are truncated to 32 bits.
+ * Set configTRACE_RECORDER_TIMESTAMP_HZ to the frequency of the timestamp so
+ * the recording can be converted to real time.
+ *
+ * The names of tasks, and of queues added to the queue registry, are kept in
+ * a table of configTRACE_RECORDER_MAX_OBJECTS entries that is not overwritten
+ * by new events.
+ *
+ * xTraceRecorderDump() writes the recording in the binary format described
+ * below, which examples/trace_recorder/trace_converter.c converts to the JSON
+ * trace event format that can be opened by Perfetto (https://ui.perfetto.dev).
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include trace_recorder.h"
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* The number of events in the buffer of each core.  Must be a power of 2. */
+    #ifndef configTRACE_RECORDER_BUFFER_EVENTS
+        #define configTRACE_RECORDER_BUFFER_EVENTS    1024
+    #endif
+
+/* The number of entries in the object name table. */
+    #ifndef configTRACE_RECORDER_MAX_OBJECTS
+        #define configTRACE_RECORDER_MAX_OBJECTS    32
+    #endif
+
+    #ifndef configTRACE_RECORDER_GET_TIMESTAMP
+        #ifdef portGET_RUN_TIME_COUNTER_VALUE
+            #define configTRACE_RECORDER_GET_TIMESTAMP()    portGET_RUN_TIME_COUNTER_VALUE()
+        #else
+            #error configUSE_TRACE_RECORDER is 1 but neither configTRACE_RECORDER_GET_TIMESTAMP() nor portGET_RUN_TIME_COUNTER_VALUE() is defined.
+        #endif
+    #endif
+
+/* The frequency of configTRACE_RECORDER_GET_TIMESTAMP(), or 0 if it is not
+ * known, in which case the converter treats timestamps as microseconds. */
+    #ifndef configTRACE_RECORDER_TIMESTAMP_HZ
+        #define configTRACE_RECORDER_TIMESTAMP_HZ    0
+    #endif
+
+/* The events that are recorded.  The meaning of the object and value of each
+ * event is given in brackets. */
+    #define traceRECORDER_EVENT_TASK_SWITCHED_IN           ( ( uint8_t ) 1U )  /* (task, priority) */
+    #define traceRECORDER_EVENT_TASK_READY                 ( ( uint8_t ) 2U )  /* (task, priority) */
+    #define traceRECORDER_EVENT_TASK_CREATE                ( ( uint8_t ) 3U )  /* (task, priority) */
+    #define traceRECORDER_EVENT_TASK_DELETE                ( ( uint8_t ) 4U )  /* (task, 0) */
+    #define traceRECORDER_EVENT_TASK_DELAY                 ( ( uint8_t ) 5U )  /* (calling task, 0) */
+    #define traceRECORDER_EVENT_TASK_DELAY_UNTIL           ( ( uint8_t ) 6U )  /* (calling task, tick to wake) */
+    #define traceRECORDER_EVENT_TASK_SUSPEND               ( ( uint8_t ) 7U )  /* (task, 0) */
+    #define traceRECORDER_EVENT_TASK_RESUME                ( ( uint8_t ) 8U )  /* (task, 0) */
+    #define traceRECORDER_EVENT_TASK_RESUME_FROM_ISR       ( ( uint8_t ) 9U )  /* (task, 0) */
+    #define traceRECORDER_EVENT_TASK_PRIORITY_SET          ( ( uint8_t ) 10U ) /* (task, new priority) */
+    #define traceRECORDER_EVENT_TASK_PRIORITY_INHERIT      ( ( uint8_t ) 11U ) /* (mutex holder, inherited priority) */
+    #define traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT   ( ( uint8_t ) 12U ) /* (mutex holder, original priority) */
+    #define traceRECORDER_EVENT_TASK_NOTIFY                ( ( uint8_t ) 13U ) /* (notified task, index) */
+    #define traceRECORDER_EVENT_TASK_NOTIFY_FROM_ISR       ( ( uint8_t ) 14U ) /* (notified task, index) */
+    #define traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK     ( ( uint8_t ) 15U ) /* (calling task, index) */
+    #define traceRECORDER_EVENT_TASK_NOTIFY_WAIT           ( ( uint8_t ) 16U ) /* (calling task, index) */
+    #define traceRECORDER_EVENT_QUEUE_CREATE               ( ( uint8_t ) 20U ) /* (queue, length) */
+    #define traceRECORDER_EVENT_QUEUE_DELETE               ( ( uint8_t ) 21U ) /* (queue, 0) */
+    #define traceRECORDER_EVENT_QUEUE_SEND                 ( ( uint8_t ) 22U ) /* (queue, items before the send) */
+    #define traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR        ( ( uint8_t ) 23U ) /* (queue, items before the send) */
+    #define traceRECORDER_EVENT_QUEUE_SEND_FAILED          ( ( uint8_t ) 24U ) /* (queue, items) */
+    #define traceRECORDER_EVENT_QUEUE_RECEIVE              ( ( uint8_t ) 25U ) /* (queue, items before the receive) */
+    #define traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR     ( ( uint8_t ) 26U ) /* (queue, items before the receive) */
+    #define traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED       ( ( uint8_t ) 27U ) /* (queue, items) */
+    #define traceRECORDER_EVENT_QUEUE_PEEK                 ( ( uint8_t ) 28U ) /* (queue, items) */
+    #define traceRECORDER_EVENT_QUEUE_BLOCKING_ON_SEND     ( ( uint8_t ) 29U ) /* (queue, items) */
+    #define traceRECORDER_EVENT_QUEUE_BLOCKING_ON_RECEIVE  ( ( uint8_t ) 30U ) /* (queue, items) */
+    #define traceRECORDER_EVENT_MUTEX_CREATE               ( ( uint8_t ) 31U ) /* (mutex, 0) */
+    #define traceRECORDER_EVENT_ISR_ENTER                  ( ( uint8_t ) 40U ) /* (NULL, 0) */
+    #define traceRECORDER_EVENT_ISR_EXIT                   ( ( uint8_t ) 41U ) /* (NULL, 0) */
+    #define traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER      ( ( uint8_t ) 42U ) /* (NULL, 0) */
+    #define traceRECORDER_EVENT_TIMER_EXPIRED              ( ( uint8_t ) 50U ) /* (timer, 0) */
+    #define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS       ( ( uint8_t ) 51U ) /* (event group, bits set) */
+    #define traceRECORDER_EVENT_EVENT_GROUP_WAIT_BLOCK     ( ( uint8_t ) 52U ) /* (event group, bits waited for) */
+    #define traceRECORDER_EVENT_USER                       ( ( uint8_t ) 60U ) /* (NULL, value), see vTraceRecorderUserEvent() */
+
+/* The types of object in the object name table. */
+    #define traceRECORDER_OBJECT_TASK     ( ( uint8_t ) 1U )
+    #define traceRECORDER_OBJECT_QUEUE    ( ( uint8_t ) 2U )
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+/* *INDENT-ON* */
+
+/* One recorded event.  Objects are identified by their handle, truncated to
+ * 32 bits. */
+    typedef struct xTRACE_RECORDER_EVENT
+    {
+        uint32_t ulTimestamp; /* configTRACE_RECORDER_GET_TIMESTAMP() when the event was recorded. */
+        uint8_t ucEventCode;  /* One of the traceRECORDER_EVENT_ values. */
+        uint8_t ucCoreID;     /* The core on which the event was recorded. */
+        uint16_t usParameter; /* The event ID of user events, otherwise 0. */
+        uint32_t ulObject;    /* The object the event applies to. */
+        uint32_t ulValue;     /* Event specific, see the traceRECORDER_EVENT_ values. */
+    } TraceRecorderEvent_t;
+
+/* The type of the function xTraceRecorderDump() calls to write the recording.
+ * Returns pdPASS if all xLength bytes were written. */
+    typedef BaseType_t ( * TraceRecorderWriteFunction_t )( const void * pvData,
+                                                           size_t xLength,
+                                                           void * pvContext );
+
+/*
+ * Records an event on the calling core.  Called by the trace macros below, and
+ * can be called from tasks and interrupts.
+ */
+    void vTraceRecorderEvent( uint8_t ucEventCode,
+                              const void * pvObject,
+                              uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records an application defined event with the ID usEventID and value
+ * ulValue.  Can be called from tasks and interrupts.
+ */
+    void vTraceRecorderUserEvent( uint16_t usEventID,
+                                  uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds pvObject to the object name table, or updates its name if it is
+ * already in the table.  Called when a task is created or a queue is added to
+ * the queue registry.  If the table is full the object is not added, and it is
+ * shown by its handle instead.
+ */
+    void vTraceRecorderAddObject( uint8_t ucObjectType,
+                                  const void * pvObject,
+                                  const char * pcName ) PRIVILEGED_FUNCTION;
+
+/*
+ * The recorder starts recording when the program starts.  vTraceRecorderStop()
+ * stops recording, after which new events are ignored until
+ * vTraceRecorderStart() is called.
+ */
+    void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+    void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Discards all recorded events.  The object name table is not cleared.  Must
+ * only be called while recording is stopped.
+ */
+    void vTraceRecorderClear( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes the recording by calling pxWrite() one or more times, passing
+ * pvContext to each call.  Returns pdPASS if every call to pxWrite() returned
+ * pdPASS.  Must only be called while recording is stopped, otherwise events
+ * being recorded on other cores while the buffers are written out may be torn.
+ *
+ * All values are little endian.  The format is:
+ *
+ * Offset  Size  Content
+ * 0       4     The characters 'F', 'R', 'T', 'R'.
+ * 4       1     Format version, currently 1.
+ * 5       1     C, the number of cores.
+ * 6       1     N, configMAX_TASK_NAME_LEN.
+ * 7       1     The size of an event record, currently 16.
+ * 8       4     configTRACE_RECORDER_TIMESTAMP_HZ.
+ * 12      4     configTRACE_RECORDER_BUFFER_EVENTS.
+ * 16      4     O, the number of object records.
+ * 20            O records of a 4 byte object handle, a 1 byte object type and
+ *               N bytes of name.
+ *               C core records, each of a 4 byte count of the events recorded
+ *               on the core since it was last cleared, a 4 byte count E of the
+ *               events that follow, then E 16 byte events from oldest to
+ *               newest.  Each event is ulTimestamp (4), ucEventCode (1),
+ *               ucCoreID (1), usParameter (2), ulObject (4) and ulValue (4).
+ */
+    BaseType_t xTraceRecorderDump( TraceRecorderWriteFunction_t pxWrite,
+                                   void * pvContext ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+    #ifdef __cplusplus
+        }
+    #endif
+/* *INDENT-ON* */
+
+/* The trace macros that record events. */
+    #ifndef traceTASK_SWITCHED_IN
+        #define traceTASK_SWITCHED_IN()    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_SWITCHED_IN, pxCurrentTCB, ( uint32_t ) pxCurrentTCB->uxPriority )
+    #endif
+
+    #ifndef traceMOVED_TASK_TO_READY_STATE
+        #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_READY, ( pxTCB ), ( uint32_t ) ( pxTCB )->uxPriority )
+    #endif
+
+    #ifndef traceTASK_CREATE
+        #define traceTASK_CREATE( pxNewTCB )                                                                        \
+    do {                                                                                                            \
+        vTraceRecorderAddObject( traceRECORDER_OBJECT_TASK, ( pxNewTCB ), ( pxNewTCB )->pcTaskName );               \
+        vTraceRecorderEvent( traceRECORDER_EVENT_TASK_CREATE, ( pxNewTCB ), ( uint32_t ) ( pxNewTCB )->uxPriority ); \
+    } while( 0 )
+    #endif
+
+    #ifndef traceTASK_DELETE
+        #define traceTASK_DELETE( pxTaskToDelete )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_DELETE, ( pxTaskToDelete ), 0U )
+    #endif
+
+    #ifndef traceTASK_DELAY
+        #define traceTASK_DELAY()    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_DELAY, pxCurrentTCB, 0U )
+    #endif
+
+    #ifndef traceTASK_DELAY_UNTIL
+        #define traceTASK_DELAY_UNTIL( x )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_DELAY_UNTIL, pxCurrentTCB, ( uint32_t ) ( x ) )
+    #endif
+
+    #ifndef traceTASK_SUSPEND
+        #define traceTASK_SUSPEND( pxTaskToSuspend )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_SUSPEND, ( pxTaskToSuspend ), 0U )
+    #endif
+
+    #ifndef traceTASK_RESUME
+        #define traceTASK_RESUME( pxTaskToResume )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_RESUME, ( pxTaskToResume ), 0U )
+    #endif
+
+    #ifndef traceTASK_RESUME_FROM_ISR
+        #define traceTASK_RESUME_FROM_ISR( pxTaskToResume )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_RESUME_FROM_ISR, ( pxTaskToResume ), 0U )
+    #endif
+
+    #ifndef traceTASK_PRIORITY_SET
+        #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_PRIORITY_SET, ( pxTask ), ( uint32_t ) ( uxNewPriority ) )
+    #endif
+
+    #ifndef traceTASK_PRIORITY_INHERIT
+        #define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_PRIORITY_INHERIT, ( pxTCBOfMutexHolder ), ( uint32_t ) ( uxInheritedPriority ) )
+    #endif
+
+    #ifndef traceTASK_PRIORITY_DISINHERIT
+        #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT, ( pxTCBOfMutexHolder ), ( uint32_t ) ( uxOriginalPriority ) )
+    #endif
+
+/* The notify macros are expanded where pxTCB is the task being notified. */
+    #ifndef traceTASK_NOTIFY
+        #define traceTASK_NOTIFY( uxIndexToNotify )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_FROM_ISR
+        #define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+        #define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_TAKE_BLOCK
+        #define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_WAIT_BLOCK
+        #define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_TAKE
+        #define traceTASK_NOTIFY_TAKE( uxIndexToWait )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_WAIT, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+    #endif
+
+    #ifndef traceTASK_NOTIFY_WAIT
+        #define traceTASK_NOTIFY_WAIT( uxIndexToWait )    vTraceRecorderEvent( traceRECORDER_EVENT_TASK_NOTIFY_WAIT, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+    #endif
+
+    #ifndef traceQUEUE_CREATE
+        #define traceQUEUE_CREATE( pxNewQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_CREATE, ( pxNewQueue ), ( uint32_t ) ( pxNewQueue )->uxLength )
+    #endif
+
+    #ifndef traceCREATE_MUTEX
+        #define traceCREATE_MUTEX( pxNewQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_MUTEX_CREATE, ( pxNewQueue ), 0U )
+    #endif
+
+    #ifndef traceQUEUE_DELETE
+        #define traceQUEUE_DELETE( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_DELETE, ( pxQueue ), 0U )
+    #endif
+
+    #ifndef traceQUEUE_REGISTRY_ADD
+        #define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )    vTraceRecorderAddObject( traceRECORDER_OBJECT_QUEUE, ( xQueue ), ( pcQueueName ) )
+    #endif
+
+    #ifndef traceQUEUE_SEND
+        #define traceQUEUE_SEND( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_SEND, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_SEND_FROM_ISR
+        #define traceQUEUE_SEND_FROM_ISR( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_SEND_FAILED
+        #define traceQUEUE_SEND_FAILED( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_SEND_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_SEND_FROM_ISR_FAILED
+        #define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_SEND_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_RECEIVE
+        #define traceQUEUE_RECEIVE( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_RECEIVE, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_RECEIVE_FROM_ISR
+        #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_RECEIVE_FAILED
+        #define traceQUEUE_RECEIVE_FAILED( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_RECEIVE_FROM_ISR_FAILED
+        #define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_PEEK
+        #define traceQUEUE_PEEK( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_PEEK, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceQUEUE_PEEK_FROM_ISR
+        #define traceQUEUE_PEEK_FROM_ISR( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_PEEK, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceBLOCKING_ON_QUEUE_SEND
+        #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_BLOCKING_ON_SEND, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+        #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_BLOCKING_ON_RECEIVE, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceBLOCKING_ON_QUEUE_PEEK
+        #define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )    vTraceRecorderEvent( traceRECORDER_EVENT_QUEUE_BLOCKING_ON_RECEIVE, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+    #endif
+
+    #ifndef traceISR_ENTER
+        #define traceISR_ENTER()    vTraceRecorderEvent( traceRECORDER_EVENT_ISR_ENTER, NULL, 0U )
+    #endif
+
+    #ifndef traceISR_EXIT
+        #define traceISR_EXIT()    vTraceRecorderEvent( traceRECORDER_EVENT_ISR_EXIT, NULL, 0U )
+    #endif
+
+    #ifndef traceISR_EXIT_TO_SCHEDULER
+        #define traceISR_EXIT_TO_SCHEDULER()    vTraceRecorderEvent( traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER, NULL, 0U )
+    #endif
+
+    #ifndef traceTIMER_EXPIRED
+        #define traceTIMER_EXPIRED( pxTimer )    vTraceRecorderEvent( traceRECORDER_EVENT_TIMER_EXPIRED, ( pxTimer ), 0U )
+    #endif
+
+    #ifndef traceEVENT_GROUP_SET_BITS
+        #define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )    vTraceRecorderEvent( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+    #endif
+
+    #ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+        #define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )    vTraceRecorderEvent( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+    #endif
+
+    #ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+        #define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )    vTraceRecorderEvent( traceRECORDER_EVENT_EVENT_GROUP_WAIT_BLOCK, ( xEventGroup ), ( uint32_t ) ( uxBitsToWaitFor ) )
+    #endif
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#endif /* TRACE_RECORDER_H */
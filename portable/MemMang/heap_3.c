@@ -45,6 +45,10 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file implements pvPortMalloc() and vPortFree(), so they must not be
+ * mapped onto the profiled versions in heap_profiler.c. */
+#define HEAP_IMPLEMENTATION_FILE
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -67,6 +67,15 @@
  *
  * Note 0x80000000 is the lower address so appears in the array first.
  *
+ * When configUSE_HEAP_REGION_PLACEMENT is 1 HeapRegion_t has a third member,
+ * uxTag, that describes the speed of the region's memory - 0 for the fastest
+ * memory, such as tightly coupled RAM, and larger values for slower memory.
+ * Each type of memory the kernel allocates, and pvPortMalloc(), then takes
+ * memory from the regions with the tag set for it by vPortSetHeapPlacement(),
+ * falling back to slower and then faster regions if those regions are full.
+ * pvPortMallocFromRegion() only takes memory from the regions with the given
+ * tag.  Per region usage is reported by xPortGetHeapRegionStats().
+ *
  */
 #include <stdlib.h>
 #include <string.h>
@@ -76,6 +85,10 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This file implements pvPortMalloc() and vPortFree(), so they must not be
+ * mapped onto the profiled versions in heap_profiler.c. */
+#define HEAP_IMPLEMENTATION_FILE
+
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -89,6 +102,38 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+#ifndef configUSE_HEAP_CORE_CACHES
+    #define configUSE_HEAP_CORE_CACHES    0
+#endif
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+    #ifndef configHEAP_CORE_CACHE_MAX_BLOCK_SIZE
+        #define configHEAP_CORE_CACHE_MAX_BLOCK_SIZE    256U
+    #endif
+
+    #ifndef configHEAP_CORE_CACHE_DEPTH
+        #define configHEAP_CORE_CACHE_DEPTH    8U
+    #endif
+
+    #if ( ( configHEAP_CORE_CACHE_MAX_BLOCK_SIZE % portBYTE_ALIGNMENT ) != 0 )
+        #error configHEAP_CORE_CACHE_MAX_BLOCK_SIZE must be a multiple of portBYTE_ALIGNMENT
+    #endif
+
+    #if ( ( configHEAP_CORE_CACHE_DEPTH < 1 ) || ( configHEAP_CORE_CACHE_DEPTH > 255 ) )
+        #error configHEAP_CORE_CACHE_DEPTH must be between 1 and 255
+    #endif
+#endif /* if ( configUSE_HEAP_CORE_CACHES == 1 ) */
+
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    #ifndef configHEAP_PLACEMENT_MAX_REGIONS
+        #define configHEAP_PLACEMENT_MAX_REGIONS    8
+    #endif
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        #error configUSE_HEAP_REGION_PLACEMENT cannot be used with configUSE_HEAP_CORE_CACHES as cached blocks are not placed
+    #endif
+#endif /* if ( configUSE_HEAP_REGION_PLACEMENT == 1 ) */
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -144,6 +189,19 @@
 
 #endif /* configENABLE_HEAP_PROTECTOR */
 
+/* Each region ends with an end marker, a block with a size of 0 that links to
+ * the first free block of the next region.  The end marker of the last region
+ * is pxEnd.  Free blocks are not merged with an end marker that follows them.
+ * Normally that is only pxEnd, as the other end markers do no harm if they are
+ * merged out of the list.  With region placement every end marker stays in the
+ * list, so the free blocks of a region are those between the end marker of the
+ * region below it and its own end marker. */
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    #define heapIS_END_MARKER( pxBlock )    ( ( pxBlock )->xBlockSize == ( size_t ) 0 )
+#else
+    #define heapIS_END_MARKER( pxBlock )    ( ( pxBlock ) == pxEnd )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Define the linked list structure.  This is used to link free blocks in order
@@ -154,6 +212,62 @@ typedef struct A_BLOCK_LINK
     size_t xBlockSize;                     /**< The size of the free block. */
 } BlockLink_t;
 
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+/* Small blocks are cached per size, and block sizes are always a multiple of
+ * portBYTE_ALIGNMENT, so there is one list of cached blocks for each multiple
+ * of portBYTE_ALIGNMENT up to configHEAP_CORE_CACHE_MAX_BLOCK_SIZE. */
+    #define heapCACHE_SIZE_CLASSES                ( configHEAP_CORE_CACHE_MAX_BLOCK_SIZE / portBYTE_ALIGNMENT )
+    #define heapCACHE_SIZE_CLASS( xBlockSize )    ( ( ( xBlockSize ) / ( size_t ) portBYTE_ALIGNMENT ) - ( size_t ) 1 )
+
+/* The number of blocks moved between a cache and the heap at a time. */
+    #define heapCACHE_BATCH_SIZE                  ( ( uint8_t ) ( ( configHEAP_CORE_CACHE_DEPTH + 1U ) / 2U ) )
+
+/* A core's cache is only ever accessed by the task running on that core, so it
+ * is protected by masking interrupts on that core rather than by suspending the
+ * scheduler, which on SMP takes a lock shared by all the cores. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #define heapENTER_CORE_CACHE()    uxSavedInterruptStatus = portSET_INTERRUPT_MASK()
+        #define heapEXIT_CORE_CACHE()     portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus )
+    #else
+        #define heapENTER_CORE_CACHE()    taskENTER_CRITICAL()
+        #define heapEXIT_CORE_CACHE()     taskEXIT_CRITICAL()
+    #endif
+
+/* Blocks held in a cache are not in the list of free blocks, but are marked as
+ * free so freeing a cached block again is caught by vPortFree().  They are
+ * linked together through their pxNextFreeBlock members. */
+    typedef struct A_CORE_CACHE
+    {
+        BlockLink_t * pxBlocks[ heapCACHE_SIZE_CLASSES ];   /**< The cached blocks of each size. */
+        uint8_t ucNumberOfBlocks[ heapCACHE_SIZE_CLASSES ]; /**< The number of blocks in each list. */
+        size_t xNumberOfAllocations;                        /**< The number of calls to pvPortMalloc() satisfied from the cache. */
+        size_t xNumberOfFrees;                              /**< The number of calls to vPortFree() that added a block to the cache. */
+    } CoreCache_t;
+
+#endif /* configUSE_HEAP_CORE_CACHES */
+
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+
+/* The regions passed to vPortDefineHeapRegions(), in address order. */
+    typedef struct A_HEAP_REGION
+    {
+        uint8_t * pucStartAddress;             /**< The start of the region, after alignment. */
+        BlockLink_t * pxEndMarker;             /**< The end marker at the top of the region. */
+        UBaseType_t uxTag;                     /**< The tag from the region's HeapRegion_t. */
+        size_t xNumberOfSuccessfulAllocations; /**< The number of blocks allocated from the region. */
+        size_t xNumberOfFallbackAllocations;   /**< The number of those blocks that were wanted in a region with another tag. */
+    } HeapRegionInfo_t;
+
+/* The list node that the free blocks of region xRegion follow. */
+    #define heapREGION_FIRST_NODE( xRegion )    ( ( ( xRegion ) == 0 ) ? &xStart : xHeapRegions[ ( xRegion ) - 1 ].pxEndMarker )
+
+/* The tag pvPortMalloc() allocates from first. */
+    #define heapDEFAULT_TAG()                   ( uxPlacementTags[ eHeapPlacementDefault ] )
+#else
+    #define heapDEFAULT_TAG()                   ( ( UBaseType_t ) 0U )
+#endif /* configUSE_HEAP_REGION_PLACEMENT */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -165,6 +279,102 @@ typedef struct A_BLOCK_LINK
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Takes a block of at least xWantedSize bytes out of the part of the list of
+ * free blocks that follows pxPreviousBlock and ends at pxLastBlock, splitting
+ * the block found if it is larger than needed.  Returns NULL if there is no
+ * block large enough.  prvAllocateBlock() searches the whole list.  Must be
+ * called with the scheduler suspended.
+ */
+static BlockLink_t * prvAllocateBlockInRange( BlockLink_t * pxPreviousBlock,
+                                              const BlockLink_t * pxLastBlock,
+                                              size_t xWantedSize ) PRIVILEGED_FUNCTION;
+#define prvAllocateBlock( xWantedSize )    prvAllocateBlockInRange( &xStart, pxEnd, ( xWantedSize ) )
+
+/*
+ * Takes a block of at least xWantedSize bytes from a region with the tag
+ * uxTag.  If xFallBack is pdTRUE and those regions have no block large enough
+ * then regions with slower tags, then regions with faster tags, are tried.
+ * Without region placement the tags are ignored.  Must be called with the
+ * scheduler suspended.
+ */
+static BlockLink_t * prvAllocatePlacedBlock( size_t xWantedSize,
+                                             UBaseType_t uxTag,
+                                             BaseType_t xFallBack ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementations of pvPortMalloc() and pvPortMallocAligned(), which
+ * allocate from the regions chosen by uxTag and xFallBack as described for
+ * prvAllocatePlacedBlock().
+ */
+static void * prvMalloc( size_t xWantedSize,
+                         UBaseType_t uxTag,
+                         BaseType_t xFallBack ) PRIVILEGED_FUNCTION;
+static void * prvMallocAligned( size_t xWantedSize,
+                                size_t xAlignment,
+                                UBaseType_t uxTag,
+                                BaseType_t xFallBack ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the size of the block needed to hold xWantedSize bytes, including the
+ * BlockLink_t structure and any padding needed for alignment.  Returns 0 if
+ * xWantedSize is 0 or if the block size would overflow.
+ */
+static size_t prvWantedBlockSize( size_t xWantedSize );
+
+/*
+ * Changes the size of the allocated block pxBlock to xNewBlockSize without
+ * moving it.  A block shrinks by splitting off its end, and grows by merging
+ * with the free block that follows it in memory.  Returns pdFALSE if that
+ * free block does not exist or is too small.  Must be called with the scheduler
+ * suspended.
+ */
+static BaseType_t prvResizeBlock( BlockLink_t * pxBlock,
+                                  size_t xNewBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Cuts a block of xBlockSize bytes, whose memory starts at a multiple of
+ * xAlignment, from the allocated block pxBlock.  The memory in front of and
+ * behind the returned block is returned to the list of free blocks.  pxBlock
+ * must be at least xBlockSize + xAlignment + heapMINIMUM_BLOCK_SIZE bytes.
+ * Must be called with the scheduler suspended.
+ */
+static BlockLink_t * prvAlignBlock( BlockLink_t * pxBlock,
+                                    size_t xBlockSize,
+                                    size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+/*
+ * Pop a block of exactly xWantedSize bytes from, or push a block onto, the
+ * calling core's cache without suspending the scheduler.  prvCacheAllocate()
+ * returns NULL if the cache holds no block of the wanted size.
+ * prvCacheFree() returns pdFALSE if the block is too large to be cached, and
+ * returns a batch of blocks to the heap if the cache is full.
+ */
+    static BlockLink_t * prvCacheAllocate( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvCacheFree( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move a batch of blocks of xWantedSize bytes from the heap into the calling
+ * core's cache, or move all the blocks in the calling core's cache back to the
+ * heap.  prvCacheFlush() returns pdTRUE if any blocks were moved.  Both must be
+ * called with the scheduler suspended.
+ */
+    static void prvCacheRefill( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvCacheFlush( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a list of blocks, already marked as free and linked through their
+ * pxNextFreeBlock members, to the heap.  Must be called with the scheduler
+ * suspended.
+ */
+    static void prvReturnBlocksToHeap( BlockLink_t * pxBlocks ) PRIVILEGED_FUNCTION;
+#else
+    #define prvCacheAllocate( xWantedSize )    NULL
+    #define prvCacheFree( pxBlock )            pdFALSE
+#endif /* configUSE_HEAP_CORE_CACHES */
+
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
 
 /**
@@ -192,6 +402,19 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+    PRIVILEGED_DATA static CoreCache_t xCoreCaches[ configNUMBER_OF_CORES ];
+#endif
+
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    PRIVILEGED_DATA static HeapRegionInfo_t xHeapRegions[ configHEAP_PLACEMENT_MAX_REGIONS ];
+    PRIVILEGED_DATA static BaseType_t xNumberOfHeapRegions = 0;
+    PRIVILEGED_DATA static UBaseType_t uxHighestRegionTag = 0U;
+
+/* The tag each type of memory is allocated from first. */
+    PRIVILEGED_DATA static UBaseType_t uxPlacementTags[ eHeapPlacementCount ];
+#endif
+
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
 
 /* Canary value for protecting internal heap pointers. */
@@ -206,160 +429,87 @@ PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvMalloc( xWantedSize, heapDEFAULT_TAG(), pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvMalloc( size_t xWantedSize,
+                         UBaseType_t uxTag,
+                         BaseType_t xFallBack ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxBlock;
-    BlockLink_t * pxPreviousBlock;
-    BlockLink_t * pxNewBlockLink;
     void * pvReturn = NULL;
-    size_t xAdditionalRequiredSize;
     size_t xAllocatedBlockSize = 0;
 
     /* The heap must be initialised before the first call to
      * pvPortMalloc(). */
     configASSERT( pxEnd );
 
-    if( xWantedSize > 0 )
+    xWantedSize = prvWantedBlockSize( xWantedSize );
+
+    /* Small blocks are taken from the calling core's cache, if it holds one,
+     * without suspending the scheduler. */
+    pxBlock = prvCacheAllocate( xWantedSize );
+
+    if( pxBlock == NULL )
     {
-        /* The wanted size must be increased so it can contain a BlockLink_t
-         * structure in addition to the requested amount of bytes. */
-        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        vTaskSuspendAll();
         {
-            xWantedSize += xHeapStructSize;
+            pxBlock = prvAllocatePlacedBlock( xWantedSize, uxTag, xFallBack );
 
-            /* Ensure that blocks are always aligned to the required number
-             * of bytes. */
-            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            #if ( configUSE_HEAP_CORE_CACHES == 1 )
             {
-                /* Byte alignment required. */
-                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
-
-                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                if( pxBlock != NULL )
                 {
-                    xWantedSize += xAdditionalRequiredSize;
+                    prvCacheRefill( xWantedSize );
+                }
+                else if( prvCacheFlush() != pdFALSE )
+                {
+                    /* Blocks held in this core's cache have been returned to
+                     * the heap, so there might now be a large enough block. */
+                    pxBlock = prvAllocateBlock( xWantedSize );
                 }
                 else
                 {
-                    xWantedSize = 0;
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #endif /* if ( configUSE_HEAP_CORE_CACHES == 1 ) */
+
+            if( pxBlock != NULL )
+            {
+                xNumberOfSuccessfulAllocations++;
+            }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            xWantedSize = 0;
-        }
+        ( void ) xTaskResumeAll();
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    vTaskSuspendAll();
+    if( pxBlock != NULL )
     {
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
-        {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
-            {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
-                heapVALIDATE_BLOCK_POINTER( pxBlock );
-
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
-                {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
-                    heapVALIDATE_BLOCK_POINTER( pxBlock );
-                }
-
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if( pxBlock != pxEnd )
-                {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = ( void * ) ( ( ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxPreviousBlock->pxNextFreeBlock ) ) + xHeapStructSize );
-                    heapVALIDATE_BLOCK_POINTER( pvReturn );
-
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
-
-                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-                    {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
-                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
-                    {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xAllocatedBlockSize = pxBlock->xBlockSize;
-
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK( pxBlock );
-                    pxBlock->pxNextFreeBlock = NULL;
-                    xNumberOfSuccessfulAllocations++;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        /* Return the memory space pointed to - jumping over the BlockLink_t
+         * structure at its start. */
+        pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+        heapVALIDATE_BLOCK_POINTER( pvReturn );
+        xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        traceMALLOC( pvReturn, xAllocatedBlockSize );
+    traceMALLOC( pvReturn, xAllocatedBlockSize );
 
-        /* Prevent compiler warnings when trace macros are not used. */
-        ( void ) xAllocatedBlockSize;
-    }
-    ( void ) xTaskResumeAll();
+    /* Prevent compiler warnings when trace macros are not used. */
+    ( void ) xAllocatedBlockSize;
 
     #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
     {
@@ -399,7 +549,9 @@ void vPortFree( void * pv )
 
         if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
         {
-            if( pxLink->pxNextFreeBlock == NULL )
+            /* Small blocks are kept in the calling core's cache, if there is
+             * one, rather than being returned to the heap. */
+            if( ( pxLink->pxNextFreeBlock == NULL ) && ( prvCacheFree( pxLink ) == pdFALSE ) )
             {
                 /* The block is being returned to the heap - it is no longer
                  * allocated. */
@@ -469,102 +621,700 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
-static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize )
 {
-    BlockLink_t * pxIterator;
-    uint8_t * puc;
-
-    /* Iterate through the list until a block is found that has a higher address
-     * than the block being inserted. */
-    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxBlockToInsert; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
-    {
-        /* Nothing to do here, just iterate to the right position. */
-    }
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    void * pvReturn = NULL;
+    size_t xBlockSize;
+    size_t xNewBlockSize;
+    size_t xBytesToCopy;
+    BaseType_t xResized = pdFALSE;
 
-    if( pxIterator != &xStart )
+    if( pv == NULL )
     {
-        heapVALIDATE_BLOCK_POINTER( pxIterator );
+        pvReturn = pvPortMalloc( xWantedSize );
     }
-
-    /* Do the block being inserted, and the block it is being inserted after
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxIterator;
-
-    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    else if( xWantedSize == 0 )
     {
-        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
-        pxBlockToInsert = pxIterator;
+        vPortFree( pv );
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
-    }
+        /* The memory being resized will have an BlockLink_t structure
+         * immediately before it. */
+        puc -= xHeapStructSize;
 
-    /* Do the block being inserted, and the block it is being inserted before
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxBlockToInsert;
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
 
-    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
-    {
-        if( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) != pxEnd )
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        xNewBlockSize = prvWantedBlockSize( xWantedSize );
+
+        if( ( xNewBlockSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xNewBlockSize ) != 0 ) )
         {
-            /* Form one big block from the two blocks. */
-            pxBlockToInsert->xBlockSize += heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock )->xBlockSize;
-            pxBlockToInsert->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock )->pxNextFreeBlock;
+            vTaskSuspendAll();
+            {
+                xResized = prvResizeBlock( pxLink, xNewBlockSize );
+            }
+            ( void ) xTaskResumeAll();
         }
         else
         {
-            pxBlockToInsert->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxEnd );
+            mtCOVERAGE_TEST_MARKER();
         }
-    }
-    else
-    {
-        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
-    }
 
-    /* If the block being inserted plugged a gap, so was merged with the block
-     * before and the block after, then it's pxNextFreeBlock pointer will have
-     * already been set, and should not be set here as that would make it point
-     * to itself. */
-    if( pxIterator != pxBlockToInsert )
-    {
-        pxIterator->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxBlockToInsert );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
+        if( xResized != pdFALSE )
+        {
+            traceFREE( pv, xBlockSize );
+            traceMALLOC( pv, pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+            pvReturn = pv;
+        }
+        else
+        {
+            /* The block cannot grow in place, so as a last resort move it to
+             * a new block.  The original block is left untouched if there is
+             * no memory for the new one. */
+            pvReturn = pvPortMalloc( xWantedSize );
+
+            if( pvReturn != NULL )
+            {
+                xBytesToCopy = xBlockSize - xHeapStructSize;
+
+                if( xBytesToCopy > xWantedSize )
+                {
+                    xBytesToCopy = xWantedSize;
+                }
+
+                ( void ) memcpy( pvReturn, pv, xBytesToCopy );
+                vPortFree( pv );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
     }
+
+    return pvReturn;
 }
 /*-----------------------------------------------------------*/
 
-void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+void * pvPortMallocAligned( size_t xWantedSize,
+                            size_t xAlignment )
 {
-    BlockLink_t * pxFirstFreeBlockInRegion = NULL;
-    BlockLink_t * pxPreviousFreeBlock;
-    portPOINTER_SIZE_TYPE xAlignedHeap;
-    size_t xTotalRegionSize, xTotalHeapSize = 0;
-    BaseType_t xDefinedRegions = 0;
-    portPOINTER_SIZE_TYPE xAddress;
-    const HeapRegion_t * pxHeapRegion;
+    return prvMallocAligned( xWantedSize, xAlignment, heapDEFAULT_TAG(), pdTRUE );
+}
+/*-----------------------------------------------------------*/
 
-    /* Can only call once! */
-    configASSERT( pxEnd == NULL );
+static void * prvMallocAligned( size_t xWantedSize,
+                                size_t xAlignment,
+                                UBaseType_t uxTag,
+                                BaseType_t xFallBack ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock = NULL;
+    void * pvReturn = NULL;
+    size_t xBlockSize;
+    size_t xSearchSize = 0;
+    size_t xMinimumEverFreeBytes;
+    size_t xAllocatedBlockSize = 0;
 
-    #if ( configENABLE_HEAP_PROTECTOR == 1 )
-    {
-        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
-    }
-    #endif
+    /* The heap must be initialised before the first call to
+     * pvPortMallocAligned(). */
+    configASSERT( pxEnd );
 
-    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    /* The alignment must be a power of two. */
+    configASSERT( ( xAlignment & ( xAlignment - 1U ) ) == 0U );
 
-    while( pxHeapRegion->xSizeInBytes > 0 )
+    if( xAlignment <= ( size_t ) portBYTE_ALIGNMENT )
     {
-        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
-
-        /* Ensure the heap region starts on a correctly aligned boundary. */
-        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
-
+        /* Every block is already aligned to portBYTE_ALIGNMENT. */
+        pvReturn = prvMalloc( xWantedSize, uxTag, xFallBack );
+    }
+    else
+    {
+        xBlockSize = prvWantedBlockSize( xWantedSize );
+
+        /* Search for a block that is large enough to have a block of
+         * xBlockSize bytes cut from it at an aligned address, with room for
+         * a free block in front of it. */
+        if( ( xBlockSize > 0 ) &&
+            ( heapADD_WILL_OVERFLOW( xAlignment, heapMINIMUM_BLOCK_SIZE ) == 0 ) &&
+            ( heapADD_WILL_OVERFLOW( xBlockSize, xAlignment + heapMINIMUM_BLOCK_SIZE ) == 0 ) )
+        {
+            xSearchSize = xBlockSize + xAlignment + heapMINIMUM_BLOCK_SIZE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        vTaskSuspendAll();
+        {
+            /* The search block is only held briefly, so should not count
+             * towards the minimum ever free bytes. */
+            xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+            pxBlock = prvAllocatePlacedBlock( xSearchSize, uxTag, xFallBack );
+
+            #if ( configUSE_HEAP_CORE_CACHES == 1 )
+            {
+                if( ( pxBlock == NULL ) && ( xSearchSize > 0 ) && ( prvCacheFlush() != pdFALSE ) )
+                {
+                    /* Blocks held in this core's cache have been returned to
+                     * the heap, so there might now be a large enough block. */
+                    pxBlock = prvAllocatePlacedBlock( xSearchSize, uxTag, xFallBack );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configUSE_HEAP_CORE_CACHES == 1 ) */
+
+            if( pxBlock != NULL )
+            {
+                pxBlock = prvAlignBlock( pxBlock, xBlockSize, xAlignment );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytes;
+
+            if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+            {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( pxBlock != NULL )
+        {
+            pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            heapVALIDATE_BLOCK_POINTER( pvReturn );
+            xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+        /* Prevent compiler warnings when trace macros are not used. */
+        ( void ) xAllocatedBlockSize;
+
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+        configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1U ) ) == 0 );
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocateBlockInRange( BlockLink_t * pxPreviousBlock,
+                                              const BlockLink_t * pxLastBlock,
+                                              size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxReturn = NULL;
+
+    /* Check the block size we are trying to allocate is not so large that the
+     * top bit is set.  The top bit of the block size member of the BlockLink_t
+     * structure is used to determine who owns the block - the application or
+     * the kernel, so it must be free. */
+    if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+    {
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            /* Traverse the list from the start (lowest address) block until
+             * one of adequate size is found. */
+            pxBlock = heapPROTECT_BLOCK_POINTER( pxPreviousBlock->pxNextFreeBlock );
+
+            /* pxLastBlock is an end marker, which can lie at the very top of
+             * the heap, so is not validated. */
+            while( pxBlock != pxLastBlock )
+            {
+                heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                if( pxBlock->xBlockSize >= xWantedSize )
+                {
+                    break;
+                }
+
+                pxPreviousBlock = pxBlock;
+                pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+            }
+
+            /* If the end marker was reached then a block of adequate size
+             * was not found. */
+            if( pxBlock != pxLastBlock )
+            {
+                /* This block is being returned for use so must be taken out
+                 * of the list of free blocks. */
+                pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+
+                if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                    pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application and has no "next" block. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pxBlock->pxNextFreeBlock = NULL;
+                pxReturn = pxBlock;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocatePlacedBlock( size_t xWantedSize,
+                                             UBaseType_t uxTag,
+                                             BaseType_t xFallBack ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock = NULL;
+
+    #if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    {
+        BaseType_t xRegion;
+        UBaseType_t uxTryTag = uxTag;
+
+        if( ( xFallBack != pdFALSE ) && ( uxTryTag > uxHighestRegionTag ) )
+        {
+            /* There is nothing slower, so start with the slowest regions. */
+            uxTryTag = uxHighestRegionTag;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ; ; )
+        {
+            for( xRegion = 0; ( pxBlock == NULL ) && ( xRegion < xNumberOfHeapRegions ); xRegion++ )
+            {
+                if( xHeapRegions[ xRegion ].uxTag == uxTryTag )
+                {
+                    pxBlock = prvAllocateBlockInRange( heapREGION_FIRST_NODE( xRegion ), xHeapRegions[ xRegion ].pxEndMarker, xWantedSize );
+
+                    if( pxBlock != NULL )
+                    {
+                        xHeapRegions[ xRegion ].xNumberOfSuccessfulAllocations++;
+
+                        if( uxTryTag != uxTag )
+                        {
+                            xHeapRegions[ xRegion ].xNumberOfFallbackAllocations++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( ( pxBlock != NULL ) || ( xFallBack == pdFALSE ) )
+            {
+                break;
+            }
+
+            /* Move on to the next slower tag, then once the slowest tag has
+             * been tried back through the faster tags. */
+            if( ( uxTryTag >= uxTag ) && ( uxTryTag < uxHighestRegionTag ) )
+            {
+                uxTryTag++;
+            }
+            else if( ( uxTryTag >= uxTag ) && ( uxTag > 0U ) )
+            {
+                uxTryTag = ( UBaseType_t ) ( uxTag - 1U );
+            }
+            else if( ( uxTryTag < uxTag ) && ( uxTryTag > 0U ) )
+            {
+                uxTryTag--;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    #else /* if ( configUSE_HEAP_REGION_PLACEMENT == 1 ) */
+    {
+        /* Prevent compiler warnings as the tags are not used. */
+        ( void ) uxTag;
+        ( void ) xFallBack;
+
+        pxBlock = prvAllocateBlock( xWantedSize );
+    }
+    #endif /* if ( configUSE_HEAP_REGION_PLACEMENT == 1 ) */
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWantedBlockSize( size_t xWantedSize )
+{
+    size_t xAdditionalRequiredSize;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvResizeBlock( BlockLink_t * pxBlock,
+                                  size_t xNewBlockSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNextBlock;
+    BlockLink_t * pxNewBlockLink;
+    size_t xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+    BaseType_t xReturn = pdTRUE;
+
+    if( xNewBlockSize > xBlockSize )
+    {
+        /* The list of free blocks is in address order, so the first free block
+         * above pxBlock is the only one that can follow it in memory.  The end
+         * marker is always above pxBlock so the search terminates. */
+        pxPreviousBlock = &xStart;
+        pxNextBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+        heapVALIDATE_BLOCK_POINTER( pxNextBlock );
+
+        while( pxNextBlock < pxBlock )
+        {
+            pxPreviousBlock = pxNextBlock;
+            pxNextBlock = heapPROTECT_BLOCK_POINTER( pxNextBlock->pxNextFreeBlock );
+            heapVALIDATE_BLOCK_POINTER( pxNextBlock );
+        }
+
+        /* End markers have a size of 0, so are never merged into pxBlock as
+         * they can never make it large enough. */
+        if( ( ( ( uint8_t * ) pxBlock ) + xBlockSize == ( uint8_t * ) pxNextBlock ) &&
+            ( ( xNewBlockSize - xBlockSize ) <= pxNextBlock->xBlockSize ) )
+        {
+            /* Take the following free block out of the list of free blocks
+             * and add it to the end of pxBlock. */
+            pxPreviousBlock->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+            xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+            xBlockSize += pxNextBlock->xBlockSize;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn != pdFALSE )
+    {
+        /* If the block is now larger than required it can be split into two,
+         * with the end returned to the list of free blocks. */
+        if( ( xBlockSize - xNewBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+        {
+            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xNewBlockSize );
+            configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( pxNewBlockLink, 0, xBlockSize - xNewBlockSize );
+            }
+            #endif
+
+            pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+            xBlockSize = xNewBlockSize;
+            xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+            prvInsertBlockIntoFreeList( pxNewBlockLink );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+        {
+            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxBlock->xBlockSize = xBlockSize;
+        heapALLOCATE_BLOCK( pxBlock );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAlignBlock( BlockLink_t * pxBlock,
+                                    size_t xBlockSize,
+                                    size_t xAlignment ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxAlignedBlock;
+    size_t xAddress;
+    size_t xLeadingBytes;
+
+    /* Find the number of bytes to skip so the memory after the BlockLink_t
+     * structure is aligned.  Any bytes skipped must form a valid free block. */
+    xAddress = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pxBlock ) + xHeapStructSize;
+    xLeadingBytes = ( xAlignment - ( xAddress & ( xAlignment - 1U ) ) ) & ( xAlignment - 1U );
+
+    while( ( xLeadingBytes > 0U ) && ( xLeadingBytes < heapMINIMUM_BLOCK_SIZE ) )
+    {
+        xLeadingBytes += xAlignment;
+    }
+
+    configASSERT( ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) >= ( xLeadingBytes + xBlockSize ) );
+
+    if( xLeadingBytes > 0U )
+    {
+        /* Move the start of the block forward and return the memory skipped
+         * to the list of free blocks. */
+        pxAlignedBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingBytes );
+        pxAlignedBlock->xBlockSize = ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) - xLeadingBytes;
+        pxAlignedBlock->pxNextFreeBlock = NULL;
+        heapALLOCATE_BLOCK( pxAlignedBlock );
+
+        pxBlock->xBlockSize = xLeadingBytes;
+        xFreeBytesRemaining += xLeadingBytes;
+        prvInsertBlockIntoFreeList( pxBlock );
+        pxBlock = pxAlignedBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Return the memory beyond xBlockSize to the list of free blocks.  A block
+     * can always shrink in place. */
+    ( void ) prvResizeBlock( pxBlock, xBlockSize );
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxBlockToInsert; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    if( pxIterator != &xStart )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxIterator );
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+    {
+        if( heapIS_END_MARKER( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) ) == 0 )
+        {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock )->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock )->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gap, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxBlockToInsert );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlockInRegion = NULL;
+    BlockLink_t * pxPreviousFreeBlock;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( pxEnd == NULL );
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    {
+        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
+    }
+    #endif
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
         if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
         {
             xAddress += ( portBYTE_ALIGNMENT - 1 );
@@ -633,6 +1383,37 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVI
 
         xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
 
+        #if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+        {
+            /* Regions that do not fit in xHeapRegions are never allocated
+             * from. */
+            configASSERT( xDefinedRegions < ( BaseType_t ) configHEAP_PLACEMENT_MAX_REGIONS );
+
+            if( xDefinedRegions < ( BaseType_t ) configHEAP_PLACEMENT_MAX_REGIONS )
+            {
+                xHeapRegions[ xDefinedRegions ].pucStartAddress = ( uint8_t * ) xAlignedHeap;
+                xHeapRegions[ xDefinedRegions ].pxEndMarker = pxEnd;
+                xHeapRegions[ xDefinedRegions ].uxTag = pxHeapRegion->uxTag;
+                xHeapRegions[ xDefinedRegions ].xNumberOfSuccessfulAllocations = 0U;
+                xHeapRegions[ xDefinedRegions ].xNumberOfFallbackAllocations = 0U;
+                xNumberOfHeapRegions = xDefinedRegions + 1;
+
+                if( pxHeapRegion->uxTag > uxHighestRegionTag )
+                {
+                    uxHighestRegionTag = pxHeapRegion->uxTag;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_HEAP_REGION_PLACEMENT == 1 ) */
+
         #if ( configENABLE_HEAP_PROTECTOR == 1 )
         {
             if( ( pucHeapHighAddress == NULL ) ||
@@ -656,11 +1437,240 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVI
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+    static BlockLink_t * prvCacheAllocate( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock = NULL;
+        CoreCache_t * pxCache;
+        size_t xSizeClass;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= configHEAP_CORE_CACHE_MAX_BLOCK_SIZE ) )
+        {
+            xSizeClass = heapCACHE_SIZE_CLASS( xWantedSize );
+
+            heapENTER_CORE_CACHE();
+            {
+                pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+                pxBlock = pxCache->pxBlocks[ xSizeClass ];
+
+                if( pxBlock != NULL )
+                {
+                    pxCache->pxBlocks[ xSizeClass ] = pxBlock->pxNextFreeBlock;
+                    pxCache->ucNumberOfBlocks[ xSizeClass ]--;
+                    pxCache->xNumberOfAllocations++;
+
+                    /* Allocated blocks have no "next" block. */
+                    heapALLOCATE_BLOCK( pxBlock );
+                    pxBlock->pxNextFreeBlock = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            heapEXIT_CORE_CACHE();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCacheFree( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBatch = NULL;
+        BlockLink_t * pxLastInBatch;
+        CoreCache_t * pxCache;
+        const size_t xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        size_t xSizeClass;
+        uint8_t ucBlock;
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        if( xBlockSize <= configHEAP_CORE_CACHE_MAX_BLOCK_SIZE )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( ( ( uint8_t * ) pxBlock ) + xHeapStructSize, 0, xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            xSizeClass = heapCACHE_SIZE_CLASS( xBlockSize );
+
+            heapENTER_CORE_CACHE();
+            {
+                pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+                if( pxCache->ucNumberOfBlocks[ xSizeClass ] >= ( uint8_t ) configHEAP_CORE_CACHE_DEPTH )
+                {
+                    /* The cache is full, so take a batch of blocks off the
+                     * front of the list to return to the heap. */
+                    pxBatch = pxCache->pxBlocks[ xSizeClass ];
+                    pxLastInBatch = pxBatch;
+
+                    for( ucBlock = 1U; ucBlock < heapCACHE_BATCH_SIZE; ucBlock++ )
+                    {
+                        pxLastInBatch = pxLastInBatch->pxNextFreeBlock;
+                    }
+
+                    pxCache->pxBlocks[ xSizeClass ] = pxLastInBatch->pxNextFreeBlock;
+                    pxLastInBatch->pxNextFreeBlock = NULL;
+                    pxCache->ucNumberOfBlocks[ xSizeClass ] -= heapCACHE_BATCH_SIZE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapFREE_BLOCK( pxBlock );
+                pxBlock->pxNextFreeBlock = pxCache->pxBlocks[ xSizeClass ];
+                pxCache->pxBlocks[ xSizeClass ] = pxBlock;
+                pxCache->ucNumberOfBlocks[ xSizeClass ]++;
+                pxCache->xNumberOfFrees++;
+            }
+            heapEXIT_CORE_CACHE();
+
+            if( pxBatch != NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    prvReturnBlocksToHeap( pxBatch );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCacheRefill( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        CoreCache_t * pxCache;
+        size_t xBlockSize, xSizeClass;
+        uint8_t ucBlock;
+
+        /* The scheduler is suspended so the calling task cannot move to another
+         * core, and only tasks running on this core access its cache. */
+        pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+        if( xWantedSize <= configHEAP_CORE_CACHE_MAX_BLOCK_SIZE )
+        {
+            /* The block already allocated for the caller counts as the first
+             * block of the batch. */
+            for( ucBlock = 1U; ucBlock < heapCACHE_BATCH_SIZE; ucBlock++ )
+            {
+                pxBlock = prvAllocateBlock( xWantedSize );
+
+                if( pxBlock == NULL )
+                {
+                    break;
+                }
+
+                /* The block can be larger than wanted if it was not worth
+                 * splitting, in which case it belongs in a different list. */
+                heapFREE_BLOCK( pxBlock );
+                xBlockSize = pxBlock->xBlockSize;
+                xSizeClass = heapCACHE_SIZE_CLASS( xBlockSize );
+
+                if( ( xBlockSize <= configHEAP_CORE_CACHE_MAX_BLOCK_SIZE ) && ( pxCache->ucNumberOfBlocks[ xSizeClass ] < ( uint8_t ) configHEAP_CORE_CACHE_DEPTH ) )
+                {
+                    pxBlock->pxNextFreeBlock = pxCache->pxBlocks[ xSizeClass ];
+                    pxCache->pxBlocks[ xSizeClass ] = pxBlock;
+                    pxCache->ucNumberOfBlocks[ xSizeClass ]++;
+                }
+                else
+                {
+                    prvReturnBlocksToHeap( pxBlock );
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCacheFlush( void ) /* PRIVILEGED_FUNCTION */
+    {
+        CoreCache_t * pxCache;
+        size_t xSizeClass;
+        BaseType_t xReturn = pdFALSE;
+
+        /* The scheduler is suspended so the calling task cannot move to another
+         * core, and only tasks running on this core access its cache. */
+        pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+        for( xSizeClass = 0; xSizeClass < heapCACHE_SIZE_CLASSES; xSizeClass++ )
+        {
+            if( pxCache->pxBlocks[ xSizeClass ] != NULL )
+            {
+                prvReturnBlocksToHeap( pxCache->pxBlocks[ xSizeClass ] );
+                pxCache->pxBlocks[ xSizeClass ] = NULL;
+                pxCache->ucNumberOfBlocks[ xSizeClass ] = 0U;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReturnBlocksToHeap( BlockLink_t * pxBlocks ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNextBlock;
+
+        while( pxBlocks != NULL )
+        {
+            pxNextBlock = pxBlocks->pxNextFreeBlock;
+
+            /* Blocks are marked as free when they enter a cache. */
+            xFreeBytesRemaining += pxBlocks->xBlockSize;
+            prvInsertBlockIntoFreeList( pxBlocks );
+
+            pxBlocks = pxNextBlock;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_CORE_CACHES */
+
 void vPortGetHeapStats( HeapStats_t * pxHeapStats )
 {
     BlockLink_t * pxBlock;
     size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
 
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        BaseType_t xCore;
+    #endif
+
     vTaskSuspendAll();
     {
         pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
@@ -709,11 +1719,108 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            /* Count the calls satisfied by the per core caches too.  Blocks
+             * held in the caches are not included in the free space. */
+            for( xCore = 0; xCore < ( BaseType_t ) configNUMBER_OF_CORES; xCore++ )
+            {
+                pxHeapStats->xNumberOfSuccessfulAllocations += xCoreCaches[ xCore ].xNumberOfAllocations;
+                pxHeapStats->xNumberOfSuccessfulFrees += xCoreCaches[ xCore ].xNumberOfFrees;
+            }
+        }
+        #endif
     }
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+
+    void * pvPortMallocPlaced( eHeapPlacement ePlacement,
+                               size_t xWantedSize,
+                               size_t xAlignment ) /* PRIVILEGED_FUNCTION */
+    {
+        configASSERT( ePlacement < eHeapPlacementCount );
+
+        return prvMallocAligned( xWantedSize, xAlignment, uxPlacementTags[ ePlacement ], pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPortMallocFromRegion( size_t xWantedSize,
+                                   UBaseType_t uxTag ) /* PRIVILEGED_FUNCTION */
+    {
+        return prvMalloc( xWantedSize, uxTag, pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSetHeapPlacement( eHeapPlacement ePlacement,
+                                UBaseType_t uxTag ) /* PRIVILEGED_FUNCTION */
+    {
+        configASSERT( ePlacement < eHeapPlacementCount );
+
+        uxPlacementTags[ ePlacement ] = uxTag;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortGetHeapRegionStats( UBaseType_t uxRegion,
+                                        HeapRegionStats_t * pxRegionStats )
+    {
+        BlockLink_t * pxBlock;
+        HeapRegionInfo_t * pxRegion;
+        size_t xBytes = 0, xBlocks = 0, xMaxSize = 0;
+        BaseType_t xReturn = pdFAIL;
+
+        vTaskSuspendAll();
+        {
+            if( uxRegion < ( UBaseType_t ) xNumberOfHeapRegions )
+            {
+                pxRegion = &( xHeapRegions[ uxRegion ] );
+
+                /* The free blocks of the region follow the end marker of the
+                 * region below it. */
+                pxBlock = heapPROTECT_BLOCK_POINTER( heapREGION_FIRST_NODE( ( BaseType_t ) uxRegion )->pxNextFreeBlock );
+
+                while( pxBlock != pxRegion->pxEndMarker )
+                {
+                    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                    xBlocks++;
+                    xBytes += pxBlock->xBlockSize;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                }
+
+                pxRegionStats->pucStartAddress = pxRegion->pucStartAddress;
+                pxRegionStats->xSizeInBytes = ( size_t ) ( ( ( uint8_t * ) pxRegion->pxEndMarker ) - pxRegion->pucStartAddress ) + xHeapStructSize;
+                pxRegionStats->uxTag = pxRegion->uxTag;
+                pxRegionStats->xAvailableBytes = xBytes;
+                pxRegionStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+                pxRegionStats->xNumberOfFreeBlocks = xBlocks;
+                pxRegionStats->xNumberOfSuccessfulAllocations = pxRegion->xNumberOfSuccessfulAllocations;
+                pxRegionStats->xNumberOfFallbackAllocations = pxRegion->xNumberOfFallbackAllocations;
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_REGION_PLACEMENT */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -732,5 +1839,19 @@ void vPortHeapResetState( void )
         pucHeapHighAddress = NULL;
         pucHeapLowAddress = NULL;
     #endif /* #if ( configENABLE_HEAP_PROTECTOR == 1 ) */
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+    {
+        ( void ) memset( xCoreCaches, 0, sizeof( xCoreCaches ) );
+    }
+    #endif
+
+    #if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    {
+        xNumberOfHeapRegions = 0;
+        uxHighestRegionTag = 0U;
+        ( void ) memset( uxPlacementTags, 0, sizeof( uxPlacementTags ) );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,843 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so both allocating and freeing memory
+ * take a bounded amount of time that does not depend on the number of blocks
+ * in the heap.  Like heap_5.c the heap can span multiple non-contiguous memory
+ * regions, and adjacent free blocks are combined (coalesced) as they are freed.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Free blocks are held in an array of lists.  The first level of the array
+ * divides block sizes into powers of two, and the second level divides each
+ * power of two range linearly into 2^configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+ * ranges.  A bitmap records which lists are not empty, so a list that holds a
+ * large enough block is found with a couple of bit scans rather than by
+ * walking a list of free blocks.  Each block also records the block that
+ * precedes it in memory, so a freed block is merged with its neighbours
+ * without walking a list either.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as when heap_5.c is used.  See heap_5.c for a description of the HeapRegion_t
+ * array passed to vPortDefineHeapRegions().  Unlike heap_5.c the regions do not
+ * need to be in address order.
+ *
+ * The largest block that can be allocated is 2^configHEAP_TLSF_FL_INDEX_MAX
+ * bytes less the block overhead.  Any part of a region beyond that size is not
+ * used.  The RAM used to hold the lists grows with configHEAP_TLSF_FL_INDEX_MAX
+ * and configHEAP_TLSF_SL_INDEX_COUNT_LOG2, so set configHEAP_TLSF_FL_INDEX_MAX
+ * no larger than needed for the size of the heap.
+ *
+ * Allocations are rounded up to the next second level boundary before the
+ * search, which is what makes the search constant time, so heap_6.c can fail to
+ * allocate a block that is only slightly smaller than the largest free block.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This file implements pvPortMalloc() and vPortFree(), so they must not be
+ * mapped onto the profiled versions in heap_profiler.c. */
+#define HEAP_IMPLEMENTATION_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+    #error heap_6.c does not support configENABLE_HEAP_PROTECTOR
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Log2 of the number of second level lists per power of two block size. */
+#ifndef configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+    #define configHEAP_TLSF_SL_INDEX_COUNT_LOG2    4
+#endif
+
+/* Blocks must be smaller than 2^configHEAP_TLSF_FL_INDEX_MAX bytes. */
+#ifndef configHEAP_TLSF_FL_INDEX_MAX
+    #define configHEAP_TLSF_FL_INDEX_MAX    24
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )     ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )          ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockHeader_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockHeader_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE( pxBlock )              ( ( pxBlock )->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )      ( ( ( pxBlock )->xBlockSize & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )          ( ( pxBlock )->xBlockSize |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )              ( ( pxBlock )->xBlockSize &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )     ( ( BlockHeader_t * ) ( ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) ) )
+
+/* Log2 of portBYTE_ALIGNMENT. */
+#if ( portBYTE_ALIGNMENT == 64 )
+    #define heapBYTE_ALIGNMENT_LOG2    6
+#elif ( portBYTE_ALIGNMENT == 32 )
+    #define heapBYTE_ALIGNMENT_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapBYTE_ALIGNMENT_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapBYTE_ALIGNMENT_LOG2    3
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapBYTE_ALIGNMENT_LOG2    2
+#elif ( portBYTE_ALIGNMENT == 2 )
+    #define heapBYTE_ALIGNMENT_LOG2    1
+#else
+    #define heapBYTE_ALIGNMENT_LOG2    0
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all share first level list 0, which
+ * is divided linearly into second level lists portBYTE_ALIGNMENT bytes apart.
+ * Larger blocks use first level list ( log2( size ) - heapFL_INDEX_SHIFT + 1 ). */
+#define heapSL_INDEX_COUNT       ( 1U << configHEAP_TLSF_SL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT       ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 + heapBYTE_ALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT       ( configHEAP_TLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE     ( ( ( size_t ) 1 ) << heapFL_INDEX_SHIFT )
+#define heapMAXIMUM_BLOCK_SIZE   ( ( ( size_t ) 1 ) << configHEAP_TLSF_FL_INDEX_MAX )
+
+#if ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 > 5 )
+    #error configHEAP_TLSF_SL_INDEX_COUNT_LOG2 must not be greater than 5
+#endif
+
+#if ( heapFL_INDEX_COUNT > 31 )
+    #error configHEAP_TLSF_FL_INDEX_MAX is too large - there can be at most 31 first level lists
+#endif
+
+#if ( heapFL_INDEX_COUNT < 1 )
+    #error configHEAP_TLSF_FL_INDEX_MAX is too small for the value of configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( sizeof( BlockHeader_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*-----------------------------------------------------------*/
+
+/* The header at the start of every block.  Only the first two members are
+ * present in an allocated block - the free list links occupy what is the
+ * application's memory when the block is allocated. */
+typedef struct A_BLOCK_HEADER
+{
+    struct A_BLOCK_HEADER * pxPreviousPhysicalBlock; /**< The block that precedes this one in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                               /**< The size of the block, including this header.  The MSB is set while the block is allocated. */
+    struct A_BLOCK_HEADER * pxNextFreeBlock;         /**< The next block in the same free list.  Only valid while the block is free. */
+    struct A_BLOCK_HEADER * pxPreviousFreeBlock;     /**< The previous block in the same free list.  Only valid while the block is free. */
+} BlockHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the most significant bit set in xValue, which must not
+ * be zero.
+ */
+static UBaseType_t prvFindLastSet( size_t xValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Calculates the first and second level list indexes of the list that holds
+ * free blocks of xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Finds, and removes from its free list, a free block of at least xWantedSize
+ * bytes.  Returns NULL if there is no such block.
+ */
+static BlockHeader_t * prvRemoveSuitableBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or remove a free block from, the list for its size.
+ */
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of BlockHeader_t that is placed at the beginning of each
+ * allocated memory block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( ( sizeof( BlockHeader_t * ) + sizeof( size_t ) ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The lists of free blocks, and bitmaps of which lists are not empty. */
+PRIVILEGED_DATA static BlockHeader_t * pxFreeBlocks[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFLBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+/* Set once vPortDefineHeapRegions() has been called. */
+PRIVILEGED_DATA static BaseType_t xHeapRegionsDefined = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockHeader_t * pxBlock;
+    BlockHeader_t * pxNewBlock;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    size_t xAllocatedBlockSize = 0;
+
+    /* The heap must be initialised before the first call to
+     * pvPortMalloc(). */
+    configASSERT( xHeapRegionsDefined != pdFALSE );
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockHeader_t
+         * structure in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A free block must be able to hold the free list links. */
+            if( ( xWantedSize != 0 ) && ( xWantedSize < heapMINIMUM_BLOCK_SIZE ) )
+            {
+                xWantedSize = heapMINIMUM_BLOCK_SIZE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* Blocks can never be as large as heapMAXIMUM_BLOCK_SIZE, which also
+         * guarantees the top bit of the size is clear. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAXIMUM_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvRemoveSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* Return the memory space pointed to - jumping over the
+                 * BlockHeader_t structure at its start. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block, and link the new block to its physical
+                     * neighbours. */
+                    pxNewBlock->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xWantedSize;
+                    pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlock )->pxPreviousPhysicalBlock = pxNewBlock;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    prvInsertFreeBlock( pxNewBlock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xAllocatedBlockSize = pxBlock->xBlockSize;
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application. */
+                heapALLOCATE_BLOCK( pxBlock );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+        /* Prevent compiler warnings when trace macros are not used. */
+        ( void ) xAllocatedBlockSize;
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockHeader_t * pxBlock;
+    BlockHeader_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockHeader_t structure
+         * immediately before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxBlock = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxBlock ) );
+
+        if( heapBLOCK_IS_ALLOCATED( pxBlock ) )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxBlock );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxBlock->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxBlock->xBlockSize;
+                traceFREE( pv, pxBlock->xBlockSize );
+
+                /* Merge with the block before this one in memory, if it is
+                 * free. */
+                pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == pdFALSE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+                    pxBlock = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block after this one in memory, if it is
+                 * free.  The marker at the end of each region is always
+                 * allocated, so is never merged. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == pdFALSE )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( size_t xValue ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxBit = 0U;
+    UBaseType_t uxShift;
+
+    /* A binary search, so the number of steps only depends on the width of
+     * size_t. */
+    for( uxShift = ( UBaseType_t ) ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1 ); uxShift > 0U; uxShift >>= 1 )
+    {
+        if( ( xValue >> uxShift ) != ( size_t ) 0 )
+        {
+            xValue >>= uxShift;
+            uxBit += uxShift;
+        }
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxLastSet;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        *puxFLIndex = 0U;
+        *puxSLIndex = ( UBaseType_t ) ( xBlockSize >> heapBYTE_ALIGNMENT_LOG2 );
+    }
+    else
+    {
+        uxLastSet = prvFindLastSet( xBlockSize );
+
+        /* The second level index is the configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+         * bits below the most significant bit. */
+        *puxSLIndex = ( UBaseType_t ) ( ( xBlockSize >> ( uxLastSet - configHEAP_TLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+        *puxFLIndex = uxLastSet - ( UBaseType_t ) ( heapFL_INDEX_SHIFT - 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t * prvRemoveSuitableBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockHeader_t * pxBlock = NULL;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    uint32_t ulMap;
+
+    /* Round the size up to the start of the next second level range, so any
+     * block in the list found is large enough without having to search it. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( ( size_t ) 1 ) << ( prvFindLastSet( xWantedSize ) - configHEAP_TLSF_SL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xWantedSize, &uxFLIndex, &uxSLIndex );
+
+    if( uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT )
+    {
+        /* First look for a list in the same first level range holding blocks
+         * at least as large, then for the smallest non-empty larger first
+         * level range. */
+        ulMap = ulSLBitmap[ uxFLIndex ] & ( ~( ( uint32_t ) 0U ) << uxSLIndex );
+
+        if( ulMap == 0U )
+        {
+            ulMap = ulFLBitmap & ( ~( ( uint32_t ) 0U ) << ( uxFLIndex + 1U ) );
+
+            if( ulMap != 0U )
+            {
+                uxFLIndex = prvFindLastSet( ( size_t ) ( ulMap & ( ~ulMap + 1U ) ) );
+                ulMap = ulSLBitmap[ uxFLIndex ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulMap != 0U )
+        {
+            uxSLIndex = prvFindLastSet( ( size_t ) ( ulMap & ( ~ulMap + 1U ) ) );
+            pxBlock = pxFreeBlocks[ uxFLIndex ][ uxSLIndex ];
+            configASSERT( pxBlock != NULL );
+            prvRemoveFreeBlock( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+    pxBlock->pxPreviousFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeBlocks[ uxFLIndex ][ uxSLIndex ];
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeBlocks[ uxFLIndex ][ uxSLIndex ] = pxBlock;
+    ulFLBitmap |= ( ( ( uint32_t ) 1U ) << uxFLIndex );
+    ulSLBitmap[ uxFLIndex ] |= ( ( ( uint32_t ) 1U ) << uxSLIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPreviousFreeBlock != NULL )
+    {
+        pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was at the head of its list. */
+        configASSERT( pxFreeBlocks[ uxFLIndex ][ uxSLIndex ] == pxBlock );
+        pxFreeBlocks[ uxFLIndex ][ uxSLIndex ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSLBitmap[ uxFLIndex ] &= ~( ( ( uint32_t ) 1U ) << uxSLIndex );
+
+            if( ulSLBitmap[ uxFLIndex ] == 0U )
+            {
+                ulFLBitmap &= ~( ( ( uint32_t ) 1U ) << uxFLIndex );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    BlockHeader_t * pxFirstFreeBlockInRegion;
+    BlockHeader_t * pxEndMarker;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress, xAlignedHeap;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapRegionsDefined == pdFALSE );
+
+    /* The top bit of a block's size marks the block as allocated, so blocks
+     * must always be smaller than that. */
+    configASSERT( ( size_t ) configHEAP_TLSF_FL_INDEX_MAX < ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1U ) );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* The end of the region holds a marker that is permanently allocated,
+         * so the last real block in the region is never merged with whatever
+         * follows the region in memory. */
+        xAddress = xAlignedHeap + ( portPOINTER_SIZE_TYPE ) xTotalRegionSize;
+        xAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        /* Blocks must be smaller than heapMAXIMUM_BLOCK_SIZE, so any part of
+         * a larger region is not used. */
+        if( ( size_t ) ( xAddress - xAlignedHeap ) >= heapMAXIMUM_BLOCK_SIZE )
+        {
+            xAddress = xAlignedHeap + ( portPOINTER_SIZE_TYPE ) ( heapMAXIMUM_BLOCK_SIZE - portBYTE_ALIGNMENT );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( size_t ) ( xAddress - xAlignedHeap ) >= heapMINIMUM_BLOCK_SIZE )
+        {
+            /* To start with there is a single free block in this region that is
+             * sized to take up the entire heap region minus the space taken by
+             * the end marker. */
+            pxFirstFreeBlockInRegion = ( BlockHeader_t * ) xAlignedHeap;
+            pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - xAlignedHeap );
+            pxFirstFreeBlockInRegion->pxPreviousPhysicalBlock = NULL;
+
+            pxEndMarker = ( BlockHeader_t * ) xAddress;
+            pxEndMarker->xBlockSize = 0;
+            heapALLOCATE_BLOCK( pxEndMarker );
+            pxEndMarker->pxPreviousPhysicalBlock = pxFirstFreeBlockInRegion;
+
+            prvInsertFreeBlock( pxFirstFreeBlockInRegion );
+
+            xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapRegionsDefined = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockHeader_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    vTaskSuspendAll();
+    {
+        /* Only the lists whose bits are set hold any blocks. */
+        for( uxFLIndex = 0U; uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFLIndex++ )
+        {
+            for( uxSLIndex = 0U; ( uxSLIndex < heapSL_INDEX_COUNT ) && ( ( ulSLBitmap[ uxFLIndex ] >> uxSLIndex ) != 0U ); uxSLIndex++ )
+            {
+                for( pxBlock = pxFreeBlocks[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    for( uxFLIndex = 0U; uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFLIndex++ )
+    {
+        for( uxSLIndex = 0U; uxSLIndex < heapSL_INDEX_COUNT; uxSLIndex++ )
+        {
+            pxFreeBlocks[ uxFLIndex ][ uxSLIndex ] = NULL;
+        }
+
+        ulSLBitmap[ uxFLIndex ] = 0U;
+    }
+
+    ulFLBitmap = 0U;
+    xHeapRegionsDefined = pdFALSE;
+
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,875 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A profiling layer that sits in front of whichever heap implementation is
+ * used, so it can be used with any of heap_1.c to heap_6.c or with an
+ * application supplied heap.  The file compiles to nothing unless
+ * configUSE_HEAP_PROFILER is set to 1 in FreeRTOSConfig.h.  See heap_profiler.h
+ * for the API and the data that is recorded.
+ *
+ * Each allocation is made portBYTE_ALIGNMENT aligned header bytes larger than
+ * requested.  The header records the requested size, where the block allocated
+ * from the heap starts, and the call site and task table entries the
+ * allocation was counted against, so vPortFreeProfiled() can reverse the
+ * counts without searching.  The profiler's own data is protected
+ * by a critical section, and the time spent in the critical section is bounded
+ * by the number of table entries probed, which is at most profilerMAX_PROBES.
+ *
+ * The following can be defined in FreeRTOSConfig.h to tailor the profiler:
+ *
+ * configHEAP_PROFILER_GET_TIME() returns the time used for the latency
+ * histogram.  It defaults to the run time stats counter when
+ * configGENERATE_RUN_TIME_STATS is 1, otherwise to 0, in which case every
+ * allocation is counted in bucket 0.
+ *
+ * configHEAP_PROFILER_CALLER_ADDRESS() returns the return address of the
+ * function it is used in.  It defaults to __builtin_return_address( 0 ) when
+ * using GCC compatible compilers, otherwise to NULL, in which case all
+ * allocations are counted against the overflow call site entry.
+ *
+ * configHEAP_PROFILER_INCLUDE_HEAP_STATS must be set to 0 if the heap
+ * implementation does not provide vPortGetHeapStats(), as is the case for
+ * heap_1.c, heap_2.c and heap_3.c.
+ */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This file calls the heap implementation's pvPortMalloc() and vPortFree(), so
+ * they must not be mapped onto the profiled versions. */
+#define HEAP_IMPLEMENTATION_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_profiler.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_HEAP_PROFILER == 1 )
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error configUSE_HEAP_PROFILER must not be 1 if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_MUTEXES == 0 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_HEAP_PROFILER requires INCLUDE_xTaskGetCurrentTaskHandle to be 1
+#endif
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 ) )
+    #error configUSE_HEAP_PROFILER requires INCLUDE_xTaskGetSchedulerState to be 1
+#endif
+
+#if ( ( configHEAP_PROFILER_MAX_CALL_SITES < 2 ) || ( configHEAP_PROFILER_MAX_CALL_SITES > 65535 ) )
+    #error configHEAP_PROFILER_MAX_CALL_SITES must be between 2 and 65535
+#endif
+
+#if ( ( configHEAP_PROFILER_MAX_TASKS < 2 ) || ( configHEAP_PROFILER_MAX_TASKS > 65535 ) )
+    #error configHEAP_PROFILER_MAX_TASKS must be between 2 and 65535
+#endif
+
+#if ( configMAX_TASK_NAME_LEN > 255 )
+    #error configUSE_HEAP_PROFILER requires configMAX_TASK_NAME_LEN to be 255 or less
+#endif
+
+#ifndef configHEAP_PROFILER_INCLUDE_HEAP_STATS
+    #define configHEAP_PROFILER_INCLUDE_HEAP_STATS    1
+#endif
+
+#ifndef configHEAP_PROFILER_GET_TIME
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+        #define configHEAP_PROFILER_GET_TIME()    portGET_RUN_TIME_COUNTER_VALUE()
+    #else
+        #define configHEAP_PROFILER_GET_TIME()    ( ( configRUN_TIME_COUNTER_TYPE ) 0 )
+    #endif
+#endif
+
+#ifndef configHEAP_PROFILER_CALLER_ADDRESS
+    #if defined( __GNUC__ )
+        #define configHEAP_PROFILER_CALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define configHEAP_PROFILER_CALLER_ADDRESS()    NULL
+    #endif
+#endif
+
+/* The maximum number of table entries examined when looking up a call site or
+ * a task.  If the key is not found and no empty entry is found the allocation
+ * is counted against the overflow entry. */
+#define profilerMAX_PROBES                4U
+
+/* Max value that fits in a size_t type. */
+#define profilerSIZE_MAX                  ( ~( ( size_t ) 0 ) )
+
+/* The value written by xPortHeapProfilerDump() in place of values that do not
+ * fit in 32 bits. */
+#define profilerUINT32_MAX                ( ( uint32_t ) 0xffffffffUL )
+
+/* The version of the format written by xPortHeapProfilerDump(). */
+#define profilerDUMP_FORMAT_VERSION       ( ( uint8_t ) 1U )
+
+/*-----------------------------------------------------------*/
+
+/* Placed immediately before each block returned by pvPortMallocProfiled(). */
+typedef struct A_PROFILER_HEADER
+{
+    size_t xRequestedSize; /**< The size passed to pvPortMallocProfiled(). */
+    uint32_t ulOffset;     /**< The distance from the start of the block allocated from the heap to the memory returned. */
+    uint16_t usCallSite;   /**< The index of the call site in xCallSites. */
+    uint16_t usTask;       /**< The index of the task in xTasks. */
+} ProfilerHeader_t;
+
+/* The size of the header rounded up so the memory after it stays correctly
+ * aligned. */
+static const size_t xProfilerHeaderSize = ( sizeof( ProfilerHeader_t ) + ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Allocates xWantedSize bytes aligned to xAlignment bytes for pvCallSite,
+ * recording the allocation.  Alignments larger than portBYTE_ALIGNMENT are
+ * reached by allocating extra bytes from the heap and skipping some of them,
+ * so work with any heap implementation.
+ */
+static void * prvMallocProfiled( size_t xWantedSize,
+                                 size_t xAlignment,
+                                 void * pvCallSite ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the histogram bucket for xValue, which is the position of its most
+ * significant set bit, capped at the last bucket.
+ */
+static size_t prvHistogramBucket( size_t xValue );
+
+/*
+ * Returns the first table index to probe for pvKey.  Entry 0 is the overflow
+ * entry so is never returned.
+ */
+static size_t prvHashKey( const void * pvKey,
+                          size_t xTableLength );
+
+/*
+ * Return the index of the table entry for pvCallSite or for the calling task,
+ * claiming an empty entry if the key is not already in the table.  Must be
+ * called from a critical section.
+ */
+static uint16_t prvLookupCallSite( void * pvCallSite ) PRIVILEGED_FUNCTION;
+static uint16_t prvLookupTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write ulValue, or the bytes of pvValue, to pucBuffer least significant byte
+ * first, returning the next position in the buffer.
+ */
+static uint8_t * prvWriteUInt32( uint8_t * pucBuffer,
+                                 uint32_t ulValue,
+                                 size_t xBytes );
+static uint8_t * prvWritePointer( uint8_t * pucBuffer,
+                                  const void * pvValue );
+
+/*
+ * Returns xValue, saturated to fit in 32 bits.
+ */
+static uint32_t prvSaturate( size_t xValue );
+
+/*-----------------------------------------------------------*/
+
+/* The call site and task tables.  Entry 0 of each is the overflow entry. */
+PRIVILEGED_DATA static HeapProfilerCallSite_t xCallSites[ configHEAP_PROFILER_MAX_CALL_SITES ];
+PRIVILEGED_DATA static HeapProfilerTask_t xTasks[ configHEAP_PROFILER_MAX_TASKS ];
+
+PRIVILEGED_DATA static uint32_t ulSizeHistogram[ heapPROFILER_HISTOGRAM_BUCKETS ];
+PRIVILEGED_DATA static uint32_t ulLatencyHistogram[ heapPROFILER_HISTOGRAM_BUCKETS ];
+
+PRIVILEGED_DATA static size_t xLiveBytes = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xPeakLiveBytes = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xLiveAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xTotalAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xTotalFrees = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xFailedAllocations = ( size_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocProfiled( size_t xWantedSize )
+{
+    return prvMallocProfiled( xWantedSize, ( size_t ) portBYTE_ALIGNMENT, configHEAP_PROFILER_CALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCallocProfiled( size_t xNum,
+                             size_t xSize )
+{
+    void * pv;
+    size_t xTotalSize;
+
+    if( ( xNum > 0U ) && ( xSize > ( profilerSIZE_MAX / xNum ) ) )
+    {
+        /* The multiplication would overflow, so request a size that cannot be
+         * allocated, which records the failure. */
+        xTotalSize = profilerSIZE_MAX;
+    }
+    else
+    {
+        xTotalSize = xNum * xSize;
+    }
+
+    pv = prvMallocProfiled( xTotalSize, ( size_t ) portBYTE_ALIGNMENT, configHEAP_PROFILER_CALLER_ADDRESS() );
+
+    if( pv != NULL )
+    {
+        ( void ) memset( pv, 0, xTotalSize );
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortReallocProfiled( void * pv,
+                              size_t xWantedSize )
+{
+    void * pvReturn = NULL;
+    size_t xBytesToCopy;
+
+    if( pv == NULL )
+    {
+        pvReturn = prvMallocProfiled( xWantedSize, ( size_t ) portBYTE_ALIGNMENT, configHEAP_PROFILER_CALLER_ADDRESS() );
+    }
+    else if( xWantedSize == 0U )
+    {
+        vPortFreeProfiled( pv );
+    }
+    else
+    {
+        /* The new block is counted against the caller of pvPortRealloc(), so
+         * the allocation is moved rather than resized in place. */
+        pvReturn = prvMallocProfiled( xWantedSize, ( size_t ) portBYTE_ALIGNMENT, configHEAP_PROFILER_CALLER_ADDRESS() );
+
+        if( pvReturn != NULL )
+        {
+            xBytesToCopy = ( ( ProfilerHeader_t * ) ( ( ( uint8_t * ) pv ) - xProfilerHeaderSize ) )->xRequestedSize;
+
+            if( xBytesToCopy > xWantedSize )
+            {
+                xBytesToCopy = xWantedSize;
+            }
+
+            ( void ) memcpy( pvReturn, pv, xBytesToCopy );
+            vPortFreeProfiled( pv );
+        }
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocAlignedProfiled( size_t xWantedSize,
+                                    size_t xAlignment )
+{
+    /* The alignment must be a power of two that fits in the header. */
+    configASSERT( ( xAlignment & ( xAlignment - 1U ) ) == 0U );
+    configASSERT( ( ( xAlignment >> 16 ) >> 15 ) == 0U );
+
+    return prvMallocProfiled( xWantedSize, xAlignment, configHEAP_PROFILER_CALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+void vPortFreeProfiled( void * pv )
+{
+    ProfilerHeader_t * pxHeader;
+    HeapProfilerCallSite_t * pxCallSite;
+    HeapProfilerTask_t * pxTask;
+
+    if( pv != NULL )
+    {
+        pxHeader = ( ProfilerHeader_t * ) ( ( ( uint8_t * ) pv ) - xProfilerHeaderSize );
+
+        /* Check the block was allocated by pvPortMallocProfiled(). */
+        configASSERT( pxHeader->usCallSite < ( uint16_t ) configHEAP_PROFILER_MAX_CALL_SITES );
+        configASSERT( pxHeader->usTask < ( uint16_t ) configHEAP_PROFILER_MAX_TASKS );
+
+        taskENTER_CRITICAL();
+        {
+            pxCallSite = &( xCallSites[ pxHeader->usCallSite ] );
+            pxTask = &( xTasks[ pxHeader->usTask ] );
+
+            configASSERT( pxCallSite->xLiveBytes >= pxHeader->xRequestedSize );
+            configASSERT( pxCallSite->xLiveAllocations > 0U );
+
+            pxCallSite->xLiveBytes -= pxHeader->xRequestedSize;
+            pxCallSite->xLiveAllocations--;
+            pxTask->xLiveBytes -= pxHeader->xRequestedSize;
+
+            /* The entry of a deleted task is kept until the last of its
+             * allocations is freed. */
+            if( ( pxHeader->usTask != 0U ) && ( pxTask->xTask == NULL ) && ( pxTask->xLiveBytes == 0U ) )
+            {
+                ( void ) memset( pxTask, 0x00, sizeof( HeapProfilerTask_t ) );
+            }
+
+            xLiveBytes -= pxHeader->xRequestedSize;
+            xLiveAllocations--;
+            xTotalFrees++;
+        }
+        taskEXIT_CRITICAL();
+
+        vPortFree( ( ( uint8_t * ) pv ) - pxHeader->ulOffset );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvMallocProfiled( size_t xWantedSize,
+                                 size_t xAlignment,
+                                 void * pvCallSite )
+{
+    uint8_t * pucBlock = NULL;
+    ProfilerHeader_t * pxHeader;
+    HeapProfilerCallSite_t * pxCallSite;
+    HeapProfilerTask_t * pxTask;
+    void * pvReturn = NULL;
+    size_t xOverhead = xProfilerHeaderSize;
+    size_t xOffset = xProfilerHeaderSize;
+    size_t xAddress;
+    configRUN_TIME_COUNTER_TYPE xStartTime;
+    configRUN_TIME_COUNTER_TYPE xElapsedTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+    BaseType_t xHeapCalled = pdFALSE;
+
+    /* The heap returns portBYTE_ALIGNMENT aligned memory, so up to
+     * xAlignment - portBYTE_ALIGNMENT extra bytes are needed to reach a larger
+     * alignment. */
+    if( xAlignment > ( size_t ) portBYTE_ALIGNMENT )
+    {
+        xOverhead += xAlignment - ( size_t ) portBYTE_ALIGNMENT;
+    }
+
+    /* The header would turn a request for 0 bytes into a valid allocation, so
+     * requests the heap would reject are rejected here instead. */
+    if( ( xWantedSize > 0U ) && ( xWantedSize <= ( profilerSIZE_MAX - xOverhead ) ) )
+    {
+        xStartTime = configHEAP_PROFILER_GET_TIME();
+        pucBlock = ( uint8_t * ) pvPortMalloc( xWantedSize + xOverhead );
+        xElapsedTime = configHEAP_PROFILER_GET_TIME() - xStartTime;
+        xHeapCalled = pdTRUE;
+    }
+    else
+    {
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            vApplicationMallocFailedHook();
+        }
+        #endif
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if( xHeapCalled == pdTRUE )
+        {
+            if( xElapsedTime > ( configRUN_TIME_COUNTER_TYPE ) profilerSIZE_MAX )
+            {
+                xElapsedTime = ( configRUN_TIME_COUNTER_TYPE ) profilerSIZE_MAX;
+            }
+
+            ulLatencyHistogram[ prvHistogramBucket( ( size_t ) xElapsedTime ) ]++;
+        }
+
+        if( pucBlock != NULL )
+        {
+            if( xAlignment > ( size_t ) portBYTE_ALIGNMENT )
+            {
+                xAddress = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pucBlock ) + xProfilerHeaderSize;
+                xOffset += ( xAlignment - ( xAddress & ( xAlignment - 1U ) ) ) & ( xAlignment - 1U );
+            }
+
+            pvReturn = ( void * ) ( pucBlock + xOffset );
+            pxHeader = ( ProfilerHeader_t * ) ( ( ( uint8_t * ) pvReturn ) - xProfilerHeaderSize );
+            pxHeader->xRequestedSize = xWantedSize;
+            pxHeader->ulOffset = ( uint32_t ) xOffset;
+            pxHeader->usCallSite = prvLookupCallSite( pvCallSite );
+            pxHeader->usTask = prvLookupTask();
+
+            pxCallSite = &( xCallSites[ pxHeader->usCallSite ] );
+            pxCallSite->xLiveBytes += xWantedSize;
+            pxCallSite->xLiveAllocations++;
+            pxCallSite->xTotalAllocations++;
+
+            pxTask = &( xTasks[ pxHeader->usTask ] );
+            pxTask->xLiveBytes += xWantedSize;
+            pxTask->xTotalAllocations++;
+
+            if( pxTask->xLiveBytes > pxTask->xPeakLiveBytes )
+            {
+                pxTask->xPeakLiveBytes = pxTask->xLiveBytes;
+            }
+
+            xLiveBytes += xWantedSize;
+            xLiveAllocations++;
+            xTotalAllocations++;
+
+            if( xLiveBytes > xPeakLiveBytes )
+            {
+                xPeakLiveBytes = xLiveBytes;
+            }
+
+            ulSizeHistogram[ prvHistogramBucket( xWantedSize ) ]++;
+        }
+        else
+        {
+            xFailedAllocations++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvHistogramBucket( size_t xValue )
+{
+    size_t xBucket = 0;
+
+    while( ( xValue > ( size_t ) 1U ) && ( xBucket < ( heapPROFILER_HISTOGRAM_BUCKETS - 1U ) ) )
+    {
+        xValue >>= 1;
+        xBucket++;
+    }
+
+    return xBucket;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvHashKey( const void * pvKey,
+                          size_t xTableLength )
+{
+    size_t xValue = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pvKey );
+
+    /* Code and TCB addresses are aligned, so mix in the higher bits. */
+    xValue = ( xValue >> 2 ) ^ ( xValue >> 11 );
+
+    return ( xValue % ( xTableLength - 1U ) ) + 1U;
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvLookupCallSite( void * pvCallSite )
+{
+    size_t xIndex;
+    size_t xProbe;
+    uint16_t usReturn = 0U;
+
+    if( pvCallSite != NULL )
+    {
+        xIndex = prvHashKey( pvCallSite, configHEAP_PROFILER_MAX_CALL_SITES );
+
+        for( xProbe = 0U; ( xProbe < profilerMAX_PROBES ) && ( xProbe < ( size_t ) ( configHEAP_PROFILER_MAX_CALL_SITES - 1 ) ); xProbe++ )
+        {
+            if( xCallSites[ xIndex ].pvCallSite == NULL )
+            {
+                xCallSites[ xIndex ].pvCallSite = pvCallSite;
+            }
+
+            if( xCallSites[ xIndex ].pvCallSite == pvCallSite )
+            {
+                usReturn = ( uint16_t ) xIndex;
+                break;
+            }
+
+            xIndex++;
+
+            if( xIndex >= ( size_t ) configHEAP_PROFILER_MAX_CALL_SITES )
+            {
+                xIndex = 1U;
+            }
+        }
+    }
+
+    return usReturn;
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvLookupTask( void )
+{
+    TaskHandle_t xTask = NULL;
+    const char * pcName;
+    size_t xIndex;
+    size_t xProbe;
+    size_t xFreeIndex = 0U;
+    size_t x;
+    uint16_t usReturn = 0U;
+
+    /* Allocations made before the scheduler starts are not made by any task,
+     * even though there may already be a current task. */
+    if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+    {
+        xTask = xTaskGetCurrentTaskHandle();
+    }
+
+    if( xTask != NULL )
+    {
+        xIndex = prvHashKey( xTask, configHEAP_PROFILER_MAX_TASKS );
+
+        /* Entries are released when tasks are deleted, so an empty entry does
+         * not end the search and every probe is checked for the task. */
+        for( xProbe = 0U; ( xProbe < profilerMAX_PROBES ) && ( xProbe < ( size_t ) ( configHEAP_PROFILER_MAX_TASKS - 1 ) ); xProbe++ )
+        {
+            if( xTasks[ xIndex ].xTask == xTask )
+            {
+                usReturn = ( uint16_t ) xIndex;
+                break;
+            }
+            else if( ( xFreeIndex == 0U ) && ( xTasks[ xIndex ].xTask == NULL ) && ( xTasks[ xIndex ].xLiveBytes == 0U ) )
+            {
+                xFreeIndex = xIndex;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xIndex++;
+
+            if( xIndex >= ( size_t ) configHEAP_PROFILER_MAX_TASKS )
+            {
+                xIndex = 1U;
+            }
+        }
+
+        if( ( usReturn == 0U ) && ( xFreeIndex != 0U ) )
+        {
+            ( void ) memset( &( xTasks[ xFreeIndex ] ), 0x00, sizeof( HeapProfilerTask_t ) );
+            xTasks[ xFreeIndex ].xTask = xTask;
+            pcName = pcTaskGetName( xTask );
+
+            for( x = 0U; x < ( size_t ) configMAX_TASK_NAME_LEN; x++ )
+            {
+                xTasks[ xFreeIndex ].pcTaskName[ x ] = pcName[ x ];
+
+                if( pcName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+            }
+
+            usReturn = ( uint16_t ) xFreeIndex;
+        }
+    }
+
+    return usReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapProfilerGetSnapshot( HeapProfilerSnapshot_t * pxSnapshot )
+{
+    HeapStats_t xHeapStats;
+    size_t xAvailable;
+    size_t xFragmented;
+    size_t x;
+    UBaseType_t uxCount;
+
+    configASSERT( pxSnapshot != NULL );
+
+    /* vPortGetHeapStats() has its own locking, so is called first. */
+    #if ( configHEAP_PROFILER_INCLUDE_HEAP_STATS == 1 )
+    {
+        vPortGetHeapStats( &xHeapStats );
+    }
+    #else
+    {
+        ( void ) memset( &xHeapStats, 0x00, sizeof( xHeapStats ) );
+    }
+    #endif
+
+    taskENTER_CRITICAL();
+    {
+        pxSnapshot->xLiveBytes = xLiveBytes;
+        pxSnapshot->xPeakLiveBytes = xPeakLiveBytes;
+        pxSnapshot->xLiveAllocations = xLiveAllocations;
+        pxSnapshot->xTotalAllocations = xTotalAllocations;
+        pxSnapshot->xTotalFrees = xTotalFrees;
+        pxSnapshot->xFailedAllocations = xFailedAllocations;
+        ( void ) memcpy( pxSnapshot->ulSizeHistogram, ulSizeHistogram, sizeof( ulSizeHistogram ) );
+        ( void ) memcpy( pxSnapshot->ulLatencyHistogram, ulLatencyHistogram, sizeof( ulLatencyHistogram ) );
+
+        /* Only copy the entries that are in use.  The overflow entries have a
+         * NULL key, so are in use if anything has been counted against them. */
+        uxCount = 0U;
+
+        for( x = 0U; x < ( size_t ) configHEAP_PROFILER_MAX_CALL_SITES; x++ )
+        {
+            if( ( xCallSites[ x ].pvCallSite != NULL ) || ( xCallSites[ x ].xTotalAllocations != 0U ) )
+            {
+                pxSnapshot->xCallSites[ uxCount ] = xCallSites[ x ];
+                uxCount++;
+            }
+        }
+
+        pxSnapshot->uxNumberOfCallSites = uxCount;
+        uxCount = 0U;
+
+        for( x = 0U; x < ( size_t ) configHEAP_PROFILER_MAX_TASKS; x++ )
+        {
+            if( ( xTasks[ x ].xTask != NULL ) || ( xTasks[ x ].xTotalAllocations != 0U ) )
+            {
+                pxSnapshot->xTasks[ uxCount ] = xTasks[ x ];
+                uxCount++;
+            }
+        }
+
+        pxSnapshot->uxNumberOfTasks = uxCount;
+    }
+    taskEXIT_CRITICAL();
+
+    pxSnapshot->xHeapStats = xHeapStats;
+
+    /* The fragmentation index is the proportion of the free memory that is not
+     * in the largest free block, in parts per thousand.  Avoid overflowing the
+     * multiplication when the heap is large. */
+    xAvailable = xHeapStats.xAvailableHeapSpaceInBytes;
+
+    if( xAvailable == 0U )
+    {
+        pxSnapshot->uxFragmentationIndex = 0U;
+    }
+    else
+    {
+        xFragmented = xAvailable - xHeapStats.xSizeOfLargestFreeBlockInBytes;
+
+        if( xAvailable <= ( profilerSIZE_MAX / 1000U ) )
+        {
+            pxSnapshot->uxFragmentationIndex = ( UBaseType_t ) ( ( xFragmented * 1000U ) / xAvailable );
+        }
+        else
+        {
+            pxSnapshot->uxFragmentationIndex = ( UBaseType_t ) ( xFragmented / ( xAvailable / 1000U ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortHeapProfilerDump( const HeapProfilerSnapshot_t * pxSnapshot,
+                              uint8_t * pucBuffer,
+                              size_t xBufferLengthBytes )
+{
+    uint8_t * pucNext = pucBuffer;
+    size_t xRequiredBytes;
+    size_t x;
+    size_t y;
+
+    configASSERT( pxSnapshot != NULL );
+    configASSERT( pucBuffer != NULL );
+    configASSERT( pxSnapshot->uxNumberOfCallSites <= ( UBaseType_t ) configHEAP_PROFILER_MAX_CALL_SITES );
+    configASSERT( pxSnapshot->uxNumberOfTasks <= ( UBaseType_t ) configHEAP_PROFILER_MAX_TASKS );
+
+    xRequiredBytes = heapPROFILER_DUMP_HEADER_SIZE + ( heapPROFILER_HISTOGRAM_BUCKETS * 8U );
+    xRequiredBytes += ( size_t ) pxSnapshot->uxNumberOfCallSites * ( sizeof( void * ) + 12U );
+    xRequiredBytes += ( size_t ) pxSnapshot->uxNumberOfTasks * ( sizeof( void * ) + ( size_t ) configMAX_TASK_NAME_LEN + 12U );
+
+    if( xRequiredBytes > xBufferLengthBytes )
+    {
+        xRequiredBytes = 0U;
+    }
+    else
+    {
+        pucNext[ 0 ] = ( uint8_t ) 'F';
+        pucNext[ 1 ] = ( uint8_t ) 'R';
+        pucNext[ 2 ] = ( uint8_t ) 'H';
+        pucNext[ 3 ] = ( uint8_t ) 'P';
+        pucNext[ 4 ] = profilerDUMP_FORMAT_VERSION;
+        pucNext[ 5 ] = ( uint8_t ) sizeof( void * );
+        pucNext[ 6 ] = ( uint8_t ) heapPROFILER_HISTOGRAM_BUCKETS;
+        pucNext[ 7 ] = ( uint8_t ) configMAX_TASK_NAME_LEN;
+        pucNext = &( pucNext[ 8 ] );
+
+        pucNext = prvWriteUInt32( pucNext, ( uint32_t ) pxSnapshot->uxNumberOfCallSites, sizeof( uint16_t ) );
+        pucNext = prvWriteUInt32( pucNext, ( uint32_t ) pxSnapshot->uxNumberOfTasks, sizeof( uint16_t ) );
+
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xLiveBytes ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xPeakLiveBytes ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xLiveAllocations ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xTotalAllocations ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xTotalFrees ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xFailedAllocations ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xHeapStats.xAvailableHeapSpaceInBytes ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xHeapStats.xSizeOfLargestFreeBlockInBytes ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xHeapStats.xSizeOfSmallestFreeBlockInBytes ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xHeapStats.xNumberOfFreeBlocks ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xHeapStats.xMinimumEverFreeBytesRemaining ), sizeof( uint32_t ) );
+        pucNext = prvWriteUInt32( pucNext, ( uint32_t ) pxSnapshot->uxFragmentationIndex, sizeof( uint32_t ) );
+
+        for( x = 0U; x < heapPROFILER_HISTOGRAM_BUCKETS; x++ )
+        {
+            pucNext = prvWriteUInt32( pucNext, pxSnapshot->ulSizeHistogram[ x ], sizeof( uint32_t ) );
+        }
+
+        for( x = 0U; x < heapPROFILER_HISTOGRAM_BUCKETS; x++ )
+        {
+            pucNext = prvWriteUInt32( pucNext, pxSnapshot->ulLatencyHistogram[ x ], sizeof( uint32_t ) );
+        }
+
+        for( x = 0U; x < ( size_t ) pxSnapshot->uxNumberOfCallSites; x++ )
+        {
+            pucNext = prvWritePointer( pucNext, pxSnapshot->xCallSites[ x ].pvCallSite );
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xCallSites[ x ].xLiveBytes ), sizeof( uint32_t ) );
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xCallSites[ x ].xLiveAllocations ), sizeof( uint32_t ) );
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xCallSites[ x ].xTotalAllocations ), sizeof( uint32_t ) );
+        }
+
+        for( x = 0U; x < ( size_t ) pxSnapshot->uxNumberOfTasks; x++ )
+        {
+            pucNext = prvWritePointer( pucNext, pxSnapshot->xTasks[ x ].xTask );
+
+            for( y = 0U; y < ( size_t ) configMAX_TASK_NAME_LEN; y++ )
+            {
+                *pucNext = ( uint8_t ) pxSnapshot->xTasks[ x ].pcTaskName[ y ];
+                pucNext++;
+            }
+
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xTasks[ x ].xLiveBytes ), sizeof( uint32_t ) );
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xTasks[ x ].xPeakLiveBytes ), sizeof( uint32_t ) );
+            pucNext = prvWriteUInt32( pucNext, prvSaturate( pxSnapshot->xTasks[ x ].xTotalAllocations ), sizeof( uint32_t ) );
+        }
+
+        configASSERT( ( size_t ) ( pucNext - pucBuffer ) == xRequiredBytes );
+    }
+
+    return xRequiredBytes;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvWriteUInt32( uint8_t * pucBuffer,
+                                 uint32_t ulValue,
+                                 size_t xBytes )
+{
+    size_t x;
+
+    for( x = 0U; x < xBytes; x++ )
+    {
+        pucBuffer[ x ] = ( uint8_t ) ( ulValue & 0xffU );
+        ulValue >>= 8;
+    }
+
+    return &( pucBuffer[ xBytes ] );
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvWritePointer( uint8_t * pucBuffer,
+                                  const void * pvValue )
+{
+    size_t xValue = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pvValue );
+    size_t x;
+
+    for( x = 0U; x < sizeof( void * ); x++ )
+    {
+        pucBuffer[ x ] = ( uint8_t ) ( xValue & 0xffU );
+        xValue >>= 8;
+    }
+
+    return &( pucBuffer[ sizeof( void * ) ] );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSaturate( size_t xValue )
+{
+    uint32_t ulReturn;
+
+    /* Shift in two steps as the shift would be undefined if size_t is 32
+     * bits. */
+    if( ( ( xValue >> 16 ) >> 16 ) != 0U )
+    {
+        ulReturn = profilerUINT32_MAX;
+    }
+    else
+    {
+        ulReturn = ( uint32_t ) xValue;
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapProfilerTaskDeleted( TaskHandle_t xTask )
+{
+    size_t xIndex;
+    size_t xProbe;
+
+    taskENTER_CRITICAL();
+    {
+        xIndex = prvHashKey( xTask, configHEAP_PROFILER_MAX_TASKS );
+
+        for( xProbe = 0U; ( xProbe < profilerMAX_PROBES ) && ( xProbe < ( size_t ) ( configHEAP_PROFILER_MAX_TASKS - 1 ) ); xProbe++ )
+        {
+            if( xTasks[ xIndex ].xTask == xTask )
+            {
+                /* Release the entry so a task created later at the same
+                 * address starts from zero.  If some of the task's allocations
+                 * are still live the entry is kept, without its handle, so the
+                 * frees can still be counted against it. */
+                if( xTasks[ xIndex ].xLiveBytes == 0U )
+                {
+                    ( void ) memset( &( xTasks[ xIndex ] ), 0x00, sizeof( HeapProfilerTask_t ) );
+                }
+                else
+                {
+                    xTasks[ xIndex ].xTask = NULL;
+                }
+
+                break;
+            }
+
+            xIndex++;
+
+            if( xIndex >= ( size_t ) configHEAP_PROFILER_MAX_TASKS )
+            {
+                xIndex = 1U;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapProfilerResetState( void )
+{
+    ( void ) memset( xCallSites, 0x00, sizeof( xCallSites ) );
+    ( void ) memset( xTasks, 0x00, sizeof( xTasks ) );
+    ( void ) memset( ulSizeHistogram, 0x00, sizeof( ulSizeHistogram ) );
+    ( void ) memset( ulLatencyHistogram, 0x00, sizeof( ulLatencyHistogram ) );
+
+    xLiveBytes = ( size_t ) 0U;
+    xPeakLiveBytes = ( size_t ) 0U;
+    xLiveAllocations = ( size_t ) 0U;
+    xTotalAllocations = ( size_t ) 0U;
+    xTotalFrees = ( size_t ) 0U;
+    xFailedAllocations = ( size_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_PROFILER */
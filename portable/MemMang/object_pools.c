@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Pools of fixed size kernel objects that sit in front of whichever heap
+ * implementation (heap_1.c to heap_6.c, or an application supplied heap) is
+ * in the build.  This file is only used when configUSE_KERNEL_OBJECT_POOLS is
+ * set to 1 in FreeRTOSConfig.h, in which case it must be built along with the
+ * heap implementation.
+ *
+ * Task control blocks, semaphores, mutexes, software timers and event groups
+ * are always the same size, so once one has been deleted its memory can be
+ * reused by the next object of the same type without going back to the heap.
+ * Each type of object has its own singly linked list of free objects, so
+ * allocating or freeing an object is a constant time pop or push that does not
+ * fragment the heap.  Objects are never returned to the heap.
+ *
+ * Objects can be added to a pool in bulk by xPortObjectPoolReserve(), for
+ * example at start up, in which case they are allocated from the heap in a
+ * single contiguous block.  When a pool is empty it grows by one object at a
+ * time, unless configKERNEL_OBJECT_POOL_GROW_ON_DEMAND is set to 0, in which
+ * case only reserved objects are ever used.
+ *
+ * Queues that have a storage area, stream buffers and message buffers are a
+ * different size each time they are created so are still allocated from the
+ * heap.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error configUSE_KERNEL_OBJECT_POOLS must not be 1 if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configKERNEL_OBJECT_POOL_GROW_ON_DEMAND
+    #define configKERNEL_OBJECT_POOL_GROW_ON_DEMAND    1
+#endif
+
+/* Max value that fits in a size_t type. */
+#define poolSIZE_MAX                            ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define poolMULTIPLY_WILL_OVERFLOW( a, b )      ( ( ( a ) > 0 ) && ( ( b ) > ( poolSIZE_MAX / ( a ) ) ) )
+
+/* Pool memory is placed in the heap region chosen for the type of object it
+ * holds, when the heap supports placement. */
+#if ( configUSE_HEAP_REGION_PLACEMENT == 1 )
+    #define poolMALLOC( ePool, xSize )    pvPortMallocPlaced( ( eHeapPlacement ) ( ePool ), ( xSize ), 0U )
+#else
+    #define poolMALLOC( ePool, xSize )    pvPortMalloc( xSize )
+#endif
+
+/* The size of each object in a pool.  The size is rounded up so objects carved
+ * from a single reserved block are all correctly aligned. */
+#define poolOBJECT_SIZE( xType )                ( ( sizeof( xType ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*-----------------------------------------------------------*/
+
+/* A free object holds a pointer to the next free object in the same pool. */
+typedef struct A_POOL_LINK
+{
+    struct A_POOL_LINK * pxNextFreeObject;
+} PoolLink_t;
+
+typedef struct A_OBJECT_POOL
+{
+    PoolLink_t * pxFreeObjects;        /**< The first object in the list of free objects. */
+    size_t xNumberOfFreeObjects;       /**< The number of objects in the list of free objects. */
+    size_t xNumberOfObjectsInUse;      /**< The number of objects allocated from the pool and not yet freed. */
+    size_t xMaximumEverObjectsInUse;   /**< The highest value xNumberOfObjectsInUse has had. */
+    size_t xNumberOfObjectsFromHeap;   /**< The number of objects obtained from pvPortMalloc(). */
+    size_t xNumberOfFailedAllocations; /**< The number of calls to pvPortMallocObject() that returned NULL. */
+} ObjectPool_t;
+
+/*-----------------------------------------------------------*/
+
+/* The static objects are the same size as the kernel objects they stand in for,
+ * and TCB_t and friends are private to the files that use them. */
+static const size_t xObjectSizes[ eObjectPoolCount ] =
+{
+    poolOBJECT_SIZE( StaticTask_t ),
+    poolOBJECT_SIZE( StaticQueue_t ),
+    poolOBJECT_SIZE( StaticTimer_t ),
+    poolOBJECT_SIZE( StaticEventGroup_t )
+};
+
+/*
+ * Updates the in use and high water counts of pxPool when an object has been
+ * allocated.  Must be called from a critical section.
+ */
+static void prvRecordAllocation( ObjectPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+PRIVILEGED_DATA static ObjectPool_t xObjectPools[ eObjectPoolCount ];
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocObject( eObjectPool ePool,
+                           size_t xSize )
+{
+    ObjectPool_t * const pxPool = &( xObjectPools[ ePool ] );
+    PoolLink_t * pxObject;
+
+    configASSERT( ePool < eObjectPoolCount );
+    configASSERT( xSize <= xObjectSizes[ ePool ] );
+
+    /* Prevent compiler warnings when configASSERT() is not defined. */
+    ( void ) xSize;
+
+    taskENTER_CRITICAL();
+    {
+        pxObject = pxPool->pxFreeObjects;
+
+        if( pxObject != NULL )
+        {
+            pxPool->pxFreeObjects = pxObject->pxNextFreeObject;
+            pxPool->xNumberOfFreeObjects--;
+            prvRecordAllocation( pxPool );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( pxObject == NULL )
+    {
+        #if ( configKERNEL_OBJECT_POOL_GROW_ON_DEMAND == 1 )
+        {
+            /* The pool is empty, so grow it by the object being allocated.
+             * The object is returned to the pool, not the heap, when it is
+             * freed. */
+            pxObject = ( PoolLink_t * ) poolMALLOC( ePool, xObjectSizes[ ePool ] );
+        }
+        #endif
+
+        taskENTER_CRITICAL();
+        {
+            if( pxObject != NULL )
+            {
+                pxPool->xNumberOfObjectsFromHeap++;
+                prvRecordAllocation( pxPool );
+            }
+            else
+            {
+                pxPool->xNumberOfFailedAllocations++;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return ( void * ) pxObject;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordAllocation( ObjectPool_t * const pxPool ) /* PRIVILEGED_FUNCTION */
+{
+    pxPool->xNumberOfObjectsInUse++;
+
+    if( pxPool->xNumberOfObjectsInUse > pxPool->xMaximumEverObjectsInUse )
+    {
+        pxPool->xMaximumEverObjectsInUse = pxPool->xNumberOfObjectsInUse;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortFreeObject( eObjectPool ePool,
+                      void * pv )
+{
+    ObjectPool_t * const pxPool = &( xObjectPools[ ePool ] );
+    PoolLink_t * const pxObject = ( PoolLink_t * ) pv;
+
+    configASSERT( ePool < eObjectPoolCount );
+
+    if( pxObject != NULL )
+    {
+        taskENTER_CRITICAL();
+        {
+            configASSERT( pxPool->xNumberOfObjectsInUse > 0U );
+
+            pxObject->pxNextFreeObject = pxPool->pxFreeObjects;
+            pxPool->pxFreeObjects = pxObject;
+            pxPool->xNumberOfFreeObjects++;
+            pxPool->xNumberOfObjectsInUse--;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortObjectPoolReserve( eObjectPool ePool,
+                                   size_t xNumberOfObjects )
+{
+    ObjectPool_t * const pxPool = &( xObjectPools[ ePool ] );
+    uint8_t * pucObjects = NULL;
+    PoolLink_t * pxFirst;
+    PoolLink_t * pxObject;
+    size_t x;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( ePool < eObjectPoolCount );
+
+    if( ( xNumberOfObjects > 0U ) && ( poolMULTIPLY_WILL_OVERFLOW( xNumberOfObjects, xObjectSizes[ ePool ] ) == 0 ) )
+    {
+        pucObjects = ( uint8_t * ) poolMALLOC( ePool, xNumberOfObjects * xObjectSizes[ ePool ] );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pucObjects != NULL )
+    {
+        /* Link the objects together before adding them to the pool so the
+         * critical section below is short. */
+        pxFirst = ( PoolLink_t * ) pucObjects;
+        pxObject = pxFirst;
+
+        for( x = 1U; x < xNumberOfObjects; x++ )
+        {
+            pxObject->pxNextFreeObject = ( PoolLink_t * ) ( pucObjects + ( x * xObjectSizes[ ePool ] ) );
+            pxObject = pxObject->pxNextFreeObject;
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxObject->pxNextFreeObject = pxPool->pxFreeObjects;
+            pxPool->pxFreeObjects = pxFirst;
+            pxPool->xNumberOfFreeObjects += xNumberOfObjects;
+            pxPool->xNumberOfObjectsFromHeap += xNumberOfObjects;
+        }
+        taskEXIT_CRITICAL();
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetObjectPoolStats( eObjectPool ePool,
+                              ObjectPoolStats_t * pxPoolStats )
+{
+    const ObjectPool_t * const pxPool = &( xObjectPools[ ePool ] );
+
+    configASSERT( ePool < eObjectPoolCount );
+
+    pxPoolStats->xObjectSizeInBytes = xObjectSizes[ ePool ];
+
+    taskENTER_CRITICAL();
+    {
+        pxPoolStats->xNumberOfObjectsInUse = pxPool->xNumberOfObjectsInUse;
+        pxPoolStats->xNumberOfFreeObjects = pxPool->xNumberOfFreeObjects;
+        pxPoolStats->xMaximumEverObjectsInUse = pxPool->xMaximumEverObjectsInUse;
+        pxPoolStats->xNumberOfObjectsFromHeap = pxPool->xNumberOfObjectsFromHeap;
+        pxPoolStats->xNumberOfFailedAllocations = pxPool->xNumberOfFailedAllocations;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortObjectPoolResetState( void )
+{
+    BaseType_t x;
+
+    for( x = 0; x < ( BaseType_t ) eObjectPoolCount; x++ )
+    {
+        xObjectPools[ x ].pxFreeObjects = NULL;
+        xObjectPools[ x ].xNumberOfFreeObjects = ( size_t ) 0U;
+        xObjectPools[ x ].xNumberOfObjectsInUse = ( size_t ) 0U;
+        xObjectPools[ x ].xMaximumEverObjectsInUse = ( size_t ) 0U;
+        xObjectPools[ x ].xNumberOfObjectsFromHeap = ( size_t ) 0U;
+        xObjectPools[ x ].xNumberOfFailedAllocations = ( size_t ) 0U;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_KERNEL_OBJECT_POOLS */
@@ -61,11 +61,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
-#include <sys/times.h>
 #include <time.h>
 #include <unistd.h>
 
 #ifdef __APPLE__
+    #include <mach/mach.h>
     #include <mach/mach_vm.h>
 #endif
 
@@ -74,9 +74,63 @@
 #include "task.h"
 #include "timers.h"
 #include "utils/wait_for_event.h"
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    #include "critical_profiler.h"
+#endif
+
+#ifndef configUSE_POSIX_PERF_COUNTERS
+    #define configUSE_POSIX_PERF_COUNTERS    0
+#endif
+
+#ifndef configPOSIX_PERF_COUNTERS_REPORT_JSON
+    #define configPOSIX_PERF_COUNTERS_REPORT_JSON    0
+#endif
+
+#if ( configUSE_POSIX_PERF_COUNTERS == 1 ) && defined( __linux__ )
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+#endif
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME      SIGUSR1
+#define SIG_STIMULUS    SIGUSR2
+
+#if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+
+    #define portPERF_COUNTER_COUNT    4
+
+/*
+ * The perf_event counters of one task.  Records are kept until the scheduler
+ * ends, so the counts of deleted tasks can still be reported.
+ */
+    typedef struct PERF_RECORD
+    {
+        struct PERF_RECORD * pxNext;
+        struct THREAD * pxThread; /* NULL once the task has been deleted. */
+        char pcTaskName[ configMAX_TASK_NAME_LEN ];
+        int iFd[ portPERF_COUNTER_COUNT ];
+        uint64_t ullFinal[ portPERF_COUNTER_COUNT ]; /* The counts read when the task was deleted. */
+    } PerfRecord_t;
+
+#endif /* configUSE_POSIX_PERF_COUNTERS */
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+/*
+ * A periodic interrupt emulated by a thread that signals the thread of the
+ * running task, see xPortStartISRStimulus().
+ */
+    typedef struct ISR_STIMULUS
+    {
+        pthread_t xThread;
+        volatile PortISRStimulusHandler_t pxHandler;
+        uint32_t ulPeriodMicroseconds;
+        volatile bool xShouldRun;
+        bool xPending;
+    } ISRStimulus_t;
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
 
 typedef struct THREAD
 {
@@ -85,6 +139,9 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+        PerfRecord_t * pxPerf;
+    #endif
 } Thread_t;
 
 /*
@@ -109,6 +166,15 @@ static BaseType_t xSchedulerEnd = pdFALSE;
 static pthread_t hTimerTickThread;
 static bool xTimerTickThreadShouldRun;
 static uint64_t prvStartTimeNs;
+static uint64_t prvRunTimeOriginNs;
+
+#if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+    static PerfRecord_t * pxPerfRecords = NULL;
+#endif
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    static ISRStimulus_t xISRStimuli[ configISR_WAKE_LATENCY_SOURCES ];
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -121,6 +187,21 @@ static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
+
+#if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+    static void prvPerfCountersOpen( Thread_t * pxThread );
+    static void prvPerfCountersRead( const PerfRecord_t * pxRecord,
+                                     uint64_t * pullCounts );
+    static void prvPerfCountersClose( Thread_t * pxThread );
+    static void prvPerfCountersWrite( const char * pcFileName,
+                                      BaseType_t xJson );
+    static void prvPerfCountersEndScheduler( void );
+#endif
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    static void * prvISRStimulusThread( void * pvParams );
+    static void prvISRStimulusHandler( int sig );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char * pcCall,
@@ -179,6 +260,10 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
     thread->pvParams = pvParameters;
     thread->xDying = pdFALSE;
 
+    #if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+        thread->pxPerf = NULL;
+    #endif
+
     /* Ensure ulStackSize is at least PTHREAD_STACK_MIN */
     ulStackSize = (ulStackSize < PTHREAD_STACK_MIN) ? PTHREAD_STACK_MIN : ulStackSize;
 
@@ -280,6 +365,21 @@ void vPortEndScheduler( void )
     xTimerTickThreadShouldRun = false;
     pthread_join( hTimerTickThread, NULL );
 
+    #if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+        prvPerfCountersEndScheduler();
+    #endif
+
+    #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    {
+        UBaseType_t uxSourceID;
+
+        for( uxSourceID = 0; uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES; uxSourceID++ )
+        {
+            vPortStopISRStimulus( uxSourceID );
+        }
+    }
+    #endif
+
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
@@ -296,6 +396,10 @@ void vPortEnterCritical( void )
     if( uxCriticalNesting == 0 )
     {
         vPortDisableInterrupts();
+
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+            vCriticalProfilerEnter( eCriticalSectionRegion, configCRITICAL_PROFILER_GET_CALLER() );
+        #endif
     }
 
     uxCriticalNesting++;
@@ -309,6 +413,10 @@ void vPortExitCritical( void )
     /* If we have reached 0 then re-enable the interrupts. */
     if( uxCriticalNesting == 0 )
     {
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+            vCriticalProfilerExit( eCriticalSectionRegion );
+        #endif
+
         vPortEnableInterrupts();
     }
 }
@@ -470,6 +578,10 @@ void vPortCancelThread( void * pxTaskToDelete )
 {
     Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
 
+    #if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+        prvPerfCountersClose( pxThreadToCancel );
+    #endif
+
     /*
      * The thread has already been suspended so it can be safely cancelled.
      */
@@ -486,6 +598,12 @@ static void * prvWaitForStart( void * pvParams )
 
     prvSuspendSelf( pxThread );
 
+    #if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+        /* Open the counters while signals are still blocked, as allocating
+         * the record must not be interrupted by a context switch. */
+        prvPerfCountersOpen( pxThread );
+    #endif
+
     /* Resumed for the first time, unblocks all signals. */
     uxCriticalNesting = 0;
     vPortEnableInterrupts();
@@ -602,15 +720,508 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+    {
+        struct sigaction sigstimulus;
+
+        sigstimulus.sa_flags = 0;
+        sigstimulus.sa_handler = prvISRStimulusHandler;
+        sigfillset( &sigstimulus.sa_mask );
+
+        iRet = sigaction( SIG_STIMULUS, &sigstimulus, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortConfigureRunTimeClock( void )
+{
+    prvRunTimeOriginNs = prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetRunTime( void )
+{
+    return ( prvGetTimeNs() - prvRunTimeOriginNs ) / ( uint64_t ) 1000;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetTaskCpuTime( void * pxTask )
+{
+    Thread_t * pxThread;
+    uint64_t ullCpuTimeUs = 0;
+
+    if( pxTask == NULL )
+    {
+        pxTask = xTaskGetCurrentTaskHandle();
+    }
+
+    pxThread = prvGetThreadFromTask( pxTask );
+
+    #ifdef __APPLE__
+    {
+        thread_basic_info_data_t xInfo;
+        mach_msg_type_number_t xCount = THREAD_BASIC_INFO_COUNT;
+
+        if( thread_info( pthread_mach_thread_np( pxThread->pthread ), THREAD_BASIC_INFO, ( thread_info_t ) &xInfo, &xCount ) == KERN_SUCCESS )
+        {
+            ullCpuTimeUs = ( ( uint64_t ) xInfo.user_time.seconds + ( uint64_t ) xInfo.system_time.seconds ) * ( uint64_t ) 1000000 +
+                           ( uint64_t ) xInfo.user_time.microseconds + ( uint64_t ) xInfo.system_time.microseconds;
+        }
+    }
+    #else /* ifdef __APPLE__ */
+    {
+        clockid_t xClock;
+        struct timespec xTime;
+
+        if( ( pthread_getcpuclockid( pxThread->pthread, &xClock ) == 0 ) &&
+            ( clock_gettime( xClock, &xTime ) == 0 ) )
+        {
+            ullCpuTimeUs = ( uint64_t ) xTime.tv_sec * ( uint64_t ) 1000000 + ( uint64_t ) xTime.tv_nsec / ( uint64_t ) 1000;
+        }
+    }
+    #endif /* ifdef __APPLE__ */
+
+    return ullCpuTimeUs;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetHighResolutionTime( void )
+{
+    return ( uint32_t ) prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POSIX_PERF_COUNTERS == 1 )
+
+static void prvPerfCountersOpen( Thread_t * pxThread )
+{
+    PerfRecord_t * pxRecord;
+    PerfRecord_t ** ppxLast;
+    size_t x;
+
+    pxRecord = calloc( 1, sizeof( PerfRecord_t ) );
+
+    if( pxRecord == NULL )
+    {
+        return;
+    }
+
+    ( void ) strncpy( pxRecord->pcTaskName, pcTaskGetName( xTaskGetCurrentTaskHandle() ), sizeof( pxRecord->pcTaskName ) - 1U );
+
+    for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+    {
+        pxRecord->iFd[ x ] = -1;
+    }
+
+    #ifdef __linux__
+    {
+        static const uint64_t ullConfig[ portPERF_COUNTER_COUNT ] =
+        {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+        struct perf_event_attr xAttr;
+
+        for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+        {
+            memset( &xAttr, 0, sizeof( xAttr ) );
+            xAttr.size = sizeof( xAttr );
+            xAttr.type = PERF_TYPE_HARDWARE;
+            xAttr.config = ullConfig[ x ];
+            xAttr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            xAttr.exclude_kernel = 1;
+            xAttr.exclude_hv = 1;
+
+            /* A pid of 0 and a cpu of -1 counts the calling thread on any
+             * CPU.  Each counter is opened on its own, rather than as a
+             * group, so a counter the host does not support only loses that
+             * counter. */
+            pxRecord->iFd[ x ] = ( int ) syscall( SYS_perf_event_open, &xAttr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC );
+        }
+    }
+    #endif /* __linux__ */
+
+    pxRecord->pxThread = pxThread;
+    pxThread->pxPerf = pxRecord;
+
+    /* Only this thread is running, so the list can be updated safely.  The
+     * record is appended so the report lists tasks in the order they first
+     * ran. */
+    for( ppxLast = &pxPerfRecords; *ppxLast != NULL; ppxLast = &( ( *ppxLast )->pxNext ) )
+    {
+    }
+
+    *ppxLast = pxRecord;
 }
 /*-----------------------------------------------------------*/
 
-uint32_t ulPortGetRunTime( void )
+static void prvPerfCountersRead( const PerfRecord_t * pxRecord,
+                                 uint64_t * pullCounts )
 {
-    struct tms xTimes;
+    uint64_t ullValue[ 3 ]; /* The count, time enabled and time running. */
+    size_t x;
 
-    times( &xTimes );
+    for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+    {
+        pullCounts[ x ] = 0;
 
-    return ( uint32_t ) xTimes.tms_utime;
+        if( pxRecord->pxThread == NULL )
+        {
+            pullCounts[ x ] = pxRecord->ullFinal[ x ];
+        }
+        else if( ( pxRecord->iFd[ x ] >= 0 ) &&
+                 ( read( pxRecord->iFd[ x ], ullValue, sizeof( ullValue ) ) == ( ssize_t ) sizeof( ullValue ) ) &&
+                 ( ullValue[ 2 ] != 0U ) )
+        {
+            /* Scale the count up if the host multiplexed the counter. */
+            if( ullValue[ 2 ] < ullValue[ 1 ] )
+            {
+                pullCounts[ x ] = ( uint64_t ) ( ( double ) ullValue[ 0 ] * ( double ) ullValue[ 1 ] / ( double ) ullValue[ 2 ] );
+            }
+            else
+            {
+                pullCounts[ x ] = ullValue[ 0 ];
+            }
+        }
+    }
 }
 /*-----------------------------------------------------------*/
+
+static void prvPerfCountersClose( Thread_t * pxThread )
+{
+    PerfRecord_t * pxRecord = pxThread->pxPerf;
+    size_t x;
+
+    if( pxRecord != NULL )
+    {
+        vPortEnterCritical();
+        {
+            prvPerfCountersRead( pxRecord, pxRecord->ullFinal );
+            pxRecord->pxThread = NULL;
+            pxThread->pxPerf = NULL;
+        }
+        vPortExitCritical();
+
+        for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+        {
+            if( pxRecord->iFd[ x ] >= 0 )
+            {
+                ( void ) close( pxRecord->iFd[ x ] );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPerfCountersEndScheduler( void )
+{
+    PerfRecord_t * pxRecord;
+
+    #ifdef configPOSIX_PERF_COUNTERS_REPORT_FILE
+        /* Interrupts are already disabled. */
+        prvPerfCountersWrite( configPOSIX_PERF_COUNTERS_REPORT_FILE, configPOSIX_PERF_COUNTERS_REPORT_JSON );
+    #endif
+
+    /* Tasks that have not been deleted keep their counters open until the
+     * application deletes them, but no longer reference their record. */
+    while( pxPerfRecords != NULL )
+    {
+        pxRecord = pxPerfRecords;
+        pxPerfRecords = pxRecord->pxNext;
+
+        if( pxRecord->pxThread != NULL )
+        {
+            pxRecord->pxThread->pxPerf = NULL;
+        }
+
+        free( pxRecord );
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetTaskPerfCounters( void * pxTask,
+                                       PortPerfCounters_t * pxCounters )
+{
+    Thread_t * pxThread;
+    uint64_t ullCounts[ portPERF_COUNTER_COUNT ] = { 0 };
+    UBaseType_t uxAvailable = 0;
+    size_t x;
+
+    if( pxTask == NULL )
+    {
+        pxTask = xTaskGetCurrentTaskHandle();
+    }
+
+    pxThread = prvGetThreadFromTask( pxTask );
+
+    vPortEnterCritical();
+    {
+        if( pxThread->pxPerf != NULL )
+        {
+            prvPerfCountersRead( pxThread->pxPerf, ullCounts );
+
+            for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+            {
+                if( pxThread->pxPerf->iFd[ x ] >= 0 )
+                {
+                    uxAvailable |= ( UBaseType_t ) 1U << x;
+                }
+            }
+        }
+    }
+    vPortExitCritical();
+
+    pxCounters->ullCycles = ullCounts[ 0 ];
+    pxCounters->ullInstructions = ullCounts[ 1 ];
+    pxCounters->ullCacheMisses = ullCounts[ 2 ];
+    pxCounters->ullBranchMisses = ullCounts[ 3 ];
+
+    return uxAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPerfCountersWrite( const char * pcFileName,
+                                  BaseType_t xJson )
+{
+    static const char * const pcCounterNames[ portPERF_COUNTER_COUNT ] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+    const PerfRecord_t * pxRecord;
+    uint64_t ullCounts[ portPERF_COUNTER_COUNT ];
+    const char * pcName;
+    FILE * pxFile;
+    size_t x;
+
+    pxFile = fopen( pcFileName, "w" );
+
+    if( pxFile == NULL )
+    {
+        fprintf( stderr, "[WARN] Could not open %s for the perf counter report: %s\n", pcFileName, strerror( errno ) );
+    }
+    else
+    {
+        if( xJson != pdFALSE )
+        {
+            fprintf( pxFile, "[" );
+        }
+        else
+        {
+            fprintf( pxFile, "task,deleted" );
+
+            for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+            {
+                fprintf( pxFile, ",%s", pcCounterNames[ x ] );
+            }
+
+            fprintf( pxFile, "\n" );
+        }
+
+        for( pxRecord = pxPerfRecords; pxRecord != NULL; pxRecord = pxRecord->pxNext )
+        {
+            prvPerfCountersRead( pxRecord, ullCounts );
+
+            if( xJson != pdFALSE )
+            {
+                fprintf( pxFile, "%s\n  { \"task\": \"", ( pxRecord == pxPerfRecords ) ? "" : "," );
+
+                for( pcName = pxRecord->pcTaskName; *pcName != '\0'; pcName++ )
+                {
+                    if( ( *pcName == '"' ) || ( *pcName == '\\' ) )
+                    {
+                        fputc( '\\', pxFile );
+                    }
+
+                    fputc( *pcName, pxFile );
+                }
+
+                fprintf( pxFile, "\", \"deleted\": %s", ( pxRecord->pxThread == NULL ) ? "true" : "false" );
+
+                for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+                {
+                    if( pxRecord->iFd[ x ] >= 0 )
+                    {
+                        fprintf( pxFile, ", \"%s\": %llu", pcCounterNames[ x ], ( unsigned long long ) ullCounts[ x ] );
+                    }
+                    else
+                    {
+                        fprintf( pxFile, ", \"%s\": null", pcCounterNames[ x ] );
+                    }
+                }
+
+                fprintf( pxFile, " }" );
+            }
+            else
+            {
+                fprintf( pxFile, "%s,%d", pxRecord->pcTaskName, ( pxRecord->pxThread == NULL ) ? 1 : 0 );
+
+                /* Counters the host does not support are left empty. */
+                for( x = 0; x < portPERF_COUNTER_COUNT; x++ )
+                {
+                    if( pxRecord->iFd[ x ] >= 0 )
+                    {
+                        fprintf( pxFile, ",%llu", ( unsigned long long ) ullCounts[ x ] );
+                    }
+                    else
+                    {
+                        fprintf( pxFile, "," );
+                    }
+                }
+
+                fprintf( pxFile, "\n" );
+            }
+        }
+
+        if( xJson != pdFALSE )
+        {
+            fprintf( pxFile, "\n]\n" );
+        }
+
+        fclose( pxFile );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortWritePerfCounters( const char * pcFileName,
+                             BaseType_t xJson )
+{
+    /* stdio takes locks internally, so the task must not be switched out
+     * while writing the report. */
+    vPortEnterCritical();
+    {
+        prvPerfCountersWrite( pcFileName, xJson );
+    }
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_POSIX_PERF_COUNTERS */
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+static void * prvISRStimulusThread( void * pvParams )
+{
+    ISRStimulus_t * pxStimulus = pvParams;
+    Thread_t * pxThread;
+
+    prvPortSetCurrentThreadName( "Scheduler stimulus" );
+
+    while( pxStimulus->xShouldRun )
+    {
+        usleep( pxStimulus->ulPeriodMicroseconds );
+
+        /* As for the tick, signal the thread of the running task.  The flag
+         * tells the handler which stimuli are due, as signals of the same
+         * number are not queued. */
+        __atomic_store_n( &pxStimulus->xPending, true, __ATOMIC_RELEASE );
+        pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        pthread_kill( pxThread->pthread, SIG_STIMULUS );
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvISRStimulusHandler( int sig )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+    PortISRStimulusHandler_t pxHandler;
+    BaseType_t xSwitchRequired = pdFALSE;
+    UBaseType_t uxSourceID, uxSavedSource;
+
+    ( void ) sig;
+
+    uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+    pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    for( uxSourceID = 0; uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES; uxSourceID++ )
+    {
+        pxHandler = xISRStimuli[ uxSourceID ].pxHandler;
+
+        if( __atomic_exchange_n( &xISRStimuli[ uxSourceID ].xPending, false, __ATOMIC_ACQ_REL ) && ( pxHandler != NULL ) )
+        {
+            uxSavedSource = uxTaskSetISRWakeSourceFromISR( uxSourceID );
+
+            if( pxHandler() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+
+            vTaskRestoreISRWakeSourceFromISR( uxSavedSource );
+        }
+    }
+
+    /* Switch once the source has been restored, as portYIELD_FROM_ISR() would
+     * on hardware, so the task switched to is not attributed to the source. */
+    if( xSwitchRequired != pdFALSE )
+    {
+        vTaskSwitchContext();
+
+        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    }
+
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartISRStimulus( UBaseType_t uxSourceID,
+                                  PortISRStimulusHandler_t pxHandler,
+                                  uint32_t ulPeriodMicroseconds )
+{
+    ISRStimulus_t * pxStimulus;
+    BaseType_t xReturn = pdFAIL;
+
+    if( ( uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES ) &&
+        ( pxHandler != NULL ) &&
+        ( ulPeriodMicroseconds > 0U ) &&
+        ( xISRStimuli[ uxSourceID ].xShouldRun == false ) )
+    {
+        pxStimulus = &xISRStimuli[ uxSourceID ];
+        pxStimulus->pxHandler = pxHandler;
+        pxStimulus->ulPeriodMicroseconds = ulPeriodMicroseconds;
+        pxStimulus->xPending = false;
+        pxStimulus->xShouldRun = true;
+
+        if( pthread_create( &pxStimulus->xThread, NULL, prvISRStimulusThread, pxStimulus ) == 0 )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            pxStimulus->xShouldRun = false;
+            pxStimulus->pxHandler = NULL;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortStopISRStimulus( UBaseType_t uxSourceID )
+{
+    ISRStimulus_t * pxStimulus;
+
+    if( ( uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES ) &&
+        ( xISRStimuli[ uxSourceID ].xShouldRun != false ) )
+    {
+        pxStimulus = &xISRStimuli[ uxSourceID ];
+        pxStimulus->xShouldRun = false;
+        pthread_join( pxStimulus->xThread, NULL );
+
+        /* A signal already sent finds no handler. */
+        pxStimulus->pxHandler = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
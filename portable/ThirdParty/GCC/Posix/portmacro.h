@@ -140,9 +140,72 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  */
 #define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
 
-extern uint32_t ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
-#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
+/* The run time stats clock counts microseconds of CLOCK_MONOTONIC since the
+ * scheduler was started, so each task's run time counter is the wall time it
+ * spent in the Running state.  Set configRUN_TIME_COUNTER_TYPE to uint64_t, as
+ * a 32-bit counter wraps after about 71 minutes. */
+extern void vPortConfigureRunTimeClock( void );
+extern uint64_t ullPortGetRunTime( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortConfigureRunTimeClock()
+#define portGET_RUN_TIME_COUNTER_VALUE()            ( ( configRUN_TIME_COUNTER_TYPE ) ullPortGetRunTime() )
+
+/* Returns the CPU time, in microseconds, used by the thread that runs pxTask,
+ * or by the calling task if pxTask is NULL.  Unlike the run time counter this
+ * does not include time the thread was preempted by the host, so comparing
+ * the two shows how much the host is slowing the simulation down. */
+extern uint64_t ullPortGetTaskCpuTime( void * pxTask );
+
+/* When configUSE_POSIX_PERF_COUNTERS is 1, each task's thread opens Linux
+ * perf_event hardware counters when the task first runs.  The counters only
+ * count while that thread runs, so they attribute cycles, instructions, cache
+ * misses and branch misses to the task without any work at context switches.
+ * User space events only are counted.  uxPortGetTaskPerfCounters() reads the
+ * counts for pxTask, or for the calling task if pxTask is NULL, and returns a
+ * bitmask of the portPERF_* counters the host made available; the others read
+ * as zero.  vPortWritePerfCounters() writes the counts for every task that has
+ * run, including tasks since deleted, to pcFileName as CSV, or as JSON if
+ * xJson is pdTRUE.  If configPOSIX_PERF_COUNTERS_REPORT_FILE is defined the
+ * report is also written there when the scheduler ends, as JSON if
+ * configPOSIX_PERF_COUNTERS_REPORT_JSON is 1. */
+typedef struct PortPerfCounters
+{
+    uint64_t ullCycles;
+    uint64_t ullInstructions;
+    uint64_t ullCacheMisses;
+    uint64_t ullBranchMisses;
+} PortPerfCounters_t;
+
+#define portPERF_CYCLES          ( 1UL << 0 )
+#define portPERF_INSTRUCTIONS    ( 1UL << 1 )
+#define portPERF_CACHE_MISSES    ( 1UL << 2 )
+#define portPERF_BRANCH_MISSES   ( 1UL << 3 )
+
+extern UBaseType_t uxPortGetTaskPerfCounters( void * pxTask,
+                                              PortPerfCounters_t * pxCounters );
+extern void vPortWritePerfCounters( const char * pcFileName,
+                                    BaseType_t xJson );
+
+/* When configUSE_ISR_WAKE_LATENCY is 1, xPortStartISRStimulus() emulates a
+ * periodic interrupt, interrupt source uxSourceID, that calls pxHandler every
+ * ulPeriodMicroseconds from a signal handler on the thread of the running task,
+ * as the tick interrupt does.  pxHandler can call the *FromISR() API functions
+ * and returns pdTRUE if a context switch is required, in place of calling
+ * portYIELD_FROM_ISR().  The source is set with uxTaskSetISRWakeSourceFromISR()
+ * while pxHandler runs, so the time from pxHandler waking a task to the task
+ * running is recorded against the source, see vTaskGetISRWakeLatency().  Start
+ * stimuli once the scheduler is running.  vPortStopISRStimulus() stops one, and
+ * all are stopped when the scheduler ends. */
+typedef BaseType_t ( * PortISRStimulusHandler_t )( void );
+
+extern BaseType_t xPortStartISRStimulus( UBaseType_t uxSourceID,
+                                         PortISRStimulusHandler_t pxHandler,
+                                         uint32_t ulPeriodMicroseconds );
+extern void vPortStopISRStimulus( UBaseType_t uxSourceID );
+
+/* A monotonic clock in nanoseconds, truncated to 32 bits, used to time short
+ * intervals such as critical sections. */
+extern uint32_t ulPortGetHighResolutionTime( void );
+#define portGET_HIGH_RESOLUTION_TIME()              ulPortGetHighResolutionTime()
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -38,6 +38,10 @@
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_ARENAS == 1 )
+    #include "arena.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
 #endif
@@ -133,6 +137,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats;        /**< Contention and blocking statistics, see vQueueGetStats(). */
+        TickType_t xMutexTakenTick; /**< The tick count at which the mutex was last taken when the structure is used as a mutex. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -249,6 +258,27 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/*
+ * Frees the memory of a dynamically allocated queue.  Queues with no storage
+ * area were allocated from the kernel object pool, others from the heap.
+ */
+    static void prvFreeQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/*
+ * Adds the time a send or receive has waited, measured from xBlockStartTick,
+ * the tick count when it first found the queue full (or empty), to *pxTotal,
+ * and updates *pxMaximum.
+ */
+    static void prvRecordWaitTime( TickType_t * const pxTotal,
+                                   TickType_t * const pxMaximum,
+                                   const TickType_t xBlockStartTick ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -298,6 +328,60 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             ( pxQueue )->cRxLock = ( int8_t ) ( ( cRxLock ) + ( int8_t ) 1 ); \
         }                                                                     \
     } while( 0 )
+
+/*
+ * Macros to update the statistics of a queue.  Other than the _WAIT macros,
+ * which enter their own critical section, they must be called from a critical
+ * section or from an ISR with interrupts masked.  A send or receive that has
+ * to wait is counted as blocking once, however many times it enters the
+ * Blocked state before it completes or times out.  The _BLOCK macros latch the
+ * tick count into xBlockStartTick, as the timeout state is reset each time the
+ * task has to block again, so cannot be used to measure the whole wait.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    #define queueSTATS_RECORD_SEND( pxQueue )                                                           \
+    do {                                                                                                \
+        ( pxQueue )->xStats.ulSends++;                                                                  \
+        if( ( pxQueue )->uxMessagesWaiting > ( pxQueue )->xStats.uxPeakMessagesWaiting )                \
+        {                                                                                               \
+            ( pxQueue )->xStats.uxPeakMessagesWaiting = ( pxQueue )->uxMessagesWaiting;                 \
+        }                                                                                               \
+    } while( 0 )
+    #define queueSTATS_RECORD_RECEIVE( pxQueue )                 ( ( pxQueue )->xStats.ulReceives++ )
+    #define queueSTATS_RECORD_SEND_BLOCK( pxQueue, xBlockStartTick )                                    \
+    do {                                                                                                \
+        ( pxQueue )->xStats.ulSendBlocks++;                                                             \
+        ( xBlockStartTick ) = xTaskGetTickCount();                                                      \
+    } while( 0 )
+    #define queueSTATS_RECORD_RECEIVE_BLOCK( pxQueue, xBlockStartTick )                                 \
+    do {                                                                                                \
+        ( pxQueue )->xStats.ulReceiveBlocks++;                                                          \
+        ( xBlockStartTick ) = xTaskGetTickCount();                                                      \
+    } while( 0 )
+    #define queueSTATS_RECORD_SEND_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick )                      \
+    do {                                                                                                \
+        if( ( xEntryTimeSet ) != pdFALSE )                                                              \
+        {                                                                                               \
+            prvRecordWaitTime( &( ( pxQueue )->xStats.xSendWaitTicks ),                                 \
+                               &( ( pxQueue )->xStats.xMaxSendWaitTicks ), ( xBlockStartTick ) );       \
+        }                                                                                               \
+    } while( 0 )
+    #define queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick )                   \
+    do {                                                                                                \
+        if( ( xEntryTimeSet ) != pdFALSE )                                                              \
+        {                                                                                               \
+            prvRecordWaitTime( &( ( pxQueue )->xStats.xReceiveWaitTicks ),                              \
+                               &( ( pxQueue )->xStats.xMaxReceiveWaitTicks ), ( xBlockStartTick ) );    \
+        }                                                                                               \
+    } while( 0 )
+#else /* if ( configUSE_QUEUE_STATS == 1 ) */
+    #define queueSTATS_RECORD_SEND( pxQueue )
+    #define queueSTATS_RECORD_RECEIVE( pxQueue )
+    #define queueSTATS_RECORD_SEND_BLOCK( pxQueue, xBlockStartTick )
+    #define queueSTATS_RECORD_RECEIVE_BLOCK( pxQueue, xBlockStartTick )
+    #define queueSTATS_RECORD_SEND_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick )
+    #define queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick )
+#endif /* if ( configUSE_QUEUE_STATS == 1 ) */
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
@@ -441,6 +525,71 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ARENAS == 1 )
+
+    QueueHandle_t xQueueGenericCreateInArena( ArenaHandle_t xArena,
+                                              const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const uint8_t ucQueueType )
+    {
+        QueueHandle_t xNewQueue = NULL;
+        size_t xQueueSizeInBytes;
+        uint8_t * pucAllocatedMemory;
+        uint8_t * pucQueueStorage = NULL;
+
+        traceENTER_xQueueGenericCreateInArena( xArena, uxQueueLength, uxItemSize, ucQueueType );
+
+        configASSERT( xArena );
+
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            /* Check for multiplication overflow. */
+            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+            /* Check for addition overflow. */
+            ( ( UBaseType_t ) ( SIZE_MAX - portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) ) ) >= ( uxQueueLength * uxItemSize ) ) )
+        {
+            /* The queue structure and storage area are allocated together, as
+             * they are by xQueueGenericCreate(), then the queue is created as a
+             * statically allocated queue so deleting it does not attempt to free
+             * the arena's memory. */
+            xQueueSizeInBytes = ( size_t ) ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize );
+            pucAllocatedMemory = ( uint8_t * ) pvArenaMallocAligned( xArena, portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) ) + xQueueSizeInBytes, ( size_t ) configKERNEL_BUFFER_ALIGNMENT );
+
+            if( pucAllocatedMemory != NULL )
+            {
+                if( xQueueSizeInBytes > ( size_t ) 0 )
+                {
+                    pucQueueStorage = pucAllocatedMemory + portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                xNewQueue = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, ( StaticQueue_t * ) pucAllocatedMemory, ucQueueType );
+            }
+            else
+            {
+                traceQUEUE_CREATE_FAILED( ucQueueType );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            configASSERT( xNewQueue );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueGenericCreateInArena( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
     BaseType_t xQueueGenericGetStaticBuffers( QueueHandle_t xQueue,
@@ -509,11 +658,20 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 
         traceENTER_xQueueGenericCreate( uxQueueLength, uxItemSize, ucQueueType );
 
+        #if ( configUSE_ARENAS == 1 )
+            if( xTaskGetDefaultArena( NULL ) != NULL )
+            {
+                /* The calling task has a default arena, so the queue is created
+                 * in it. */
+                pxNewQueue = ( Queue_t * ) xQueueGenericCreateInArena( xTaskGetDefaultArena( NULL ), uxQueueLength, uxItemSize, ucQueueType );
+            }
+            else
+        #endif /* configUSE_ARENAS */
         if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
             /* Check for multiplication overflow. */
             ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
             /* Check for addition overflow. */
-            ( ( UBaseType_t ) ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+            ( ( UBaseType_t ) ( SIZE_MAX - portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) ) ) >= ( uxQueueLength * uxItemSize ) ) )
         {
             /* Allocate enough space to hold the maximum number of items that
              * can be in the queue at any time.  It is valid for uxItemSize to be
@@ -523,14 +681,23 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            if( xQueueSizeInBytes == ( size_t ) 0 )
+            {
+                /* Semaphores and mutexes have no storage area so are a fixed
+                 * size, and can come from the kernel object pool. */
+                pxNewQueue = ( Queue_t * ) pvPortMallocObject( eObjectPoolQueue, sizeof( Queue_t ) );
+            }
+            else
+            {
+                pxNewQueue = ( Queue_t * ) pvPortMallocKernelBuffer( eHeapPlacementQueue, portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) ) + xQueueSizeInBytes );
+            }
 
             if( pxNewQueue != NULL )
             {
                 /* Jump past the queue structure to find the location of the queue
                  * storage area. */
                 pucQueueStorage = ( uint8_t * ) pxNewQueue;
-                pucQueueStorage += sizeof( Queue_t );
+                pucQueueStorage += portKERNEL_BUFFER_OFFSET( sizeof( Queue_t ) );
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -559,6 +726,19 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 
         return pxNewQueue;
     }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeQueue( Queue_t * const pxQueue )
+    {
+        if( pxQueue->uxItemSize == queueSEMAPHORE_QUEUE_ITEM_LENGTH )
+        {
+            vPortFreeObject( eObjectPoolQueue, pxQueue );
+        }
+        else
+        {
+            vPortFree( pxQueue );
+        }
+    }
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
@@ -605,6 +785,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        ( void ) memset( &( pxNewQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+        pxNewQueue->xMutexTakenTick = ( TickType_t ) 0U;
+    }
+    #endif /* configUSE_QUEUE_STATS */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -684,6 +871,27 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_ARENAS == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexInArena( ArenaHandle_t xArena,
+                                            const uint8_t ucQueueType )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateMutexInArena( xArena, ucQueueType );
+
+        xNewQueue = xQueueGenericCreateInArena( xArena, uxMutexLength, uxMutexSize, ucQueueType );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateMutexInArena( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configUSE_ARENAS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -897,6 +1105,46 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configUSE_ARENAS == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphoreInArena( ArenaHandle_t xArena,
+                                                        const UBaseType_t uxMaxCount,
+                                                        const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphoreInArena( xArena, uxMaxCount, uxInitialCount );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateInArena( xArena, uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphoreInArena( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configUSE_ARENAS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
@@ -945,6 +1193,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+    #endif
+
     traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
 
     configASSERT( pxQueue );
@@ -1066,6 +1318,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                 taskEXIT_CRITICAL();
 
+                queueSTATS_RECORD_SEND_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceRETURN_xQueueGenericSend( pdPASS );
 
                 return pdPASS;
@@ -1080,6 +1333,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     /* Return to the original privilege level before exiting
                      * the function. */
+                    queueSTATS_RECORD_SEND_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                     traceQUEUE_SEND_FAILED( pxQueue );
                     traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
@@ -1091,6 +1345,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_RECORD_SEND_BLOCK( pxQueue, xBlockStartTick );
                 }
                 else
                 {
@@ -1145,6 +1400,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
+            queueSTATS_RECORD_SEND_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
             traceQUEUE_SEND_FAILED( pxQueue );
             traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
@@ -1391,6 +1647,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * priority disinheritance is needed.  Simply increase the count of
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+            queueSTATS_RECORD_SEND( pxQueue );
 
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
@@ -1507,6 +1764,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+    #endif
+
     traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
     /* Check the pointer is not NULL. */
@@ -1536,6 +1797,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
+                queueSTATS_RECORD_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
 
                 /* There is now space in the queue, were any tasks waiting to
@@ -1559,6 +1821,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
                 taskEXIT_CRITICAL();
 
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceRETURN_xQueueReceive( pdPASS );
 
                 return pdPASS;
@@ -1571,6 +1834,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
 
+                    queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
                     traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
@@ -1582,6 +1846,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_RECORD_RECEIVE_BLOCK( pxQueue, xBlockStartTick );
                 }
                 else
                 {
@@ -1635,6 +1900,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
@@ -1656,6 +1922,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+    #endif
+
     #if ( configUSE_MUTEXES == 1 )
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
@@ -1689,6 +1959,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
             if( uxSemaphoreCount > ( UBaseType_t ) 0 )
             {
                 traceQUEUE_RECEIVE( pxQueue );
+                queueSTATS_RECORD_RECEIVE( pxQueue );
 
                 /* Semaphores are queues with a data size of zero and where the
                  * messages waiting is the semaphore's count.  Reduce the count. */
@@ -1701,6 +1972,12 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_QUEUE_STATS == 1 )
+                        {
+                            pxQueue->xMutexTakenTick = xTaskGetTickCount();
+                        }
+                        #endif
                     }
                     else
                     {
@@ -1729,6 +2006,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 taskEXIT_CRITICAL();
 
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceRETURN_xQueueSemaphoreTake( pdPASS );
 
                 return pdPASS;
@@ -1741,6 +2019,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * (or the block time has expired) so exit now. */
                     taskEXIT_CRITICAL();
 
+                    queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
                     traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
 
@@ -1752,6 +2031,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * so configure the timeout structure ready to block. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_RECORD_RECEIVE_BLOCK( pxQueue, xBlockStartTick );
                 }
                 else
                 {
@@ -1786,6 +2066,15 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         taskENTER_CRITICAL();
                         {
                             xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+                            #if ( configUSE_QUEUE_STATS == 1 )
+                            {
+                                if( xInheritanceOccurred != pdFALSE )
+                                {
+                                    pxQueue->xStats.ulPriorityInheritances++;
+                                }
+                            }
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1860,6 +2149,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_MUTEXES */
 
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
 
@@ -1883,6 +2173,10 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
     int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+    #endif
+
     traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
 
     /* Check the pointer is not NULL. */
@@ -1941,6 +2235,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
                 taskEXIT_CRITICAL();
 
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceRETURN_xQueuePeek( pdPASS );
 
                 return pdPASS;
@@ -1953,6 +2248,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
 
+                    queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                     traceQUEUE_PEEK_FAILED( pxQueue );
                     traceRETURN_xQueuePeek( errQUEUE_EMPTY );
 
@@ -1965,6 +2261,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                      * state. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_RECORD_RECEIVE_BLOCK( pxQueue, xBlockStartTick );
                 }
                 else
                 {
@@ -2018,6 +2315,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                queueSTATS_RECORD_RECEIVE_WAIT( pxQueue, xEntryTimeSet, xBlockStartTick );
                 traceQUEUE_PEEK_FAILED( pxQueue );
                 traceRETURN_xQueuePeek( errQUEUE_EMPTY );
 
@@ -2074,6 +2372,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             const int8_t cRxLock = pxQueue->cRxLock;
 
             traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            queueSTATS_RECORD_RECEIVE( pxQueue );
 
             prvCopyDataFromQueue( pxQueue, pvBuffer );
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
@@ -2270,7 +2569,7 @@ void vQueueDelete( QueueHandle_t xQueue )
     {
         /* The queue can only have been allocated dynamically - free it
          * again. */
-        vPortFree( pxQueue );
+        prvFreeQueue( pxQueue );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -2278,7 +2577,7 @@ void vQueueDelete( QueueHandle_t xQueue )
          * check before attempting to free the memory. */
         if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxQueue );
+            prvFreeQueue( pxQueue );
         }
         else
         {
@@ -2404,6 +2703,22 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         {
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
+                #if ( configUSE_QUEUE_STATS == 1 )
+                {
+                    if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                    {
+                        const TickType_t xHeldTicks = xTaskGetTickCount() - pxQueue->xMutexTakenTick;
+
+                        pxQueue->xStats.xMutexHoldTicks += xHeldTicks;
+
+                        if( xHeldTicks > pxQueue->xStats.xMaxMutexHoldTicks )
+                        {
+                            pxQueue->xStats.xMaxMutexHoldTicks = xHeldTicks;
+                        }
+                    }
+                }
+                #endif /* configUSE_QUEUE_STATS */
+
                 /* The mutex is no longer being held. */
                 xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
@@ -2465,6 +2780,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
 
     pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+    queueSTATS_RECORD_SEND( pxQueue );
 
     return xReturn;
 }
@@ -3127,6 +3443,155 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    static void prvRecordWaitTime( TickType_t * const pxTotal,
+                                   TickType_t * const pxMaximum,
+                                   const TickType_t xBlockStartTick )
+    {
+        TickType_t xWaitedTicks;
+
+        taskENTER_CRITICAL();
+        {
+            /* Unsigned arithmetic gives the correct result across a single
+             * overflow of the tick count. */
+            xWaitedTicks = xTaskGetTickCount() - xBlockStartTick;
+            *pxTotal += xWaitedTicks;
+
+            if( xWaitedTicks > *pxMaximum )
+            {
+                *pxMaximum = xWaitedTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats )
+    {
+        const Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueGetStats( xQueue, pxStats );
+
+        configASSERT( pxQueue );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = pxQueue->xStats;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vQueueGetStats();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueResetStats( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueResetStats( xQueue );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+            pxQueue->xStats.uxPeakMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* A mutex that is currently held starts a new hold period so the
+             * time it was held before the reset is not counted. */
+            pxQueue->xMutexTakenTick = xTaskGetTickCount();
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vQueueResetStats();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t * const pxStatsArray,
+                                         const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux;
+        UBaseType_t uxCount = 0;
+        const Queue_t * pxQueue;
+
+        traceENTER_uxQueueGetRegistryStats( pxStatsArray, uxArraySize );
+
+        configASSERT( pxStatsArray );
+
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            /* Each entry is copied in its own critical section to keep the
+             * time interrupts are disabled short.  A queue must be removed
+             * from the registry before it is deleted, so checking the entry
+             * again inside the critical section is enough to know the queue
+             * still exists. */
+            taskENTER_CRITICAL();
+            {
+                if( xQueueRegistry[ ux ].pcQueueName != NULL )
+                {
+                    if( uxCount < uxArraySize )
+                    {
+                        pxQueue = xQueueRegistry[ ux ].xHandle;
+
+                        pxStatsArray[ uxCount ].xHandle = xQueueRegistry[ ux ].xHandle;
+                        pxStatsArray[ uxCount ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                        pxStatsArray[ uxCount ].uxLength = pxQueue->uxLength;
+                        pxStatsArray[ uxCount ].uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+                        pxStatsArray[ uxCount ].xStats = pxQueue->xStats;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Keep counting when the array is full so a caller that
+                     * passed too small an array can be told so. */
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( uxCount > uxArraySize )
+        {
+            uxCount = 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxQueueGetRegistryStats( uxCount );
+
+        return uxCount;
+    }
+
+#endif /* ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
     void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
@@ -39,6 +39,10 @@
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( configUSE_ARENAS == 1 )
+    #include "arena.h"
+#endif
+
 #if ( configUSE_TASK_NOTIFICATIONS != 1 )
     #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -249,6 +253,15 @@ typedef struct StreamBufferDef_t
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
     UBaseType_t uxNotificationIndex;                               /* The index we are using for notification, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+
+    #if ( configUSE_SB_MAX_LATENCY == 1 )
+        TickType_t xMaxLatencyTicks;       /* The longest data can wait in a batching buffer before a waiting reader is unblocked, or 0 for no limit. */
+        volatile TickType_t xDataTimeStamp; /* The tick count at which the buffer last went from empty to not empty. */
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        StreamBufferStats_t xStats; /* Contention and blocking statistics, see vStreamBufferGetStats(). */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -314,6 +327,16 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by the task reading from the buffer.  Blocks for up to xTicksToWait
+ * ticks until the number of bytes in the buffer exceeds xBytesToWaitBeyond, then
+ * returns the number of bytes in the buffer, which may not exceed
+ * xBytesToWaitBeyond if the block time expired.
+ */
+static size_t prvWaitForBytesToRead( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xBytesToWaitBeyond,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -326,6 +349,57 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                           StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_SB_MAX_LATENCY == 1 )
+
+/*
+ * Called by a writer before writing to the buffer.  If the buffer has a
+ * maximum latency and is currently empty then the time at which the data is
+ * being written is recorded, and pdTRUE is returned to indicate a blocked
+ * reader must be notified even if the trigger level is not reached, so it can
+ * recalculate its block time from the age of the data.  Otherwise returns
+ * pdFALSE.
+ */
+    static BaseType_t prvRecordDataTimeStamp( StreamBuffer_t * const pxStreamBuffer,
+                                              const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes the number of bytes in the buffer must exceed
+ * before a reader can read from it, given that it would be xBytesToWaitFor
+ * without a maximum latency.  That is 0 if the data in the buffer has been
+ * waiting for at least the buffer's maximum latency.  Otherwise, if
+ * pxTicksToBlock is not NULL, it is reduced to the time left until the data has
+ * waited for the maximum latency.
+ */
+    static size_t prvApplyMaxLatency( const StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesAvailable,
+                                      size_t xBytesToWaitFor,
+                                      TickType_t xTickCount,
+                                      TickType_t * const pxTicksToBlock ) PRIVILEGED_FUNCTION;
+#else
+    #define prvRecordDataTimeStamp( pxStreamBuffer, xFromISR )                                             ( pdFALSE )
+    #define prvApplyMaxLatency( pxStreamBuffer, xBytesAvailable, xBytesToWaitFor, xTickCount, pxTicksToBlock )    ( xBytesToWaitFor )
+#endif /* configUSE_SB_MAX_LATENCY */
+
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+/*
+ * Adds the time since xBlockStartTick to *pxTotal and updates *pxMaximum.
+ * Only called by the writer for the send statistics and by the reader for the
+ * receive statistics, so needs no critical section.
+ */
+    static void prvRecordWaitTime( TickType_t * const pxTotal,
+                                   TickType_t * const pxMaximum,
+                                   const TickType_t xBlockStartTick ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a writer after it has written to the buffer to count the send and
+ * update the peak number of bytes waiting.
+ */
+    static void prvRecordSend( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+#else
+    #define prvRecordSend( pxStreamBuffer )
+#endif /* configUSE_STREAM_BUFFER_STATS */
+
 /*-----------------------------------------------------------*/
     #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
     StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
@@ -379,10 +453,25 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
          * this is a quirk of the implementation that means otherwise the free
          * space would be reported as one byte smaller than would be logically
          * expected. */
-        if( xBufferSizeBytes < ( xBufferSizeBytes + 1U + sizeof( StreamBuffer_t ) ) )
+        if( xBufferSizeBytes < ( xBufferSizeBytes + 1U + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ) ) )
         {
             xBufferSizeBytes++;
-            pvAllocatedMemory = pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) );
+
+            #if ( configUSE_ARENAS == 1 )
+                if( xTaskGetDefaultArena( NULL ) != NULL )
+                {
+                    /* The calling task has a default arena, so the stream buffer
+                     * is allocated from it, and treated as statically allocated
+                     * so deleting it does not attempt to free the arena's
+                     * memory. */
+                    pvAllocatedMemory = pvArenaMallocAligned( xTaskGetDefaultArena( NULL ), xBufferSizeBytes + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ), ( size_t ) configKERNEL_BUFFER_ALIGNMENT );
+                    ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
+                }
+                else
+            #endif /* configUSE_ARENAS */
+            {
+                pvAllocatedMemory = pvPortMallocKernelBuffer( eHeapPlacementStreamBuffer, xBufferSizeBytes + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ) );
+            }
         }
         else
         {
@@ -398,7 +487,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                                                                                           /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                                                                                                           /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                                                                                                           /* coverity[misra_c_2012_rule_11_5_violation] */
-                                          ( ( uint8_t * ) pvAllocatedMemory ) + sizeof( StreamBuffer_t ), /* Storage area follows. */
+                                          ( ( uint8_t * ) pvAllocatedMemory ) + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ), /* Storage area follows. */
                                           xBufferSizeBytes,
                                           xTriggerLevelBytes,
                                           ucFlags,
@@ -519,6 +608,59 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
     #endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ARENAS == 1 )
+    StreamBufferHandle_t xStreamBufferGenericCreateInArena( ArenaHandle_t xArena,
+                                                            size_t xBufferSizeBytes,
+                                                            size_t xTriggerLevelBytes,
+                                                            BaseType_t xStreamBufferType,
+                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+    {
+        uint8_t * pucAllocatedMemory = NULL;
+        StreamBufferHandle_t xReturn = NULL;
+
+        traceENTER_xStreamBufferGenericCreateInArena( xArena, xBufferSizeBytes, xTriggerLevelBytes, xStreamBufferType, pxSendCompletedCallback, pxReceiveCompletedCallback );
+
+        configASSERT( xArena );
+
+        /* The structure and the buffer are allocated together, and the size is
+         * incremented, as they are by xStreamBufferGenericCreate().  The stream
+         * buffer is then created as a statically allocated stream buffer, so
+         * deleting it does not attempt to free the arena's memory. */
+        if( xBufferSizeBytes < ( xBufferSizeBytes + 1U + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ) ) )
+        {
+            pucAllocatedMemory = ( uint8_t * ) pvArenaMallocAligned( xArena, xBufferSizeBytes + 1U + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ), ( size_t ) configKERNEL_BUFFER_ALIGNMENT );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            xReturn = xStreamBufferGenericCreateStatic( xBufferSizeBytes + 1U,
+                                                        xTriggerLevelBytes,
+                                                        xStreamBufferType,
+                                                        pucAllocatedMemory + portKERNEL_BUFFER_OFFSET( sizeof( StreamBuffer_t ) ),
+                                                        ( StaticStreamBuffer_t * ) pucAllocatedMemory,
+                                                        pxSendCompletedCallback,
+                                                        pxReceiveCompletedCallback );
+        }
+        else
+        {
+            traceSTREAM_BUFFER_CREATE_FAILED( xStreamBufferType );
+        }
+
+        traceRETURN_xStreamBufferGenericCreateInArena( xReturn );
+
+        return xReturn;
+    }
+    #endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
     BaseType_t xStreamBufferGetStaticBuffers( StreamBufferHandle_t xStreamBuffer,
                                               uint8_t ** ppucStreamBufferStorageArea,
@@ -601,6 +743,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_SB_MAX_LATENCY == 1 )
+        TickType_t xMaxLatencyTicks;
+    #endif
+
     traceENTER_xStreamBufferReset( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -625,6 +771,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_SB_MAX_LATENCY == 1 )
+            {
+                xMaxLatencyTicks = pxStreamBuffer->xMaxLatencyTicks;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -639,6 +791,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_SB_MAX_LATENCY == 1 )
+            {
+                pxStreamBuffer->xMaxLatencyTicks = xMaxLatencyTicks;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -663,6 +821,10 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_SB_MAX_LATENCY == 1 )
+        TickType_t xMaxLatencyTicks;
+    #endif
+
     traceENTER_xStreamBufferResetFromISR( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -690,6 +852,12 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_SB_MAX_LATENCY == 1 )
+            {
+                xMaxLatencyTicks = pxStreamBuffer->xMaxLatencyTicks;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -704,6 +872,12 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_SB_MAX_LATENCY == 1 )
+            {
+                pxStreamBuffer->xMaxLatencyTicks = xMaxLatencyTicks;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET_FROM_ISR( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -751,6 +925,85 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SB_MAX_LATENCY == 1 )
+
+    BaseType_t xStreamBufferSetMaxLatency( StreamBufferHandle_t xStreamBuffer,
+                                           TickType_t xMaxLatencyTicks )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        traceENTER_xStreamBufferSetMaxLatency( xStreamBuffer, xMaxLatencyTicks );
+
+        configASSERT( pxStreamBuffer );
+
+        /* Only a batching buffer holds data back from a reader that could
+         * otherwise read it. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* If there is already data in the buffer then its age is
+                 * measured from now. */
+                pxStreamBuffer->xDataTimeStamp = xTaskGetTickCount();
+                pxStreamBuffer->xMaxLatencyTicks = xMaxLatencyTicks;
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xStreamBufferSetMaxLatency( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SB_MAX_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                StreamBufferStats_t * pxStats )
+    {
+        const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferGetStats( xStreamBuffer, pxStats );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxStats );
+
+        *pxStats = pxStreamBuffer->xStats;
+
+        traceRETURN_vStreamBufferGetStats();
+    }
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferResetStats( xStreamBuffer );
+
+        configASSERT( pxStreamBuffer );
+
+        ( void ) memset( &( pxStreamBuffer->xStats ), 0x00, sizeof( StreamBufferStats_t ) );
+        pxStreamBuffer->xStats.xPeakBytesWaiting = prvBytesInBuffer( pxStreamBuffer );
+
+        traceRETURN_vStreamBufferResetStats();
+    }
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
 {
     const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -815,6 +1068,12 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     size_t xRequiredSpace = xDataLengthBytes;
     TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
+    BaseType_t xNotifyReceiver;
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+        BaseType_t xBlocked = pdFALSE;
+    #endif
 
     traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
 
@@ -894,9 +1153,38 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
             taskEXIT_CRITICAL();
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+
+            #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+            {
+                if( xBlocked == pdFALSE )
+                {
+                    xBlocked = pdTRUE;
+                    xBlockStartTick = xTaskGetTickCount();
+                    pxStreamBuffer->xStats.ulSendBlocks++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_STREAM_BUFFER_STATS */
+
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+
+        #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                prvRecordWaitTime( &( pxStreamBuffer->xStats.xSendWaitTicks ), &( pxStreamBuffer->xStats.xMaxSendWaitTicks ), xBlockStartTick );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_STREAM_BUFFER_STATS */
     }
     else
     {
@@ -912,14 +1200,16 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
+    xNotifyReceiver = prvRecordDataTimeStamp( pxStreamBuffer, pdFALSE );
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
     if( xReturn > ( size_t ) 0 )
     {
         traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+        prvRecordSend( pxStreamBuffer );
 
         /* Was a task waiting for the data? */
-        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        if( ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) || ( xNotifyReceiver != pdFALSE ) )
         {
             prvSEND_COMPLETED( pxStreamBuffer );
         }
@@ -948,6 +1238,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
+    BaseType_t xNotifyReceiver;
 
     traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
 
@@ -968,12 +1259,15 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     }
 
     xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    xNotifyReceiver = prvRecordDataTimeStamp( pxStreamBuffer, pdTRUE );
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
     if( xReturn > ( size_t ) 0 )
     {
+        prvRecordSend( pxStreamBuffer );
+
         /* Was a task waiting for the data? */
-        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        if( ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) || ( xNotifyReceiver != pdFALSE ) )
         {
             /* MISRA Ref 4.7.1 [Return value shall be checked] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
@@ -1083,46 +1377,30 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
+    xBytesAvailable = prvWaitForBytesToRead( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
+     * holds the number of bytes used to store the message length) or a stream of
+     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+     * available must be greater than xBytesToStoreMessageLength to be able to
+     * read bytes from the buffer.  A stream batching buffer whose data has waited
+     * for longer than its maximum latency can be read from regardless. */
+    if( xBytesAvailable > prvApplyMaxLatency( pxStreamBuffer, xBytesAvailable, xBytesToStoreMessageLength, xTaskGetTickCount(), NULL ) )
     {
-        /* Checking if there is data and clearing the notification state must be
-         * performed atomically. */
-        taskENTER_CRITICAL();
-        {
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
 
-            /* If this function was invoked by a message buffer read then
-             * xBytesToStoreMessageLength holds the number of bytes used to hold
-             * the length of the next discrete message.  If this function was
-             * invoked by a stream buffer read then xBytesToStoreMessageLength will
-             * be 0. If this function was invoked by a stream batch buffer read
-             * then xBytesToStoreMessageLength will be xTriggerLevelBytes value
-             * for the buffer.*/
-            if( xBytesAvailable <= xBytesToStoreMessageLength )
-            {
-                /* Clear notification state as going to wait for data. */
-                ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
 
-                /* Should only be one reader. */
-                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-            }
-            else
+            #if ( configUSE_STREAM_BUFFER_STATS == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxStreamBuffer->xStats.ulReceives++;
             }
-        }
-        taskEXIT_CRITICAL();
-
-        if( xBytesAvailable <= xBytesToStoreMessageLength )
-        {
-            /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            #endif
 
-            /* Recheck the data available after blocking. */
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
         }
         else
         {
@@ -1131,38 +1409,223 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     }
     else
     {
-        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        mtCOVERAGE_TEST_MARKER();
     }
 
-    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
-     * holds the number of bytes used to store the message length) or a stream of
-     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-     * available must be greater than xBytesToStoreMessageLength to be able to
-     * read bytes from the buffer. */
-    if( xBytesAvailable > xBytesToStoreMessageLength )
+    traceRETURN_xStreamBufferReceive( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvRxData,
+                                     size_t xBufferLengthBytes,
+                                     MessageBufferRecord_t * const pxRecords,
+                                     size_t xMaxRecords,
+                                     TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReceivedMessages = 0, xReceivedLength = 0, xBytesAvailable, xNextMessageLength, xNextTail, xMessageTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+    traceENTER_xStreamBufferReceiveMessages( xStreamBuffer, pvRxData, xBufferLengthBytes, pxRecords, xMaxRecords, xTicksToWait );
+
+    configASSERT( pvRxData );
+    configASSERT( pxRecords );
+    configASSERT( pxStreamBuffer );
+
+    /* Only message buffers hold discrete messages. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForBytesToRead( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTicksToWait );
+    xNextTail = pxStreamBuffer->xTail;
+
+    /* Copy out complete messages until there are no more, the next one does
+     * not fit, or xMaxRecords have been copied.  xTail is not updated until
+     * all the messages have been copied, so the writer sees the space they
+     * occupied become free in one go. */
+    while( ( xReceivedMessages < xMaxRecords ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        xMessageTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+        xNextMessageLength = ( size_t ) xTempNextMessageLength;
 
-        /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+        if( xNextMessageLength <= ( xBufferLengthBytes - xReceivedLength ) )
         {
-            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-            prvRECEIVE_COMPLETED( xStreamBuffer );
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, &( ( ( uint8_t * ) pvRxData )[ xReceivedLength ] ), xNextMessageLength, xMessageTail );
+
+            pxRecords[ xReceivedMessages ].xOffset = xReceivedLength;
+            pxRecords[ xReceivedMessages ].xLength = xNextMessageLength;
+            xReceivedMessages++;
+            xReceivedLength += xNextMessageLength;
+            xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH + xNextMessageLength;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* The next message does not fit in the space remaining, so leave
+             * it in the message buffer. */
+            xBytesAvailable = 0;
         }
     }
+
+    if( xReceivedMessages != ( size_t ) 0 )
+    {
+        pxStreamBuffer->xTail = xNextTail;
+
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+
+        #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        {
+            pxStreamBuffer->xStats.ulReceives++;
+        }
+        #endif
+
+        /* Was a task waiting for space in the buffer? */
+        prvRECEIVE_COMPLETED( xStreamBuffer );
+    }
     else
     {
         traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
         mtCOVERAGE_TEST_MARKER();
     }
 
-    traceRETURN_xStreamBufferReceive( xReceivedLength );
+    traceRETURN_xStreamBufferReceiveMessages( xReceivedMessages );
 
-    return xReceivedLength;
+    return xReceivedMessages;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForBytesToRead( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xBytesToWaitBeyond,
+                                     TickType_t xTicksToWait )
+{
+    size_t xBytesAvailable, xBytesToWaitFor;
+    TickType_t xTicksToBlock;
+    BaseType_t xKeepWaiting;
+
+    #if ( configUSE_SB_MAX_LATENCY == 1 )
+        TimeOut_t xTimeOut;
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStartTick = 0;
+        BaseType_t xBlocked = pdFALSE;
+    #endif
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        #if ( configUSE_SB_MAX_LATENCY == 1 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+        }
+        #endif
+
+        do
+        {
+            xKeepWaiting = pdFALSE;
+            xTicksToBlock = xTicksToWait;
+
+            /* Checking if there is data and clearing the notification state must be
+             * performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                /* For a message buffer xBytesToWaitBeyond holds the number of
+                 * bytes used to hold the length of the next discrete message.
+                 * For a stream buffer xBytesToWaitBeyond will be 0.  For a
+                 * stream batching buffer xBytesToWaitBeyond will be the
+                 * xTriggerLevelBytes value for the buffer, unless the data in the
+                 * buffer has been waiting for longer than the buffer's maximum
+                 * latency. */
+                xBytesToWaitFor = prvApplyMaxLatency( pxStreamBuffer, xBytesAvailable, xBytesToWaitBeyond, xTaskGetTickCount(), &xTicksToBlock );
+
+                if( xBytesAvailable <= xBytesToWaitFor )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xBytesToWaitFor )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+
+                #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+                {
+                    if( xBlocked == pdFALSE )
+                    {
+                        xBlocked = pdTRUE;
+                        xBlockStartTick = xTaskGetTickCount();
+                        pxStreamBuffer->xStats.ulReceiveBlocks++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_STREAM_BUFFER_STATS */
+
+                ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToBlock );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                #if ( configUSE_SB_MAX_LATENCY == 1 )
+                {
+                    /* With a maximum latency the task is also notified when
+                     * data first arrives, and may have blocked for less than
+                     * xTicksToWait, so keep waiting until the data can be read
+                     * or xTicksToWait has passed. */
+                    if( ( pxStreamBuffer->xMaxLatencyTicks != ( TickType_t ) 0 ) &&
+                        ( xBytesAvailable <= prvApplyMaxLatency( pxStreamBuffer, xBytesAvailable, xBytesToWaitBeyond, xTaskGetTickCount(), NULL ) ) &&
+                        ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) )
+                    {
+                        xKeepWaiting = pdTRUE;
+                    }
+                }
+                #endif /* configUSE_SB_MAX_LATENCY */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } while( xKeepWaiting != pdFALSE );
+
+        #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                prvRecordWaitTime( &( pxStreamBuffer->xStats.xReceiveWaitTicks ), &( pxStreamBuffer->xStats.xMaxReceiveWaitTicks ), xBlockStartTick );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_STREAM_BUFFER_STATS */
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    return xBytesAvailable;
 }
 /*-----------------------------------------------------------*/
 
@@ -1251,6 +1714,12 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
         /* Was a task waiting for space in the buffer? */
         if( xReceivedLength != ( size_t ) 0 )
         {
+            #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+            {
+                pxStreamBuffer->xStats.ulReceives++;
+            }
+            #endif
+
             /* MISRA Ref 4.7.1 [Return value shall be checked] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
             /* coverity[misra_c_2012_directive_4_7_violation] */
@@ -1632,6 +2101,121 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SB_MAX_LATENCY == 1 )
+
+    static BaseType_t prvRecordDataTimeStamp( StreamBuffer_t * const pxStreamBuffer,
+                                              const BaseType_t xFromISR )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* The time stamp is written before the new data is made visible to the
+         * reader by the update of xHead, so the reader never sees data with a
+         * stale time stamp. */
+        if( ( pxStreamBuffer->xMaxLatencyTicks != ( TickType_t ) 0 ) && ( pxStreamBuffer->xHead == pxStreamBuffer->xTail ) )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                pxStreamBuffer->xDataTimeStamp = xTaskGetTickCountFromISR();
+            }
+            else
+            {
+                pxStreamBuffer->xDataTimeStamp = xTaskGetTickCount();
+            }
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvApplyMaxLatency( const StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesAvailable,
+                                      size_t xBytesToWaitFor,
+                                      TickType_t xTickCount,
+                                      TickType_t * const pxTicksToBlock )
+    {
+        TickType_t xDataAge;
+
+        if( ( pxStreamBuffer->xMaxLatencyTicks != ( TickType_t ) 0 ) &&
+            ( xBytesAvailable != ( size_t ) 0 ) &&
+            ( xBytesAvailable <= xBytesToWaitFor ) )
+        {
+            xDataAge = xTickCount - pxStreamBuffer->xDataTimeStamp;
+
+            if( xDataAge >= pxStreamBuffer->xMaxLatencyTicks )
+            {
+                /* The data has waited long enough - read whatever there is. */
+                xBytesToWaitFor = 0;
+            }
+            else if( ( pxTicksToBlock != NULL ) && ( *pxTicksToBlock > ( pxStreamBuffer->xMaxLatencyTicks - xDataAge ) ) )
+            {
+                *pxTicksToBlock = pxStreamBuffer->xMaxLatencyTicks - xDataAge;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xBytesToWaitFor;
+    }
+
+#endif /* configUSE_SB_MAX_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+    static void prvRecordWaitTime( TickType_t * const pxTotal,
+                                   TickType_t * const pxMaximum,
+                                   const TickType_t xBlockStartTick )
+    {
+        /* Unsigned arithmetic gives the correct result across a single
+         * overflow of the tick count. */
+        const TickType_t xWaitedTicks = xTaskGetTickCount() - xBlockStartTick;
+
+        *pxTotal += xWaitedTicks;
+
+        if( xWaitedTicks > *pxMaximum )
+        {
+            *pxMaximum = xWaitedTicks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordSend( StreamBuffer_t * const pxStreamBuffer )
+    {
+        const size_t xBytesWaiting = prvBytesInBuffer( pxStreamBuffer );
+
+        pxStreamBuffer->xStats.ulSends++;
+
+        /* The reader may have removed data since it was written, in which
+         * case the peak is under reported, but never over reported. */
+        if( xBytesWaiting > pxStreamBuffer->xStats.xPeakBytesWaiting )
+        {
+            pxStreamBuffer->xStats.xPeakBytesWaiting = xBytesWaiting;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxStreamBufferGetStreamBufferNotificationIndex( StreamBufferHandle_t xStreamBuffer )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -41,6 +41,14 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_ARENAS == 1 )
+    #include "arena.h"
+#endif
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    #include "critical_profiler.h"
+#endif
+
 /* The default definitions are only available for non-MPU ports. The
  * reason is that the stack alignment requirements vary for different
  * architectures.*/
@@ -119,6 +127,39 @@
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
 
+/* tskSTACK_FILL_BYTE repeated in every byte of a StackType_t, so the high water
+ * mark can be found by comparing a whole stack word at a time. */
+#define tskSTACK_FILL_WORD                        ( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE ) )
+
+#if ( configUSE_LAZY_STACK_FILL == 1 )
+
+/* The number of words at the far end of a new task's stack that are filled
+ * when the task is created.  This covers the region checked when
+ * configCHECK_FOR_STACK_OVERFLOW is 2. */
+    #define tskSTACK_GUARD_WORDS         ( ( configSTACK_DEPTH_TYPE ) ( ( 32U + sizeof( StackType_t ) - 1U ) / sizeof( StackType_t ) ) )
+
+/* The largest number of words filled inside one critical section when the rest
+ * of a stack is filled lazily. */
+    #define tskSTACK_FILL_CHUNK_WORDS    ( ( configSTACK_DEPTH_TYPE ) 256U )
+
+#endif /* configUSE_LAZY_STACK_FILL */
+
+#if ( configUSE_TASK_SINGLE_ALLOCATION == 1 )
+
+/* Rounds a size up so the block that follows it is correctly aligned. */
+    #define tskALIGN_SIZE( xSize )    ( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The start of the single block holding the stack and TCB of a dynamically
+ * allocated task.  The stack comes first if it grows down, so it cannot grow
+ * into the TCB, and the TCB comes first if the stack grows up. */
+    #if ( portSTACK_GROWTH < 0 )
+        #define tskTASK_BLOCK_START( pxTCB )    ( ( void * ) ( ( pxTCB )->pxStack ) )
+    #else
+        #define tskTASK_BLOCK_START( pxTCB )    ( ( void * ) ( pxTCB ) )
+    #endif
+
+#endif /* configUSE_TASK_SINGLE_ALLOCATION */
+
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
@@ -261,6 +302,83 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_PRIORITY_INVERSION_STATS == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) )
+
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define taskGET_RUN_TIME_COUNTER_VALUE( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+    #else
+        #define taskGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+
+#endif
+
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+
+/*
+ * Record the time at which the task pxTCB entered the Ready state, so the time
+ * until it runs can be recorded when it is switched in.  A task that is already
+ * waiting to run keeps its original time, and a task that is moved between
+ * ready lists while it is running, for example by a priority change, is not
+ * waiting to run.  Tasks made ready before the scheduler starts are not
+ * timed, as the run time stats clock may not be running yet.
+ */
+    #define taskRECORD_TASK_WAKE_TIME( pxTCB )                                               \
+    do {                                                                                     \
+        if( ( ( pxTCB )->ucWakeLatencyPending == ( uint8_t ) pdFALSE ) &&                    \
+            ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) &&                                   \
+            ( xSchedulerRunning != pdFALSE ) )                                               \
+        {                                                                                    \
+            taskGET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulWakeTime );                         \
+            ( pxTCB )->ucWakeLatencyPending = ( uint8_t ) pdTRUE;                            \
+        }                                                                                    \
+    } while( 0 )
+
+#else /* if ( configUSE_TASK_WAKE_LATENCY == 1 ) */
+
+    #define taskRECORD_TASK_WAKE_TIME( pxTCB )
+
+#endif /* if ( configUSE_TASK_WAKE_LATENCY == 1 ) */
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskCURRENT_ISR_WAKE_SOURCE()    ( uxCurrentISRWakeSource[ 0 ] )
+    #else
+        #define taskCURRENT_ISR_WAKE_SOURCE()    ( uxCurrentISRWakeSource[ portGET_CORE_ID() ] )
+    #endif
+
+/*
+ * As taskRECORD_TASK_WAKE_TIME(), but only for tasks made ready while an
+ * interrupt has set its source with uxTaskSetISRWakeSourceFromISR().  The task
+ * is stamped with the source so the latency is recorded against the source
+ * when the task is switched in.
+ */
+    #define taskRECORD_ISR_WAKE_TIME( pxTCB )                                \
+    do {                                                                     \
+        if( ( taskCURRENT_ISR_WAKE_SOURCE() != ( UBaseType_t ) 0U ) &&       \
+            ( ( pxTCB )->uxISRWakeSource == ( UBaseType_t ) 0U ) &&          \
+            ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) &&                   \
+            ( xSchedulerRunning != pdFALSE ) )                               \
+        {                                                                    \
+            taskGET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulISRWakeTime );      \
+            ( pxTCB )->uxISRWakeSource = taskCURRENT_ISR_WAKE_SOURCE();      \
+        }                                                                    \
+    } while( 0 )
+
+#else /* if ( configUSE_ISR_WAKE_LATENCY == 1 ) */
+
+    #define taskRECORD_ISR_WAKE_TIME( pxTCB )
+
+#endif /* if ( configUSE_ISR_WAKE_LATENCY == 1 ) */
+
+/* Called wherever a task enters the Ready state, or the pending ready list. */
+#define taskRECORD_WAKE_TIME( pxTCB )         \
+    do {                                      \
+        taskRECORD_TASK_WAKE_TIME( pxTCB );   \
+        taskRECORD_ISR_WAKE_TIME( pxTCB );    \
+    } while( 0 )
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
@@ -268,6 +386,7 @@
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        taskRECORD_WAKE_TIME( pxTCB );                                                                     \
         taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
@@ -282,6 +401,14 @@
  */
 #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
 
+/*
+ * The default arena of the calling task.  pxCurrentTCB does not point to the
+ * calling task until the scheduler has been started.
+ */
+#if ( configUSE_ARENAS == 1 )
+    #define prvGetCurrentDefaultArena()    ( ( xSchedulerRunning != pdFALSE ) ? pxCurrentTCB->xDefaultArena : NULL )
+#endif
+
 /* The item value of the event list item is normally used to hold the priority
  * of the task to which it belongs (coded to allow it to be held in reverse
  * priority order).  However, it is occasionally borrowed for other purposes.  It
@@ -433,6 +560,59 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_ARENAS == 1 )
+        ArenaHandle_t xDefaultArena; /**< The arena from which the objects the task creates are allocated, or NULL to allocate them from the heap. */
+    #endif
+
+    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        configSTACK_DEPTH_TYPE uxStackHighWaterMark; /**< The high water mark found by the last scan of the stack, in words.  Initialised to the stack depth. */
+        volatile uint8_t ucStackScanPending;         /**< Set to pdTRUE when the task is switched out, as it may have used more stack since the last scan. */
+    #endif
+
+    #if ( configUSE_LAZY_STACK_FILL == 1 )
+        configSTACK_DEPTH_TYPE uxStackFilledWords; /**< The number of words at the far end of the stack that have been filled with tskSTACK_FILL_BYTE. */
+        configSTACK_DEPTH_TYPE uxStackFillLimit;   /**< The number of words beyond the deepest stack pointer seen while filling, which the fill never passes.  Initialised to the stack depth. */
+    #endif
+
+    #if ( configUSE_TASK_WAKE_LATENCY == 1 )
+        configRUN_TIME_COUNTER_TYPE ulWakeTime;                             /**< The run time stats clock when the task last entered the Ready state.  Only valid while ucWakeLatencyPending is pdTRUE. */
+        configRUN_TIME_COUNTER_TYPE ulWakeLatencyMinimum;                   /**< See TaskWakeLatency_t. */
+        configRUN_TIME_COUNTER_TYPE ulWakeLatencyMaximum;                   /**< See TaskWakeLatency_t. */
+        uint32_t ulWakeLatencySamples;                                      /**< See TaskWakeLatency_t. */
+        uint32_t ulWakeLatencyBuckets[ configTASK_WAKE_LATENCY_BUCKETS ];   /**< See TaskWakeLatency_t. */
+        volatile uint8_t ucWakeLatencyPending;                              /**< Set to pdTRUE when the task enters the Ready state, and back to pdFALSE when it runs. */
+    #endif
+
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        uint32_t ulSnapshotGeneration; /**< The generation of the last snapshot that reported this task, see uxTaskSnapshotNext(). */
+    #endif
+
+    #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulBoostStartTime;                                             /**< The run time stats clock when the task was last boosted.  Only valid while ucBoosted is pdTRUE. */
+        configRUN_TIME_COUNTER_TYPE ulBoostedTime;                                                /**< See TaskInversionStats_t. */
+        configRUN_TIME_COUNTER_TYPE ulMaxBoostedTime;                                             /**< See TaskInversionStats_t. */
+        configRUN_TIME_COUNTER_TYPE ulMutexBlockStartTime;                                        /**< The run time stats clock when the task last blocked on a mutex.  Only valid while pxBlockedOnMutexHolder is not NULL. */
+        configRUN_TIME_COUNTER_TYPE ulMaxMutexBlockTime;                                          /**< See TaskInversionStats_t. */
+        struct tskTaskControlBlock * pxBlockedOnMutexHolder;                                      /**< The holder of the mutex the task blocked on, from when it blocks until it next runs, otherwise NULL. */
+        struct tskTaskControlBlock * pxBlockingChain[ configPRIORITY_INVERSION_CHAIN_DEPTH ];     /**< The blocking chain recorded when the task last blocked on a mutex. */
+        struct tskTaskControlBlock * pxWorstBlockingChain[ configPRIORITY_INVERSION_CHAIN_DEPTH ]; /**< See TaskInversionStats_t. */
+        UBaseType_t uxBlockingChainLength;                                                        /**< The number of entries used in pxBlockingChain. */
+        UBaseType_t uxWorstBlockingChainLength;                                                   /**< The number of entries used in pxWorstBlockingChain. */
+        UBaseType_t uxLongestBlockingChain;                                                       /**< See TaskInversionStats_t. */
+        uint32_t ulBoosts;                                                                        /**< See TaskInversionStats_t. */
+        uint32_t ulMutexBlocks;                                                                   /**< See TaskInversionStats_t. */
+        uint8_t ucBoosted;                                                                        /**< Set to pdTRUE while the task is running at an inherited priority above its base priority. */
+    #endif
+
+    #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+        configRUN_TIME_COUNTER_TYPE ulISRWakeTime; /**< The run time stats clock when an interrupt last made the task ready.  Only valid while uxISRWakeSource is not zero. */
+        UBaseType_t uxISRWakeSource;               /**< One more than the interrupt source that made the task ready, from then until it runs, otherwise zero. */
+    #endif
+
+    #if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+        ListItem_t * pxWideEventWaitItem; /**< The list item of the wait record, held in the task's stack, that the task has placed in a wide event group, otherwise NULL. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -522,6 +702,33 @@ PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ conf
 
 #endif
 
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+/* One more than the interrupt source set on each core by
+ * uxTaskSetISRWakeSourceFromISR(), or zero if no source is set, and the latency
+ * histogram of each source. */
+PRIVILEGED_DATA static volatile UBaseType_t uxCurrentISRWakeSource[ configNUMBER_OF_CORES ] = { 0U };
+PRIVILEGED_DATA static TaskWakeLatency_t xISRWakeLatency[ configISR_WAKE_LATENCY_SOURCES ];
+
+#endif
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+/* The generation of the snapshot in progress.  Tasks are marked with the
+ * generation of the snapshot that reported them so they are reported only
+ * once.  Zero is never used, as it is the generation of a new task. */
+PRIVILEGED_DATA static uint32_t ulTaskSnapshotGeneration = 0U;
+
+/* The lists uxTaskSnapshotNext() walks, in order, are the ready lists from the
+ * highest priority down, followed by these. */
+    #define taskSNAPSHOT_DELAYED_LIST             ( ( UBaseType_t ) configMAX_PRIORITIES )
+    #define taskSNAPSHOT_OVERFLOW_DELAYED_LIST    ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 1U )
+    #define taskSNAPSHOT_TERMINATION_LIST         ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 2U )
+    #define taskSNAPSHOT_SUSPENDED_LIST           ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 3U )
+    #define taskSNAPSHOT_LIST_COUNT               ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 4U )
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* File private functions. --------------------------------*/
@@ -638,6 +845,25 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Fills pxRecords with a TaskSnapshotRecord_t for each task referenced from
+ * pxList that has not already been reported by pxSnapshot, up to uxMaxRecords
+ * records, and marks those tasks as reported.  The walk starts from the item
+ * the previous call stopped at if that position is still valid, and the item
+ * to start from next time is saved in pxSnapshot, or NULL if the end of the
+ * list was reached.  Returns the number of records written.  Must be called
+ * with the scheduler suspended.
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    static UBaseType_t prvSnapshotTasksWithinSingleList( TaskSnapshotRecord_t * pxRecords,
+                                                         const UBaseType_t uxMaxRecords,
+                                                         List_t * pxList,
+                                                         eTaskState eState,
+                                                         TaskSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -656,7 +882,98 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const StackType_t * pxStackWord,
+                                                              configSTACK_DEPTH_TYPE uxMaxWords ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the high water mark of the stack of the task pxTCB, in words.  If
+ * configUSE_STACK_HIGH_WATER_MARK_CACHE is 1 the stack is only scanned if the
+ * task may have used more of it since the last scan, and then only as far as
+ * the previous high water mark.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvGetStackHighWaterMark( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills the part of the stack of the task pxTCB that lies between the words
+ * already filled and the task's saved stack pointer, a chunk at a time.  Does
+ * nothing while the task is running, as its stack pointer is then not known.
+ */
+#if ( ( configUSE_LAZY_STACK_FILL == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
+
+    static void prvFillUnusedStack( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when the task pxTCB is switched in at time ulNow.  If the task has
+ * been waiting to run since it entered the Ready state, adds the time it waited
+ * to its wake latency histogram.
+ */
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+
+    static void prvRecordWakeLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the histogram bucket of a wake latency, which is the number of
+ * significant bits in the latency, limited to the last bucket.
+ */
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) )
+
+    static UBaseType_t prvGetWakeLatencyBucket( configRUN_TIME_COUNTER_TYPE ulLatency ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when the task pxTCB is switched in at time ulNow.  If an interrupt
+ * source made the task ready, records the latency against the source.
+ */
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    static void prvRecordISRWakeLatency( TCB_t * pxTCB,
+                                         configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called after the priority of pxTCB is changed by priority inheritance or by
+ * vTaskPrioritySet().  Starts timing a boost if the task is now running above
+ * its base priority, or ends the boost in progress if it is not.
+ */
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    static void prvRecordBoostChange( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when the running task is about to block on a mutex held by
+ * pxMutexHolderTCB.  Records the chain of mutex holders, following each holder
+ * that is itself blocked on a mutex, and starts timing the wait.
+ */
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    static void prvRecordMutexBlockStart( TCB_t * pxMutexHolderTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when the task pxTCB is switched in at time ulNow.  If the task last
+ * blocked on a mutex, ends the wait and keeps its blocking chain if it is the
+ * longest wait yet.
+ */
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    static void prvRecordMutexBlockEnd( TCB_t * pxTCB,
+                                        configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -727,6 +1044,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                         TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif /* #if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 
+/*
+ * Create a task with both TCB and stack allocated from an arena, and make the
+ * arena the task's default arena. Returns a handle to the task if it is created
+ * successfully. Otherwise, returns NULL.
+ */
+#if ( configUSE_ARENAS == 1 )
+    static TCB_t * prvCreateTaskInArena( ArenaHandle_t xArena,
+                                         TaskFunction_t pxTaskCode,
+                                         const char * const pcName,
+                                         const configSTACK_DEPTH_TYPE uxStackDepth,
+                                         void * const pvParameters,
+                                         UBaseType_t uxPriority,
+                                         TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( configUSE_ARENAS == 1 ) */
+
 /*
  * Create a restricted task with static buffer for both TCB and stack. Returns
  * a handle to the task if it is created successfully. Otherwise, returns NULL.
@@ -1383,6 +1715,107 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ARENAS == 1 )
+
+    static TCB_t * prvCreateTaskInArena( ArenaHandle_t xArena,
+                                         TaskFunction_t pxTaskCode,
+                                         const char * const pcName,
+                                         const configSTACK_DEPTH_TYPE uxStackDepth,
+                                         void * const pvParameters,
+                                         UBaseType_t uxPriority,
+                                         TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB = NULL;
+        StackType_t * puxStackBuffer;
+        StaticTask_t * pxTaskBuffer;
+
+        configASSERT( xArena );
+
+        /* Allocate the stack and the TCB from the arena in the same order as
+         * prvCreateTask() allocates them from the heap, so the stack does not
+         * grow into the TCB.  Memory allocated from the arena is not returned if
+         * the second allocation fails - it is released when the arena is. */
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        #if ( portSTACK_GROWTH > 0 )
+        {
+            pxTaskBuffer = ( StaticTask_t * ) pvArenaMalloc( xArena, sizeof( StaticTask_t ) );
+            puxStackBuffer = ( StackType_t * ) pvArenaMallocAligned( xArena, ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ), ( size_t ) configKERNEL_BUFFER_ALIGNMENT );
+        }
+        #else /* portSTACK_GROWTH */
+        {
+            puxStackBuffer = ( StackType_t * ) pvArenaMallocAligned( xArena, ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ), ( size_t ) configKERNEL_BUFFER_ALIGNMENT );
+            pxTaskBuffer = ( StaticTask_t * ) pvArenaMalloc( xArena, sizeof( StaticTask_t ) );
+        }
+        #endif /* portSTACK_GROWTH */
+
+        if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+        {
+            /* The kernel treats the task as statically allocated, so deleting
+             * it does not attempt to free the arena's memory. */
+            pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
+            {
+                /* Set before the task is scheduled, so everything the task
+                 * creates comes from the arena. */
+                pxNewTCB->xDefaultArena = xArena;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskCreateInArena( ArenaHandle_t xArena,
+                                   TaskFunction_t pxTaskCode,
+                                   const char * const pcName,
+                                   const configSTACK_DEPTH_TYPE uxStackDepth,
+                                   void * const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskCreateInArena( xArena, pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+        pxNewTCB = prvCreateTaskInArena( xArena, pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+        if( pxNewTCB != NULL )
+        {
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                /* Set the task's affinity before scheduling it. */
+                pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+            }
+            #endif
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
+
+        traceRETURN_xTaskCreateInArena( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     static TCB_t * prvCreateRestrictedStaticTask( const TaskParameters_t * const pxTaskDefinition,
                                                   TaskHandle_t * const pxCreatedTask )
@@ -1512,7 +1945,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( eObjectPoolTask, sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1631,7 +2064,53 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         /* If the stack grows down then allocate the stack then the TCB so the stack
          * does not grow into the TCB.  Likewise if the stack grows up then allocate
          * the TCB then the stack. */
-        #if ( portSTACK_GROWTH > 0 )
+        #if ( configUSE_TASK_SINGLE_ALLOCATION == 1 )
+        {
+            const size_t xTCBSize = tskALIGN_SIZE( sizeof( TCB_t ) );
+            size_t xStackSize = 0;
+            uint8_t * pucBlock = NULL;
+
+            /* Allocate the stack and the TCB as one block, which halves the
+             * number of calls into the heap when tasks are created and
+             * deleted. */
+            if( ( size_t ) uxStackDepth <= ( ( SIZE_MAX - ( xTCBSize + ( size_t ) portBYTE_ALIGNMENT ) ) / sizeof( StackType_t ) ) )
+            {
+                xStackSize = tskALIGN_SIZE( ( size_t ) uxStackDepth * sizeof( StackType_t ) );
+                pucBlock = ( uint8_t * ) pvPortMallocStack( xStackSize + xTCBSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pucBlock != NULL )
+            {
+                #if ( portSTACK_GROWTH < 0 )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxNewTCB = ( TCB_t * ) &( pucBlock[ xStackSize ] );
+                    ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                    pxNewTCB->pxStack = ( StackType_t * ) pucBlock;
+                }
+                #else
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxNewTCB = ( TCB_t * ) pucBlock;
+                    ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                    pxNewTCB->pxStack = ( StackType_t * ) &( pucBlock[ xTCBSize ] );
+                }
+                #endif
+            }
+            else
+            {
+                pxNewTCB = NULL;
+            }
+        }
+        #elif ( portSTACK_GROWTH > 0 )
         {
             /* Allocate space for the TCB.  Where the memory comes from depends on
              * the implementation of the port malloc function and whether or not static
@@ -1639,7 +2118,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( eObjectPoolTask, sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1656,7 +2135,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    vPortFreeObject( eObjectPoolTask, pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -1677,7 +2156,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = ( TCB_t * ) pvPortMallocObject( eObjectPoolTask, sizeof( TCB_t ) );
 
                 if( pxNewTCB != NULL )
                 {
@@ -1729,7 +2208,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
         traceENTER_xTaskCreate( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
 
-        pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+        #if ( configUSE_ARENAS == 1 )
+            if( prvGetCurrentDefaultArena() != NULL )
+            {
+                /* The calling task has a default arena, so the new task is
+                 * created in it. */
+                pxNewTCB = prvCreateTaskInArena( prvGetCurrentDefaultArena(), pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+            }
+            else
+        #endif /* configUSE_ARENAS */
+        {
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+        }
 
         if( pxNewTCB != NULL )
         {
@@ -1768,7 +2258,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
             traceENTER_xTaskCreateAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, uxCoreAffinityMask, pxCreatedTask );
 
-            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+            #if ( configUSE_ARENAS == 1 )
+                if( prvGetCurrentDefaultArena() != NULL )
+                {
+                    /* The calling task has a default arena, so the new task is
+                     * created in it. */
+                    pxNewTCB = prvCreateTaskInArena( prvGetCurrentDefaultArena(), pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+                }
+                else
+            #endif /* configUSE_ARENAS */
+            {
+                pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+            }
 
             if( pxNewTCB != NULL )
             {
@@ -1820,13 +2321,48 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     #endif /* portUSING_MPU_WRAPPERS == 1 */
 
     /* Avoid dependency on memset() if it is not required. */
-    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
+    #if ( ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 ) && ( configUSE_LAZY_STACK_FILL == 1 ) )
+    {
+        /* Only fill the guard region at the far end of the stack now.  The
+         * rest is filled when the task's high water mark is first requested. */
+        pxNewTCB->uxStackFilledWords = ( uxStackDepth < tskSTACK_GUARD_WORDS ) ? uxStackDepth : tskSTACK_GUARD_WORDS;
+        pxNewTCB->uxStackFillLimit = uxStackDepth;
+
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) pxNewTCB->uxStackFilledWords * sizeof( StackType_t ) );
+        }
+        #else
+        {
+            ( void ) memset( &( pxNewTCB->pxStack[ uxStackDepth - pxNewTCB->uxStackFilledWords ] ), ( int ) tskSTACK_FILL_BYTE, ( size_t ) pxNewTCB->uxStackFilledWords * sizeof( StackType_t ) );
+        }
+        #endif
+    }
+    #elif ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
     {
         /* Fill the stack with a known value to assist debugging. */
         ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) uxStackDepth * sizeof( StackType_t ) );
     }
     #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
+    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+    {
+        /* No scan has been done yet, so all of the filled part of the stack
+         * may be unused.  When the stack is filled lazily the mark is only
+         * used once the fill is complete, and is set again at that point. */
+        #if ( configUSE_LAZY_STACK_FILL == 1 )
+        {
+            pxNewTCB->uxStackHighWaterMark = pxNewTCB->uxStackFilledWords;
+        }
+        #else
+        {
+            pxNewTCB->uxStackHighWaterMark = uxStackDepth;
+        }
+        #endif
+        pxNewTCB->ucStackScanPending = ( uint8_t ) pdTRUE;
+    }
+    #endif
+
     /* Calculate the top of stack address.  This depends on whether the stack
      * grows from high memory to low (as per the 80x86) or vice versa.
      * portSTACK_GROWTH is used to make the result positive or negative as required
@@ -2224,8 +2760,26 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
+            #if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+            {
+                /* A task blocked on a wide event group waits on its notification,
+                 * and its wait record, which is about to be freed along with the
+                 * task's stack, is still in the event group's list. */
+                if( ( pxTCB->pxWideEventWaitItem != NULL ) && ( listLIST_ITEM_CONTAINER( pxTCB->pxWideEventWaitItem ) != NULL ) )
+                {
+                    ( void ) uxListRemove( pxTCB->pxWideEventWaitItem );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->pxWideEventWaitItem = NULL;
+            }
+            #endif /* configUSE_WIDE_EVENT_GROUPS */
+
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
              * not return. */
             uxTaskNumber++;
@@ -2884,6 +3438,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
                     /* The base priority gets set whatever. */
                     pxTCB->uxBasePriority = uxNewPriority;
+
+                    #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+                    {
+                        prvRecordBoostChange( pxTCB );
+                    }
+                    #endif
                 }
                 #else /* if ( configUSE_MUTEXES == 1 ) */
                 {
@@ -3134,6 +3694,20 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             traceTASK_SUSPEND( pxTCB );
 
+            /* A Ready state task that is suspended is no longer waiting to
+             * run. */
+            #if ( configUSE_TASK_WAKE_LATENCY == 1 )
+            {
+                pxTCB->ucWakeLatencyPending = ( uint8_t ) pdFALSE;
+            }
+            #endif
+
+            #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+            {
+                pxTCB->uxISRWakeSource = ( UBaseType_t ) 0U;
+            }
+            #endif
+
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -3481,6 +4055,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     /* The delayed or ready lists cannot be accessed so the task
                      * is held in the pending ready list until the scheduler is
                      * unsuspended. */
+                    taskRECORD_WAKE_TIME( pxTCB );
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
@@ -3834,6 +4409,15 @@ void vTaskSuspendAll( void )
         /* Enforces ordering for ports and optimised compilers that may otherwise place
          * the above increment elsewhere. */
         portMEMORY_BARRIER();
+
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+            {
+                vCriticalProfilerEnter( eSchedulerSuspendedRegion, configCRITICAL_PROFILER_GET_CALLER() );
+            }
+        }
+        #endif
     }
     #else /* #if ( configNUMBER_OF_CORES == 1 ) */
     {
@@ -3877,6 +4461,16 @@ void vTaskSuspendAll( void )
             /* The scheduler is suspended if uxSchedulerSuspended is non-zero. An increment
              * is used to allow calls to vTaskSuspendAll() to nest. */
             ++uxSchedulerSuspended;
+
+            #if ( configUSE_CRITICAL_PROFILER == 1 )
+            {
+                if( uxSchedulerSuspended == 1U )
+                {
+                    vCriticalProfilerEnter( eSchedulerSuspendedRegion, configCRITICAL_PROFILER_GET_CALLER() );
+                }
+            }
+            #endif
+
             portRELEASE_ISR_LOCK();
 
             portCLEAR_INTERRUPT_MASK( ulState );
@@ -3987,6 +4581,12 @@ BaseType_t xTaskResumeAll( void )
 
             if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
             {
+                #if ( configUSE_CRITICAL_PROFILER == 1 )
+                {
+                    vCriticalProfilerExit( eSchedulerSuspendedRegion );
+                }
+                #endif
+
                 if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
                 {
                     /* Move any readied tasks from the pending list into the
@@ -4463,6 +5063,135 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot )
+    {
+        traceENTER_vTaskSnapshotBegin( pxSnapshot );
+
+        configASSERT( pxSnapshot );
+
+        taskENTER_CRITICAL();
+        {
+            ulTaskSnapshotGeneration++;
+
+            if( ulTaskSnapshotGeneration == 0U )
+            {
+                ulTaskSnapshotGeneration = 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxSnapshot->ulGeneration = ulTaskSnapshotGeneration;
+        }
+        taskEXIT_CRITICAL();
+
+        pxSnapshot->uxNextList = 0;
+        pxSnapshot->pxNextItem = NULL;
+
+        traceRETURN_vTaskSnapshotBegin();
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot,
+                                    TaskSnapshotRecord_t * const pxRecords,
+                                    const UBaseType_t uxMaxRecords )
+    {
+        UBaseType_t uxRecords = 0;
+        List_t * pxList;
+        eTaskState eState;
+
+        traceENTER_uxTaskSnapshotNext( pxSnapshot, pxRecords, uxMaxRecords );
+
+        configASSERT( pxSnapshot );
+        configASSERT( pxRecords );
+
+        vTaskSuspendAll();
+        {
+            /* A snapshot started since this one ends this one. */
+            if( pxSnapshot->ulGeneration != ulTaskSnapshotGeneration )
+            {
+                pxSnapshot->uxNextList = taskSNAPSHOT_LIST_COUNT;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            while( ( uxRecords < uxMaxRecords ) && ( pxSnapshot->uxNextList < taskSNAPSHOT_LIST_COUNT ) )
+            {
+                if( pxSnapshot->uxNextList < taskSNAPSHOT_DELAYED_LIST )
+                {
+                    pxList = &( pxReadyTasksLists[ taskSNAPSHOT_DELAYED_LIST - pxSnapshot->uxNextList - ( UBaseType_t ) 1U ] );
+                    eState = eReady;
+                }
+                else if( pxSnapshot->uxNextList == taskSNAPSHOT_DELAYED_LIST )
+                {
+                    pxList = ( List_t * ) pxDelayedTaskList;
+                    eState = eBlocked;
+                }
+                else if( pxSnapshot->uxNextList == taskSNAPSHOT_OVERFLOW_DELAYED_LIST )
+                {
+                    pxList = ( List_t * ) pxOverflowDelayedTaskList;
+                    eState = eBlocked;
+                }
+                else if( pxSnapshot->uxNextList == taskSNAPSHOT_TERMINATION_LIST )
+                {
+                    #if ( INCLUDE_vTaskDelete == 1 )
+                        pxList = &xTasksWaitingTermination;
+                    #else
+                        pxList = NULL;
+                    #endif
+                    eState = eDeleted;
+                }
+                else
+                {
+                    #if ( INCLUDE_vTaskSuspend == 1 )
+                        pxList = &xSuspendedTaskList;
+                    #else
+                        pxList = NULL;
+                    #endif
+                    eState = eSuspended;
+                }
+
+                if( pxList != NULL )
+                {
+                    uxRecords = ( UBaseType_t ) ( uxRecords + prvSnapshotTasksWithinSingleList( &( pxRecords[ uxRecords ] ), uxMaxRecords - uxRecords, pxList, eState, pxSnapshot ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The walk of the list stopped before its end only if
+                 * pxRecords is full, in which case the next call continues
+                 * from the item saved in pxSnapshot. */
+                if( pxSnapshot->pxNextItem == NULL )
+                {
+                    pxSnapshot->uxNextList++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxTaskSnapshotNext( uxRecords );
+
+        return uxRecords;
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -5103,6 +5832,13 @@ BaseType_t xTaskIncrementTick( void )
             /* Check for stack overflow, if configured. */
             taskCHECK_FOR_STACK_OVERFLOW();
 
+            /* The task being switched out may have used more of its stack. */
+            #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+            {
+                pxCurrentTCB->ucStackScanPending = ( uint8_t ) pdTRUE;
+            }
+            #endif
+
             /* Before the currently running task is switched out, save its errno. */
             #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -5118,6 +5854,24 @@ BaseType_t xTaskIncrementTick( void )
             taskSELECT_HIGHEST_PRIORITY_TASK();
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_TASK_WAKE_LATENCY == 1 )
+            {
+                prvRecordWakeLatency( pxCurrentTCB, ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
+            #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+            {
+                prvRecordMutexBlockEnd( pxCurrentTCB, ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
+            #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+            {
+                prvRecordISRWakeLatency( pxCurrentTCB, ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5204,6 +5958,13 @@ BaseType_t xTaskIncrementTick( void )
                 /* Check for stack overflow, if configured. */
                 taskCHECK_FOR_STACK_OVERFLOW();
 
+                /* The task being switched out may have used more of its stack. */
+                #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+                {
+                    pxCurrentTCBs[ xCoreID ]->ucStackScanPending = ( uint8_t ) pdTRUE;
+                }
+                #endif
+
                 /* Before the currently running task is switched out, save its errno. */
                 #if ( configUSE_POSIX_ERRNO == 1 )
                 {
@@ -5215,6 +5976,24 @@ BaseType_t xTaskIncrementTick( void )
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
                 traceTASK_SWITCHED_IN();
 
+                #if ( configUSE_TASK_WAKE_LATENCY == 1 )
+                {
+                    prvRecordWakeLatency( pxCurrentTCBs[ xCoreID ], ulTotalRunTime[ xCoreID ] );
+                }
+                #endif
+
+                #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+                {
+                    prvRecordMutexBlockEnd( pxCurrentTCBs[ xCoreID ], ulTotalRunTime[ xCoreID ] );
+                }
+                #endif
+
+                #if ( configUSE_ISR_WAKE_LATENCY == 1 )
+                {
+                    prvRecordISRWakeLatency( pxCurrentTCBs[ xCoreID ], ulTotalRunTime[ xCoreID ] );
+                }
+                #endif
+
                 /* Macro to inject port specific behaviour immediately after
                  * switching tasks, such as setting an end of stack watchpoint
                  * or reconfiguring the MPU. */
@@ -5294,7 +6073,8 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
      * list.  It is safe to access the event list here because it is part of an
      * event group implementation - and interrupts don't access event groups
      * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
+     * the task level, or, if configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1, the
+     * event group is locked against interrupt access while this is called). */
     listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -5392,6 +6172,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     {
         /* The delayed and ready lists cannot be accessed, so hold this task
          * pending until the scheduler is resumed. */
+        taskRECORD_WAKE_TIME( pxUnblockedTCB );
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
@@ -5507,6 +6288,94 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue );
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+         * It is used by the event groups implementation to set bits directly
+         * from an interrupt.  The event group is not locked by a task when this
+         * function is called, so exclusive access to the event list is
+         * guaranteed here. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem );
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See the comment in xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The event list item value
+             * written above is not used by the pending ready list. */
+            taskRECORD_WAKE_TIME( pxUnblockedTCB );
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+            {
+                /* Return true if the task removed from the event list has a
+                 * higher priority than the interrupted task, and mark that a
+                 * yield is pending in case the ISR does not use the
+                 * "xHigherPriorityTaskWoken" parameter. */
+                xReturn = pdTRUE;
+                xYieldPendings[ 0 ] = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+        traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
@@ -5535,6 +6404,23 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_WIDE_EVENT_GROUPS == 1 )
+
+    void vTaskInternalSetWideEventWaitItem( ListItem_t * pxWaitItem )
+    {
+        traceENTER_vTaskInternalSetWideEventWaitItem( pxWaitItem );
+
+        /* For internal use only as it does not use a critical section.  The
+         * caller has the scheduler suspended, and vTaskDelete() only reads the
+         * item from within a critical section. */
+        pxCurrentTCB->pxWideEventWaitItem = pxWaitItem;
+
+        traceRETURN_vTaskInternalSetWideEventWaitItem();
+    }
+
+#endif /* configUSE_WIDE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
 BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
                                  TickType_t * const pxTicksToWait )
 {
@@ -5991,6 +6877,57 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ARENAS == 1 )
+
+    void vTaskSetDefaultArena( TaskHandle_t xTask,
+                               ArenaHandle_t xArena )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskSetDefaultArena( xTask, xArena );
+
+        /* If null is passed in here then we are setting the default arena of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB->xDefaultArena = xArena;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetDefaultArena();
+    }
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ARENAS == 1 )
+
+    ArenaHandle_t xTaskGetDefaultArena( TaskHandle_t xTask )
+    {
+        ArenaHandle_t xReturn;
+
+        traceENTER_xTaskGetDefaultArena( xTask );
+
+        if( xTask == NULL )
+        {
+            xReturn = prvGetCurrentDefaultArena();
+        }
+        else
+        {
+            xReturn = xTask->xDefaultArena;
+        }
+
+        traceRETURN_xTaskGetDefaultArena( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
     void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
@@ -6246,15 +7183,7 @@ static void prvCheckTasksWaitingTermination( void )
          * parameter is provided to allow it to be skipped. */
         if( xGetFreeStackSpace != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+            pxTaskStatus->usStackHighWaterMark = prvGetStackHighWaterMark( pxTCB );
         }
         else
         {
@@ -6306,100 +7235,968 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( configUSE_TASK_SNAPSHOT == 1 )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static UBaseType_t prvSnapshotTasksWithinSingleList( TaskSnapshotRecord_t * pxRecords,
+                                                         const UBaseType_t uxMaxRecords,
+                                                         List_t * pxList,
+                                                         eTaskState eState,
+                                                         TaskSnapshot_t * const pxSnapshot )
     {
-        configSTACK_DEPTH_TYPE uxCount = 0U;
-
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
-        {
-            pucStackByte -= portSTACK_GROWTH;
-            uxCount++;
-        }
-
-        uxCount /= ( configSTACK_DEPTH_TYPE ) sizeof( StackType_t );
+        UBaseType_t uxRecords = 0;
+        const uint32_t ulGeneration = pxSnapshot->ulGeneration;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator = listGET_HEAD_ENTRY( pxList );
+        const ListItem_t * pxPrevious;
+        TCB_t * pxTCB;
+        TaskStatus_t xTaskStatus;
+        TaskSnapshotRecord_t * pxRecord;
+
+        /* Continue from where the previous call stopped, rather than walking
+         * past every task it already reported, as long as no task has been
+         * created or deleted since (so the saved item cannot have been freed),
+         * the saved item is still in this list, and the item before it has
+         * been reported (so it has not been moved past tasks that have not).
+         * Tasks in the termination list are freed by the idle task without
+         * uxTaskNumber changing, so that list is always walked from its head.
+         * Otherwise the tasks already reported are skipped. */
+        if( ( pxSnapshot->pxNextItem != NULL ) &&
+            ( pxSnapshot->uxTaskNumber == uxTaskNumber ) &&
+            ( eState != eDeleted ) &&
+            ( listLIST_ITEM_CONTAINER( pxSnapshot->pxNextItem ) == pxList ) )
+        {
+            pxPrevious = pxSnapshot->pxNextItem->pxPrevious;
 
-        return uxCount;
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            if( ( pxPrevious == pxEndMarker ) ||
+                ( ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxPrevious ) )->ulSnapshotGeneration == ulGeneration ) )
+            {
+                pxIterator = pxSnapshot->pxNextItem;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ; ( pxIterator != pxEndMarker ) && ( uxRecords < uxMaxRecords ); pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( pxTCB->ulSnapshotGeneration != ulGeneration )
+            {
+                pxTCB->ulSnapshotGeneration = ulGeneration;
+
+                vTaskGetInfo( ( TaskHandle_t ) pxTCB, &xTaskStatus, pdTRUE, eState );
+
+                pxRecord = &( pxRecords[ uxRecords ] );
+                pxRecord->xHandle = xTaskStatus.xHandle;
+                pxRecord->ulRunTimeCounter = xTaskStatus.ulRunTimeCounter;
+                pxRecord->uxTaskNumber = xTaskStatus.xTaskNumber;
+                pxRecord->uxCurrentPriority = xTaskStatus.uxCurrentPriority;
+                pxRecord->uxBasePriority = xTaskStatus.uxBasePriority;
+                pxRecord->usStackHighWaterMark = xTaskStatus.usStackHighWaterMark;
+                pxRecord->ucState = ( uint8_t ) xTaskStatus.eCurrentState;
+                pxRecord->ulNotificationsPending = 0U;
+                pxRecord->ulNotificationsWaiting = 0U;
+                ( void ) memcpy( pxRecord->pcTaskName, pxTCB->pcTaskName, sizeof( pxRecord->pcTaskName ) );
+
+                #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                {
+                    UBaseType_t uxIndex;
+
+                    for( uxIndex = 0; ( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES ) && ( uxIndex < ( UBaseType_t ) 32U ); uxIndex++ )
+                    {
+                        if( pxTCB->ucNotifyState[ uxIndex ] == taskNOTIFICATION_RECEIVED )
+                        {
+                            pxRecord->ulNotificationsPending |= ( ( uint32_t ) 1U ) << uxIndex;
+                        }
+                        else if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+                        {
+                            pxRecord->ulNotificationsWaiting |= ( ( uint32_t ) 1U ) << uxIndex;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #endif /* configUSE_TASK_NOTIFICATIONS */
+
+                uxRecords++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( pxIterator != pxEndMarker )
+        {
+            pxSnapshot->pxNextItem = pxIterator;
+            pxSnapshot->uxTaskNumber = uxTaskNumber;
+        }
+        else
+        {
+            pxSnapshot->pxNextItem = NULL;
+        }
+
+        return uxRecords;
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const StackType_t * pxStackWord,
+                                                              configSTACK_DEPTH_TYPE uxMaxWords )
+    {
+        configSTACK_DEPTH_TYPE uxCount = 0U;
+
+        /* A word only counts as unused if every one of its bytes still holds
+         * tskSTACK_FILL_BYTE, so comparing a whole word at a time gives the same
+         * result as comparing bytes then dividing by sizeof( StackType_t ), but
+         * takes a fraction of the memory accesses. */
+        while( ( uxCount < uxMaxWords ) && ( *pxStackWord == tskSTACK_FILL_WORD ) )
+        {
+            pxStackWord -= portSTACK_GROWTH;
+            uxCount++;
+        }
+
+        return uxCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvGetStackHighWaterMark( TCB_t * pxTCB )
+    {
+        const StackType_t * pxEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            pxEndOfStack = pxTCB->pxStack;
+        }
+        #else
+        {
+            pxEndOfStack = pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        #if ( configUSE_LAZY_STACK_FILL == 1 )
+        {
+            prvFillUnusedStack( pxTCB );
+        }
+        #endif
+
+        #if ( ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 ) && ( configUSE_LAZY_STACK_FILL == 1 ) )
+            if( pxTCB->uxStackFilledWords < pxTCB->uxStackFillLimit )
+            {
+                /* The fill could not be completed as the task is running, so
+                 * the cached mark is not valid yet.  Words that have not been
+                 * filled cannot be counted as unused. */
+                uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack, pxTCB->uxStackFilledWords );
+            }
+            else
+        #endif
+        #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        {
+            BaseType_t xScanNeeded;
+
+            /* The task can only have used more stack since the last scan if it
+             * has been switched out since then or is running now.  The flag is
+             * cleared before scanning so a switch out that happens during the
+             * scan is seen by the next call. */
+            taskENTER_CRITICAL();
+            {
+                uxReturn = pxTCB->uxStackHighWaterMark;
+
+                if( ( pxTCB->ucStackScanPending != ( uint8_t ) pdFALSE ) || ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                {
+                    xScanNeeded = pdTRUE;
+                }
+                else
+                {
+                    xScanNeeded = pdFALSE;
+                }
+
+                pxTCB->ucStackScanPending = ( uint8_t ) pdFALSE;
+            }
+            taskEXIT_CRITICAL();
+
+            if( xScanNeeded != pdFALSE )
+            {
+                /* The high water mark never rises, so the words beyond the
+                 * previous mark are known to have been used and are not checked
+                 * again. */
+                uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack, uxReturn );
+
+                taskENTER_CRITICAL();
+                {
+                    /* Another task may have stored a lower mark while this one
+                     * was scanning. */
+                    if( uxReturn < pxTCB->uxStackHighWaterMark )
+                    {
+                        pxTCB->uxStackHighWaterMark = uxReturn;
+                    }
+                    else
+                    {
+                        uxReturn = pxTCB->uxStackHighWaterMark;
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #elif ( configUSE_LAZY_STACK_FILL == 1 )
+        {
+            /* Words that have not been filled yet cannot be counted as unused. */
+            uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack, pxTCB->uxStackFilledWords );
+        }
+        #else
+        {
+            uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack, ( configSTACK_DEPTH_TYPE ) ~( configSTACK_DEPTH_TYPE ) 0U );
+        }
+        #endif /* if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 ) */
+
+        return uxReturn;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_LAZY_STACK_FILL == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
+
+    static void prvFillUnusedStack( TCB_t * pxTCB )
+    {
+        configSTACK_DEPTH_TYPE uxFilledWords;
+        configSTACK_DEPTH_TYPE uxUnusedWords;
+        configSTACK_DEPTH_TYPE uxWordsToFill;
+        BaseType_t xMoreToFill = pdTRUE;
+
+        while( xMoreToFill != pdFALSE )
+        {
+            /* The task cannot run, and so cannot move its stack pointer, while
+             * a chunk is being filled.  Everything beyond the saved stack pointer
+             * of a task that is not running is unused. */
+            taskENTER_CRITICAL();
+            {
+                xMoreToFill = pdFALSE;
+
+                if( ( pxTCB->uxStackFilledWords < pxTCB->uxStackFillLimit ) && ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) )
+                {
+                    uxFilledWords = pxTCB->uxStackFilledWords;
+
+                    #if ( portSTACK_GROWTH < 0 )
+                    {
+                        uxUnusedWords = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxTopOfStack - pxTCB->pxStack );
+                    }
+                    #else
+                    {
+                        uxUnusedWords = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxTCB->pxTopOfStack );
+                    }
+                    #endif
+
+                    /* The fill only ever stops short of the deepest stack
+                     * pointer seen so far.  Once it reaches that point it is
+                     * complete and is never extended, as filling words the task
+                     * used before it returned up its stack again would erase
+                     * the record of its deepest use. */
+                    if( uxUnusedWords < pxTCB->uxStackFillLimit )
+                    {
+                        pxTCB->uxStackFillLimit = uxUnusedWords;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxTCB->uxStackFillLimit > uxFilledWords )
+                    {
+                        uxWordsToFill = pxTCB->uxStackFillLimit - uxFilledWords;
+
+                        if( uxWordsToFill > tskSTACK_FILL_CHUNK_WORDS )
+                        {
+                            uxWordsToFill = tskSTACK_FILL_CHUNK_WORDS;
+                            xMoreToFill = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        #if ( portSTACK_GROWTH < 0 )
+                        {
+                            ( void ) memset( &( pxTCB->pxStack[ uxFilledWords ] ), ( int ) tskSTACK_FILL_BYTE, ( size_t ) uxWordsToFill * sizeof( StackType_t ) );
+                        }
+                        #else
+                        {
+                            ( void ) memset( pxTCB->pxEndOfStack - ( uxFilledWords + uxWordsToFill - ( configSTACK_DEPTH_TYPE ) 1 ), ( int ) tskSTACK_FILL_BYTE, ( size_t ) uxWordsToFill * sizeof( StackType_t ) );
+                        }
+                        #endif
+
+                        pxTCB->uxStackFilledWords = uxFilledWords + uxWordsToFill;
+                    }
+                    else
+                    {
+                        /* The task's stack pointer is already within the
+                         * filled words, so there is nothing more to fill. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+                    {
+                        /* The cached mark is not used until the fill is
+                         * complete, so is set for the first time here, after
+                         * which it never rises. */
+                        if( pxTCB->uxStackFilledWords >= pxTCB->uxStackFillLimit )
+                        {
+                            pxTCB->uxStackHighWaterMark = pxTCB->uxStackFilledWords;
+                            pxTCB->ucStackScanPending = ( uint8_t ) pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        traceENTER_uxTaskGetStackHighWaterMark2( xTask );
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        uxReturn = prvGetStackHighWaterMark( pxTCB );
+
+        traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        uxReturn = ( UBaseType_t ) prvGetStackHighWaterMark( pxTCB );
+
+        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+
+    static void prvRecordWakeLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+
+        if( pxTCB->ucWakeLatencyPending != ( uint8_t ) pdFALSE )
+        {
+            pxTCB->ucWakeLatencyPending = ( uint8_t ) pdFALSE;
+
+            /* As for the run time stats, guard against a clock that has gone
+             * backwards rather than record a huge latency. */
+            if( ulNow > pxTCB->ulWakeTime )
+            {
+                ulLatency = ulNow - pxTCB->ulWakeTime;
+            }
+            else
+            {
+                ulLatency = 0U;
+            }
+
+            if( ( pxTCB->ulWakeLatencySamples == 0U ) || ( ulLatency < pxTCB->ulWakeLatencyMinimum ) )
+            {
+                pxTCB->ulWakeLatencyMinimum = ulLatency;
+            }
+
+            if( ulLatency > pxTCB->ulWakeLatencyMaximum )
+            {
+                pxTCB->ulWakeLatencyMaximum = ulLatency;
+            }
+
+            pxTCB->ulWakeLatencyBuckets[ prvGetWakeLatencyBucket( ulLatency ) ]++;
+            pxTCB->ulWakeLatencySamples++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_TASK_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) )
+
+    static UBaseType_t prvGetWakeLatencyBucket( configRUN_TIME_COUNTER_TYPE ulLatency )
+    {
+        UBaseType_t uxBucket = 0U;
+
+        while( ( ulLatency != 0U ) && ( uxBucket < ( UBaseType_t ) ( configTASK_WAKE_LATENCY_BUCKETS - 1 ) ) )
+        {
+            ulLatency >>= 1U;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+
+#endif /* ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+
+    void vTaskGetWakeLatency( TaskHandle_t xTask,
+                              TaskWakeLatency_t * pxWakeLatency )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskGetWakeLatency( xTask, pxWakeLatency );
+
+        configASSERT( pxWakeLatency );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxWakeLatency->ulSamples = pxTCB->ulWakeLatencySamples;
+            pxWakeLatency->ulMinimum = pxTCB->ulWakeLatencyMinimum;
+            pxWakeLatency->ulMaximum = pxTCB->ulWakeLatencyMaximum;
+            ( void ) memcpy( pxWakeLatency->ulBuckets, pxTCB->ulWakeLatencyBuckets, sizeof( pxWakeLatency->ulBuckets ) );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetWakeLatency();
+    }
+
+#endif /* configUSE_TASK_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_WAKE_LATENCY == 1 )
+
+    void vTaskResetWakeLatency( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskResetWakeLatency( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->ulWakeLatencySamples = 0U;
+            pxTCB->ulWakeLatencyMinimum = 0U;
+            pxTCB->ulWakeLatencyMaximum = 0U;
+            ( void ) memset( pxTCB->ulWakeLatencyBuckets, 0x00, sizeof( pxTCB->ulWakeLatencyBuckets ) );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskResetWakeLatency();
+    }
+
+#endif /* configUSE_TASK_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWakeLatencyPercentile( const TaskWakeLatency_t * pxWakeLatency,
+                                                                UBaseType_t uxPercentile )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn = 0U;
+        uint32_t ulTarget;
+        uint32_t ulCount = 0U;
+        UBaseType_t uxBucket;
+        const uint32_t ulPercentile = ( uint32_t ) uxPercentile;
+
+        traceENTER_ulTaskGetWakeLatencyPercentile( pxWakeLatency, uxPercentile );
+
+        configASSERT( pxWakeLatency );
+        configASSERT( uxPercentile <= 100U );
+
+        if( pxWakeLatency->ulSamples != 0U )
+        {
+            /* The number of samples that must be at or below the percentile,
+             * rounded up, calculated so it cannot overflow. */
+            ulTarget = ( ( pxWakeLatency->ulSamples / 100U ) * ulPercentile ) +
+                       ( ( ( ( pxWakeLatency->ulSamples % 100U ) * ulPercentile ) + 99U ) / 100U );
+
+            if( ulTarget == 0U )
+            {
+                ulTarget = 1U;
+            }
+
+            for( uxBucket = 0U; uxBucket < ( UBaseType_t ) ( configTASK_WAKE_LATENCY_BUCKETS - 1 ); uxBucket++ )
+            {
+                ulCount += pxWakeLatency->ulBuckets[ uxBucket ];
+
+                if( ulCount >= ulTarget )
+                {
+                    break;
+                }
+            }
+
+            /* Bucket n holds latencies up to (2^n)-1, but the percentile can
+             * be no further out than the recorded extremes. */
+            if( ( uxBucket == ( UBaseType_t ) ( configTASK_WAKE_LATENCY_BUCKETS - 1 ) ) ||
+                ( uxBucket >= ( UBaseType_t ) ( sizeof( configRUN_TIME_COUNTER_TYPE ) * ( size_t ) 8 ) ) )
+            {
+                ulReturn = pxWakeLatency->ulMaximum;
+            }
+            else
+            {
+                ulReturn = ( ( ( configRUN_TIME_COUNTER_TYPE ) 1U ) << uxBucket ) - 1U;
+
+                if( ulReturn > pxWakeLatency->ulMaximum )
+                {
+                    ulReturn = pxWakeLatency->ulMaximum;
+                }
+                else if( ulReturn < pxWakeLatency->ulMinimum )
+                {
+                    ulReturn = pxWakeLatency->ulMinimum;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_ulTaskGetWakeLatencyPercentile( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* ( ( configUSE_TASK_WAKE_LATENCY == 1 ) || ( configUSE_ISR_WAKE_LATENCY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    static void prvRecordISRWakeLatency( TCB_t * pxTCB,
+                                         configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        TaskWakeLatency_t * pxWakeLatency;
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+
+        if( pxTCB->uxISRWakeSource != ( UBaseType_t ) 0U )
+        {
+            pxWakeLatency = &( xISRWakeLatency[ pxTCB->uxISRWakeSource - ( UBaseType_t ) 1U ] );
+            pxTCB->uxISRWakeSource = ( UBaseType_t ) 0U;
+
+            if( ulNow > pxTCB->ulISRWakeTime )
+            {
+                ulLatency = ulNow - pxTCB->ulISRWakeTime;
+            }
+            else
+            {
+                ulLatency = 0U;
+            }
+
+            if( ( pxWakeLatency->ulSamples == 0U ) || ( ulLatency < pxWakeLatency->ulMinimum ) )
+            {
+                pxWakeLatency->ulMinimum = ulLatency;
+            }
+
+            if( ulLatency > pxWakeLatency->ulMaximum )
+            {
+                pxWakeLatency->ulMaximum = ulLatency;
+            }
+
+            pxWakeLatency->ulBuckets[ prvGetWakeLatencyBucket( ulLatency ) ]++;
+            pxWakeLatency->ulSamples++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    UBaseType_t uxTaskSetISRWakeSourceFromISR( UBaseType_t uxSourceID )
+    {
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskSetISRWakeSourceFromISR( uxSourceID );
+
+        configASSERT( uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES );
+
+        /* The source is only read by the kernel on the core that set it, from
+         * within the *FromISR() API functions, so no critical section is
+         * needed. */
+        uxReturn = taskCURRENT_ISR_WAKE_SOURCE();
+        taskCURRENT_ISR_WAKE_SOURCE() = uxSourceID + ( UBaseType_t ) 1U;
+
+        traceRETURN_uxTaskSetISRWakeSourceFromISR( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    void vTaskRestoreISRWakeSourceFromISR( UBaseType_t uxSavedSource )
+    {
+        traceENTER_vTaskRestoreISRWakeSourceFromISR( uxSavedSource );
+
+        configASSERT( uxSavedSource <= ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES );
+
+        taskCURRENT_ISR_WAKE_SOURCE() = uxSavedSource;
+
+        traceRETURN_vTaskRestoreISRWakeSourceFromISR();
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    void vTaskGetISRWakeLatency( UBaseType_t uxSourceID,
+                                 TaskWakeLatency_t * pxWakeLatency )
+    {
+        traceENTER_vTaskGetISRWakeLatency( uxSourceID, pxWakeLatency );
+
+        configASSERT( uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES );
+        configASSERT( pxWakeLatency );
+
+        taskENTER_CRITICAL();
+        {
+            *pxWakeLatency = xISRWakeLatency[ uxSourceID ];
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetISRWakeLatency();
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY == 1 )
+
+    void vTaskResetISRWakeLatency( UBaseType_t uxSourceID )
+    {
+        traceENTER_vTaskResetISRWakeLatency( uxSourceID );
+
+        configASSERT( uxSourceID < ( UBaseType_t ) configISR_WAKE_LATENCY_SOURCES );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( xISRWakeLatency[ uxSourceID ] ), 0x00, sizeof( TaskWakeLatency_t ) );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskResetISRWakeLatency();
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    static void prvRecordBoostChange( TCB_t * pxTCB )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        configRUN_TIME_COUNTER_TYPE ulBoostedTime;
+
+        taskGET_RUN_TIME_COUNTER_VALUE( ulNow );
+
+        if( ( pxTCB->uxPriority > pxTCB->uxBasePriority ) && ( pxTCB->ucBoosted == ( uint8_t ) pdFALSE ) )
+        {
+            pxTCB->ucBoosted = ( uint8_t ) pdTRUE;
+            pxTCB->ulBoostStartTime = ulNow;
+            pxTCB->ulBoosts++;
+        }
+        else if( ( pxTCB->uxPriority <= pxTCB->uxBasePriority ) && ( pxTCB->ucBoosted != ( uint8_t ) pdFALSE ) )
+        {
+            pxTCB->ucBoosted = ( uint8_t ) pdFALSE;
+
+            /* As for the run time stats, guard against a clock that has gone
+             * backwards. */
+            if( ulNow > pxTCB->ulBoostStartTime )
+            {
+                ulBoostedTime = ulNow - pxTCB->ulBoostStartTime;
+                pxTCB->ulBoostedTime += ulBoostedTime;
+
+                if( ulBoostedTime > pxTCB->ulMaxBoostedTime )
+                {
+                    pxTCB->ulMaxBoostedTime = ulBoostedTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* The priority changed, but the task was and still is boosted, or
+             * was and still is not. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_PRIORITY_INVERSION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    static void prvRecordMutexBlockStart( TCB_t * pxMutexHolderTCB )
+    {
+        TCB_t * pxHolder = pxMutexHolderTCB;
+        UBaseType_t uxLength = 0U;
+
+        /* Follow the chain of mutex holders.  A holder is only part of the
+         * chain while it is itself blocked on a mutex, that is, while it has
+         * recorded the holder it is waiting for and is still in an event list.
+         * The length is bounded in case the chain contains a cycle. */
+        while( ( pxHolder != NULL ) && ( uxLength < ( UBaseType_t ) configPRIORITY_INVERSION_CHAIN_DEPTH ) )
+        {
+            pxCurrentTCB->pxBlockingChain[ uxLength ] = pxHolder;
+            uxLength++;
+
+            if( listLIST_ITEM_CONTAINER( &( pxHolder->xEventListItem ) ) != NULL )
+            {
+                pxHolder = pxHolder->pxBlockedOnMutexHolder;
+            }
+            else
+            {
+                pxHolder = NULL;
+            }
+        }
+
+        pxCurrentTCB->uxBlockingChainLength = uxLength;
+        pxCurrentTCB->pxBlockedOnMutexHolder = pxMutexHolderTCB;
+        pxCurrentTCB->ulMutexBlocks++;
+
+        if( uxLength > pxCurrentTCB->uxLongestBlockingChain )
+        {
+            pxCurrentTCB->uxLongestBlockingChain = uxLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskGET_RUN_TIME_COUNTER_VALUE( pxCurrentTCB->ulMutexBlockStartTime );
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* configUSE_PRIORITY_INVERSION_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    static void prvRecordMutexBlockEnd( TCB_t * pxTCB,
+                                        configRUN_TIME_COUNTER_TYPE ulNow )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
-
-        traceENTER_uxTaskGetStackHighWaterMark2( xTask );
+        configRUN_TIME_COUNTER_TYPE ulBlockTime;
 
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
+        if( pxTCB->pxBlockedOnMutexHolder != NULL )
+        {
+            pxTCB->pxBlockedOnMutexHolder = NULL;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+            if( ulNow > pxTCB->ulMutexBlockStartTime )
+            {
+                ulBlockTime = ulNow - pxTCB->ulMutexBlockStartTime;
+            }
+            else
+            {
+                ulBlockTime = 0U;
+            }
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            if( ( ulBlockTime > pxTCB->ulMaxMutexBlockTime ) || ( pxTCB->uxWorstBlockingChainLength == 0U ) )
+            {
+                pxTCB->ulMaxMutexBlockTime = ulBlockTime;
+                pxTCB->uxWorstBlockingChainLength = pxTCB->uxBlockingChainLength;
+                ( void ) memcpy( pxTCB->pxWorstBlockingChain, pxTCB->pxBlockingChain, sizeof( pxTCB->pxWorstBlockingChain ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-        traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
-
-        return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+#endif /* configUSE_PRIORITY_INVERSION_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    void vTaskGetInversionStats( TaskHandle_t xTask,
+                                 TaskInversionStats_t * pxStats )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        UBaseType_t x;
 
-        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+        traceENTER_vTaskGetInversionStats( xTask, pxStats );
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxStats );
 
-        #if portSTACK_GROWTH < 0
+        taskENTER_CRITICAL();
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxStats->ulBoosts = pxTCB->ulBoosts;
+            pxStats->ulBoostedTime = pxTCB->ulBoostedTime;
+            pxStats->ulMaxBoostedTime = pxTCB->ulMaxBoostedTime;
+            pxStats->ulMutexBlocks = pxTCB->ulMutexBlocks;
+            pxStats->ulMaxMutexBlockTime = pxTCB->ulMaxMutexBlockTime;
+            pxStats->uxLongestChain = pxTCB->uxLongestBlockingChain;
+            pxStats->uxWorstChainLength = pxTCB->uxWorstBlockingChainLength;
+
+            for( x = 0U; x < ( UBaseType_t ) configPRIORITY_INVERSION_CHAIN_DEPTH; x++ )
+            {
+                if( x < pxTCB->uxWorstBlockingChainLength )
+                {
+                    pxStats->xWorstChain[ x ] = pxTCB->pxWorstBlockingChain[ x ];
+                }
+                else
+                {
+                    pxStats->xWorstChain[ x ] = NULL;
+                }
+            }
+
+            /* Include a boost that is still in progress. */
+            if( pxTCB->ucBoosted != ( uint8_t ) pdFALSE )
+            {
+                taskGET_RUN_TIME_COUNTER_VALUE( ulNow );
+
+                if( ulNow > pxTCB->ulBoostStartTime )
+                {
+                    pxStats->ulBoostedTime += ulNow - pxTCB->ulBoostStartTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #else
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetInversionStats();
+    }
+
+#endif /* configUSE_PRIORITY_INVERSION_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+
+    void vTaskResetInversionStats( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskResetInversionStats( xTask );
+
+        taskENTER_CRITICAL();
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+            pxTCB->ulBoosts = 0U;
+            pxTCB->ulBoostedTime = 0U;
+            pxTCB->ulMaxBoostedTime = 0U;
+            pxTCB->ulMutexBlocks = 0U;
+            pxTCB->ulMaxMutexBlockTime = 0U;
+            pxTCB->uxLongestBlockingChain = 0U;
+            pxTCB->uxWorstBlockingChainLength = 0U;
 
-        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+            /* A boost in progress is timed from now, so it is not counted
+             * against the period before the reset. */
+            if( pxTCB->ucBoosted != ( uint8_t ) pdFALSE )
+            {
+                taskGET_RUN_TIME_COUNTER_VALUE( pxTCB->ulBoostStartTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        return uxReturn;
+        traceRETURN_vTaskResetInversionStats();
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* configUSE_PRIORITY_INVERSION_STATS */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -6411,6 +8208,14 @@ static void prvCheckTasksWaitingTermination( void )
          * want to allocate and clean RAM statically. */
         portCLEAN_UP_TCB( pxTCB );
 
+        #if ( configUSE_HEAP_PROFILER == 1 )
+        {
+            /* Release the task's heap profiler entry before the TCB can be
+             * reused by another task. */
+            vPortHeapProfilerTaskDeleted( pxTCB );
+        }
+        #endif
+
         #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         {
             /* Free up the memory allocated for the task's TLS Block. */
@@ -6422,8 +8227,16 @@ static void prvCheckTasksWaitingTermination( void )
         {
             /* The task can only have been allocated dynamically - free both
              * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            #if ( configUSE_TASK_SINGLE_ALLOCATION == 1 )
+            {
+                vPortFreeStack( tskTASK_BLOCK_START( pxTCB ) );
+            }
+            #else
+            {
+                vPortFreeStack( pxTCB->pxStack );
+                vPortFreeObject( eObjectPoolTask, pxTCB );
+            }
+            #endif
         }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         {
@@ -6434,14 +8247,22 @@ static void prvCheckTasksWaitingTermination( void )
             {
                 /* Both the stack and TCB were allocated dynamically, so both
                  * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                #if ( configUSE_TASK_SINGLE_ALLOCATION == 1 )
+                {
+                    vPortFreeStack( tskTASK_BLOCK_START( pxTCB ) );
+                }
+                #else
+                {
+                    vPortFreeStack( pxTCB->pxStack );
+                    vPortFreeObject( eObjectPoolTask, pxTCB );
+                }
+                #endif
             }
             else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
                 /* Only the stack was statically allocated, so the TCB is the
                  * only memory that must be freed. */
-                vPortFree( pxTCB );
+                vPortFreeObject( eObjectPoolTask, pxTCB );
             }
             else
             {
@@ -6592,6 +8413,12 @@ static void prvResetNextTaskUnblockTime( void )
          * inheritance is not applied in this scenario. */
         if( pxMutexHolder != NULL )
         {
+            #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+            {
+                prvRecordMutexBlockStart( pxMutexHolderTCB );
+            }
+            #endif
+
             /* If the holder of the mutex has a priority below the priority of
              * the task attempting to obtain the mutex then it will temporarily
              * inherit the priority of the task attempting to obtain the mutex. */
@@ -6647,6 +8474,12 @@ static void prvResetNextTaskUnblockTime( void )
 
                 traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
+                #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+                {
+                    prvRecordBoostChange( pxMutexHolderTCB );
+                }
+                #endif
+
                 /* Inheritance occurred. */
                 xReturn = pdTRUE;
             }
@@ -6727,6 +8560,12 @@ static void prvResetNextTaskUnblockTime( void )
                     traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
                     pxTCB->uxPriority = pxTCB->uxBasePriority;
 
+                    #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+                    {
+                        prvRecordBoostChange( pxTCB );
+                    }
+                    #endif
+
                     /* Reset the event list item value.  It cannot be in use for
                      * any other purpose if this task is running, and it must be
                      * running to give back the mutex. */
@@ -6827,6 +8666,12 @@ static void prvResetNextTaskUnblockTime( void )
                     uxPriorityUsedOnEntry = pxTCB->uxPriority;
                     pxTCB->uxPriority = uxPriorityToUse;
 
+                    #if ( configUSE_PRIORITY_INVERSION_STATS == 1 )
+                    {
+                        prvRecordBoostChange( pxTCB );
+                    }
+                    #endif
+
                     /* Only reset the event list item value if the value is not
                      * being used for anything else. */
                     if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
@@ -6942,6 +8787,12 @@ static void prvResetNextTaskUnblockTime( void )
             if( pxCurrentTCB->uxCriticalNesting == 1U )
             {
                 portASSERT_IF_IN_ISR();
+
+                #if ( configUSE_CRITICAL_PROFILER == 1 )
+                {
+                    vCriticalProfilerEnter( eCriticalSectionRegion, configCRITICAL_PROFILER_GET_CALLER() );
+                }
+                #endif
             }
         }
         else
@@ -6991,6 +8842,12 @@ static void prvResetNextTaskUnblockTime( void )
                      * used within vTaskSwitchContext(). */
                     prvCheckForRunStateChange();
                 }
+
+                #if ( configUSE_CRITICAL_PROFILER == 1 )
+                {
+                    vCriticalProfilerEnter( eCriticalSectionRegion, configCRITICAL_PROFILER_GET_CALLER() );
+                }
+                #endif
             }
         }
         else
@@ -7059,6 +8916,12 @@ static void prvResetNextTaskUnblockTime( void )
 
                 if( pxCurrentTCB->uxCriticalNesting == 0U )
                 {
+                    #if ( configUSE_CRITICAL_PROFILER == 1 )
+                    {
+                        vCriticalProfilerExit( eCriticalSectionRegion );
+                    }
+                    #endif
+
                     portENABLE_INTERRUPTS();
                 }
                 else
@@ -7109,6 +8972,12 @@ static void prvResetNextTaskUnblockTime( void )
                     /* Get the xYieldPending stats inside the critical section. */
                     xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
 
+                    #if ( configUSE_CRITICAL_PROFILER == 1 )
+                    {
+                        vCriticalProfilerExit( eCriticalSectionRegion );
+                    }
+                    #endif
+
                     portRELEASE_ISR_LOCK();
                     portRELEASE_TASK_LOCK();
                     portENABLE_INTERRUPTS();
@@ -7570,6 +9439,162 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_INVERSION_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+
+    void vTaskListInversionChains( char * pcWriteBuffer,
+                                   size_t uxBufferLength )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        TaskInversionStats_t xStats;
+        size_t uxConsumedBufferLength = 0;
+        size_t uxCharsWrittenBySnprintf;
+        int iSnprintfReturnValue;
+        BaseType_t xOutputBufferFull = pdFALSE;
+        UBaseType_t uxArraySize, x, y, z;
+        const char * pcChainName;
+
+        traceENTER_vTaskListInversionChains( pcWriteBuffer, uxBufferLength );
+
+        /* As for vTaskListTasks(), this function is provided for convenience
+         * only and is not part of the scheduler. */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) );
+
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+            for( x = 0; ( x < uxArraySize ) && ( xOutputBufferFull == pdFALSE ); x++ )
+            {
+                vTaskGetInversionStats( pxTaskStatusArray[ x ].xHandle, &xStats );
+
+                /* Only list tasks that have been involved in an inversion. */
+                if( ( xStats.ulMutexBlocks != 0U ) || ( xStats.ulBoosts != 0U ) )
+                {
+                    /* Is there enough space in the buffer to hold task name
+                     * and at least one more character? */
+                    if( ( uxConsumedBufferLength + configMAX_TASK_NAME_LEN ) < uxBufferLength )
+                    {
+                        pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+                        /* Do not count the terminating null character. */
+                        uxConsumedBufferLength = uxConsumedBufferLength + ( configMAX_TASK_NAME_LEN - 1U );
+
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            /* MISRA Ref 21.6.1 [snprintf for utility] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-216 */
+                            /* coverity[misra_c_2012_rule_21_6_violation] */
+                            iSnprintfReturnValue = snprintf( pcWriteBuffer,
+                                                             uxBufferLength - uxConsumedBufferLength,
+                                                             "\t%lu\t%lu\t%lu\t%lu\t",
+                                                             ( unsigned long ) xStats.ulMutexBlocks,
+                                                             ( unsigned long ) xStats.ulMaxMutexBlockTime,
+                                                             ( unsigned long ) xStats.ulBoosts,
+                                                             ( unsigned long ) xStats.ulBoostedTime );
+                        }
+                        #else
+                        {
+                            /* MISRA Ref 21.6.1 [snprintf for utility] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-216 */
+                            /* coverity[misra_c_2012_rule_21_6_violation] */
+                            iSnprintfReturnValue = snprintf( pcWriteBuffer,
+                                                             uxBufferLength - uxConsumedBufferLength,
+                                                             "\t%u\t%u\t%u\t%u\t",
+                                                             ( unsigned int ) xStats.ulMutexBlocks,
+                                                             ( unsigned int ) xStats.ulMaxMutexBlockTime,
+                                                             ( unsigned int ) xStats.ulBoosts,
+                                                             ( unsigned int ) xStats.ulBoostedTime );
+                        }
+                        #endif /* ifdef portLU_PRINTF_SPECIFIER_REQUIRED */
+
+                        uxCharsWrittenBySnprintf = prvSnprintfReturnValueToCharsWritten( iSnprintfReturnValue, uxBufferLength - uxConsumedBufferLength );
+                        uxConsumedBufferLength += uxCharsWrittenBySnprintf;
+                        pcWriteBuffer += uxCharsWrittenBySnprintf;
+
+                        /* Write the chain, naming each task from the state
+                         * just obtained.  A task that is no longer in the
+                         * state has been deleted since the chain was
+                         * recorded. */
+                        for( y = 0; y <= xStats.uxWorstChainLength; y++ )
+                        {
+                            if( uxConsumedBufferLength >= ( uxBufferLength - 1U ) )
+                            {
+                                xOutputBufferFull = pdTRUE;
+                                break;
+                            }
+
+                            if( y == xStats.uxWorstChainLength )
+                            {
+                                /* MISRA Ref 21.6.1 [snprintf for utility] */
+                                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-216 */
+                                /* coverity[misra_c_2012_rule_21_6_violation] */
+                                iSnprintfReturnValue = snprintf( pcWriteBuffer, uxBufferLength - uxConsumedBufferLength, "\r\n" );
+                            }
+                            else
+                            {
+                                pcChainName = "?";
+
+                                for( z = 0; z < uxArraySize; z++ )
+                                {
+                                    if( pxTaskStatusArray[ z ].xHandle == xStats.xWorstChain[ y ] )
+                                    {
+                                        pcChainName = pxTaskStatusArray[ z ].pcTaskName;
+                                        break;
+                                    }
+                                }
+
+                                /* MISRA Ref 21.6.1 [snprintf for utility] */
+                                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-216 */
+                                /* coverity[misra_c_2012_rule_21_6_violation] */
+                                iSnprintfReturnValue = snprintf( pcWriteBuffer,
+                                                                 uxBufferLength - uxConsumedBufferLength,
+                                                                 "%s%s",
+                                                                 ( y == 0U ) ? "" : " -> ",
+                                                                 pcChainName );
+                            }
+
+                            uxCharsWrittenBySnprintf = prvSnprintfReturnValueToCharsWritten( iSnprintfReturnValue, uxBufferLength - uxConsumedBufferLength );
+                            uxConsumedBufferLength += uxCharsWrittenBySnprintf;
+                            pcWriteBuffer += uxCharsWrittenBySnprintf;
+                        }
+                    }
+                    else
+                    {
+                        xOutputBufferFull = pdTRUE;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskListInversionChains();
+    }
+
+#endif /* ( ( configUSE_PRIORITY_INVERSION_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
     TickType_t uxReturn;
@@ -8064,6 +10089,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRECORD_WAKE_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
@@ -8182,6 +10208,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRECORD_WAKE_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
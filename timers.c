@@ -39,6 +39,10 @@
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_ARENAS == 1 )
+    #include "arena.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -343,18 +347,29 @@
 
             traceENTER_xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
 
-            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-            /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
-
-            if( pxNewTimer != NULL )
+            #if ( configUSE_ARENAS == 1 )
+                if( xTaskGetDefaultArena( NULL ) != NULL )
+                {
+                    /* The calling task has a default arena, so the timer is
+                     * created in it. */
+                    pxNewTimer = ( Timer_t * ) xTimerCreateInArena( xTaskGetDefaultArena( NULL ), pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
+                }
+                else
+            #endif /* configUSE_ARENAS */
             {
-                /* Status is thus far zero as the timer is not created statically
-                 * and has not been started.  The auto-reload bit may get set in
-                 * prvInitialiseNewTimer. */
-                pxNewTimer->ucStatus = 0x00;
-                prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxNewTimer = ( Timer_t * ) pvPortMallocObject( eObjectPoolTimer, sizeof( Timer_t ) );
+
+                if( pxNewTimer != NULL )
+                {
+                    /* Status is thus far zero as the timer is not created statically
+                     * and has not been started.  The auto-reload bit may get set in
+                     * prvInitialiseNewTimer. */
+                    pxNewTimer->ucStatus = 0x00;
+                    prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+                }
             }
 
             traceRETURN_xTimerCreate( pxNewTimer );
@@ -414,6 +429,46 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ARENAS == 1 )
+
+        TimerHandle_t xTimerCreateInArena( ArenaHandle_t xArena,
+                                           const char * const pcTimerName,
+                                           const TickType_t xTimerPeriodInTicks,
+                                           const BaseType_t xAutoReload,
+                                           void * const pvTimerID,
+                                           TimerCallbackFunction_t pxCallbackFunction )
+        {
+            StaticTimer_t * pxTimerBuffer;
+            TimerHandle_t xReturn = NULL;
+
+            traceENTER_xTimerCreateInArena( xArena, pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
+
+            configASSERT( xArena );
+
+            /* The timer is created as a statically allocated timer so deleting
+             * it does not attempt to free the arena's memory. */
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTimerBuffer = ( StaticTimer_t * ) pvArenaMalloc( xArena, sizeof( StaticTimer_t ) );
+
+            if( pxTimerBuffer != NULL )
+            {
+                xReturn = xTimerCreateStatic( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xTimerCreateInArena( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
     static void prvInitialiseNewTimer( const char * const pcTimerName,
                                        const TickType_t xTimerPeriodInTicks,
                                        const BaseType_t xAutoReload,
@@ -1056,7 +1111,7 @@
                              * allocated. */
                             if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
                             {
-                                vPortFree( pxTimer );
+                                vPortFreeObject( eObjectPoolTimer, pxTimer );
                             }
                             else
                             {
@@ -0,0 +1,371 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A recorder of kernel events for post-mortem timeline analysis.  See the
+ * comments in trace_recorder.h for a description of what is recorded and of
+ * the format written by xTraceRecorderDump().
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace_recorder.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder. This #if is closed at the very bottom of this
+ * file. If you want to include the trace recorder then ensure
+ * configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #if ( ( configTRACE_RECORDER_BUFFER_EVENTS < 2 ) || ( ( configTRACE_RECORDER_BUFFER_EVENTS & ( configTRACE_RECORDER_BUFFER_EVENTS - 1 ) ) != 0 ) )
+        #error configTRACE_RECORDER_BUFFER_EVENTS must be a power of 2.
+    #endif
+
+    #if ( configMAX_TASK_NAME_LEN > 255 )
+        #error configMAX_TASK_NAME_LEN must not exceed 255 when configUSE_TRACE_RECORDER is 1.
+    #endif
+
+    #define trcFORMAT_VERSION         ( ( uint8_t ) 1U )
+    #define trcHEADER_BYTES           ( 20U )
+    #define trcEVENT_BYTES            ( 16U )
+    #define trcOBJECT_RECORD_BYTES    ( 5U + ( size_t ) configMAX_TASK_NAME_LEN )
+    #define trcBUFFER_INDEX_MASK      ( ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS - 1U )
+
+/* Interrupts are masked on the calling core, and only on the calling core,
+ * while an event is written.  Each core writes only to its own buffer so no
+ * lock is needed.  The same scheme is used by atomic.h. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #define trcENTER_RECORD()    UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK()
+        #define trcEXIT_RECORD()     portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus )
+    #elif ( portHAS_NESTED_INTERRUPTS == 1 )
+        #define trcENTER_RECORD()    UBaseType_t uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR()
+        #define trcEXIT_RECORD()     portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus )
+    #else
+        #define trcENTER_RECORD()    portENTER_CRITICAL()
+        #define trcEXIT_RECORD()     portEXIT_CRITICAL()
+    #endif
+
+/* The slot an event is written to is claimed with a single atomic increment
+ * of ulEventsWritten where the compiler provides one.  Some ports, such as
+ * the POSIX port, cannot mask interrupts from task context, so another task
+ * can record an event between the slot being read and ulEventsWritten being
+ * incremented, and the two events would then share a slot. */
+    #if defined( __GNUC__ )
+        #define trcCLAIM_SLOT( pxBuffer )    __atomic_fetch_add( &( ( pxBuffer )->ulEventsWritten ), 1U, __ATOMIC_RELAXED )
+    #else
+        #define trcCLAIM_SLOT( pxBuffer )    ( ( pxBuffer )->ulEventsWritten++ )
+    #endif
+
+/* The ring buffer of one core.  ulEventsWritten counts every event recorded
+ * since the buffer was cleared, so the next event is written to
+ * xEvents[ ulEventsWritten & trcBUFFER_INDEX_MASK ]. */
+    typedef struct TraceRecorderBuffer
+    {
+        uint32_t ulEventsWritten;
+        TraceRecorderEvent_t xEvents[ configTRACE_RECORDER_BUFFER_EVENTS ];
+    } TraceRecorderBuffer_t;
+
+/* An entry in the object name table. */
+    typedef struct TraceRecorderObject
+    {
+        uint32_t ulObject;
+        uint8_t ucObjectType;
+        char cName[ configMAX_TASK_NAME_LEN ];
+    } TraceRecorderObject_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Writes the event to the buffer of the calling core.
+ */
+    static void prvRecordEvent( uint8_t ucEventCode,
+                                uint16_t usParameter,
+                                const void * pvObject,
+                                uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stores ulValue at pucDestination as 4 little endian bytes.
+ */
+    static void prvPutUint32( uint8_t * pucDestination,
+                              uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    PRIVILEGED_DATA static TraceRecorderBuffer_t xTraceBuffers[ configNUMBER_OF_CORES ];
+    PRIVILEGED_DATA static TraceRecorderObject_t xTraceObjects[ configTRACE_RECORDER_MAX_OBJECTS ];
+    PRIVILEGED_DATA static UBaseType_t uxTraceObjectCount = 0U;
+    PRIVILEGED_DATA static volatile BaseType_t xTraceRecording = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+    static void prvRecordEvent( uint8_t ucEventCode,
+                                uint16_t usParameter,
+                                const void * pvObject,
+                                uint32_t ulValue )
+    {
+        TraceRecorderBuffer_t * pxBuffer;
+        TraceRecorderEvent_t * pxEvent;
+        BaseType_t xCoreID;
+
+        if( xTraceRecording != pdFALSE )
+        {
+            trcENTER_RECORD();
+            {
+                /* The core ID is only stable once interrupts are masked. */
+                xCoreID = ( BaseType_t ) portGET_CORE_ID();
+                pxBuffer = &( xTraceBuffers[ xCoreID ] );
+                pxEvent = &( pxBuffer->xEvents[ trcCLAIM_SLOT( pxBuffer ) & trcBUFFER_INDEX_MASK ] );
+
+                pxEvent->ulTimestamp = ( uint32_t ) configTRACE_RECORDER_GET_TIMESTAMP();
+                pxEvent->ucEventCode = ucEventCode;
+                pxEvent->ucCoreID = ( uint8_t ) xCoreID;
+                pxEvent->usParameter = usParameter;
+                pxEvent->ulObject = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject;
+                pxEvent->ulValue = ulValue;
+            }
+            trcEXIT_RECORD();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPutUint32( uint8_t * pucDestination,
+                              uint32_t ulValue )
+    {
+        pucDestination[ 0 ] = ( uint8_t ) ulValue;
+        pucDestination[ 1 ] = ( uint8_t ) ( ulValue >> 8 );
+        pucDestination[ 2 ] = ( uint8_t ) ( ulValue >> 16 );
+        pucDestination[ 3 ] = ( uint8_t ) ( ulValue >> 24 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderEvent( uint8_t ucEventCode,
+                              const void * pvObject,
+                              uint32_t ulValue )
+    {
+        prvRecordEvent( ucEventCode, 0U, pvObject, ulValue );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderUserEvent( uint16_t usEventID,
+                                  uint32_t ulValue )
+    {
+        prvRecordEvent( traceRECORDER_EVENT_USER, usEventID, NULL, ulValue );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderAddObject( uint8_t ucObjectType,
+                                  const void * pvObject,
+                                  const char * pcName )
+    {
+        const uint32_t ulObject = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject;
+        TraceRecorderObject_t * pxObject = NULL;
+        UBaseType_t uxIndex;
+        size_t x;
+
+        taskENTER_CRITICAL();
+        {
+            /* Handles are reused once an object is deleted, so an existing
+             * entry for the handle is renamed rather than a new one added. */
+            for( uxIndex = 0U; uxIndex < uxTraceObjectCount; uxIndex++ )
+            {
+                if( xTraceObjects[ uxIndex ].ulObject == ulObject )
+                {
+                    pxObject = &( xTraceObjects[ uxIndex ] );
+                    break;
+                }
+            }
+
+            if( ( pxObject == NULL ) && ( uxTraceObjectCount < ( UBaseType_t ) configTRACE_RECORDER_MAX_OBJECTS ) )
+            {
+                pxObject = &( xTraceObjects[ uxTraceObjectCount ] );
+                uxTraceObjectCount++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxObject != NULL )
+            {
+                pxObject->ulObject = ulObject;
+                pxObject->ucObjectType = ucObjectType;
+
+                for( x = 0U; x < ( size_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    if( ( pcName == NULL ) || ( pcName[ x ] == ( char ) 0x00 ) )
+                    {
+                        break;
+                    }
+
+                    pxObject->cName[ x ] = pcName[ x ];
+                }
+
+                for( ; x < ( size_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    pxObject->cName[ x ] = ( char ) 0x00;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStart( void )
+    {
+        xTraceRecording = pdTRUE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        xTraceRecording = pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderClear( void )
+    {
+        BaseType_t xCoreID;
+
+        taskENTER_CRITICAL();
+        {
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                xTraceBuffers[ xCoreID ].ulEventsWritten = 0U;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTraceRecorderDump( TraceRecorderWriteFunction_t pxWrite,
+                                   void * pvContext )
+    {
+        uint8_t ucRecord[ trcOBJECT_RECORD_BYTES > trcHEADER_BYTES ? trcOBJECT_RECORD_BYTES : trcHEADER_BYTES ];
+        const TraceRecorderBuffer_t * pxBuffer;
+        const TraceRecorderEvent_t * pxEvent;
+        UBaseType_t uxObjects;
+        UBaseType_t uxIndex;
+        BaseType_t xCoreID;
+        BaseType_t xReturn = pdPASS;
+        uint32_t ulEventsWritten;
+        uint32_t ulEventsToWrite;
+        uint32_t ulEvent;
+
+        configASSERT( pxWrite );
+
+        /* The object table can still grow if tasks are created while the
+         * recording is written out, so only the objects present now are
+         * written. */
+        taskENTER_CRITICAL();
+        {
+            uxObjects = uxTraceObjectCount;
+        }
+        taskEXIT_CRITICAL();
+
+        ucRecord[ 0 ] = ( uint8_t ) 'F';
+        ucRecord[ 1 ] = ( uint8_t ) 'R';
+        ucRecord[ 2 ] = ( uint8_t ) 'T';
+        ucRecord[ 3 ] = ( uint8_t ) 'R';
+        ucRecord[ 4 ] = trcFORMAT_VERSION;
+        ucRecord[ 5 ] = ( uint8_t ) configNUMBER_OF_CORES;
+        ucRecord[ 6 ] = ( uint8_t ) configMAX_TASK_NAME_LEN;
+        ucRecord[ 7 ] = ( uint8_t ) trcEVENT_BYTES;
+        prvPutUint32( &( ucRecord[ 8 ] ), ( uint32_t ) configTRACE_RECORDER_TIMESTAMP_HZ );
+        prvPutUint32( &( ucRecord[ 12 ] ), ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS );
+        prvPutUint32( &( ucRecord[ 16 ] ), ( uint32_t ) uxObjects );
+        xReturn = pxWrite( ucRecord, trcHEADER_BYTES, pvContext );
+
+        for( uxIndex = 0U; ( uxIndex < uxObjects ) && ( xReturn == pdPASS ); uxIndex++ )
+        {
+            prvPutUint32( ucRecord, xTraceObjects[ uxIndex ].ulObject );
+            ucRecord[ 4 ] = xTraceObjects[ uxIndex ].ucObjectType;
+            ( void ) memcpy( &( ucRecord[ 5 ] ), xTraceObjects[ uxIndex ].cName, ( size_t ) configMAX_TASK_NAME_LEN );
+            xReturn = pxWrite( ucRecord, trcOBJECT_RECORD_BYTES, pvContext );
+        }
+
+        for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            pxBuffer = &( xTraceBuffers[ xCoreID ] );
+            ulEventsWritten = pxBuffer->ulEventsWritten;
+
+            if( ulEventsWritten < ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS )
+            {
+                ulEventsToWrite = ulEventsWritten;
+            }
+            else
+            {
+                ulEventsToWrite = ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS;
+            }
+
+            prvPutUint32( ucRecord, ulEventsWritten );
+            prvPutUint32( &( ucRecord[ 4 ] ), ulEventsToWrite );
+            xReturn = pxWrite( ucRecord, 8U, pvContext );
+
+            /* Once the buffer has wrapped the oldest event is the one that
+             * will be overwritten next. */
+            for( ulEvent = ulEventsWritten - ulEventsToWrite; ( ulEvent != ulEventsWritten ) && ( xReturn == pdPASS ); ulEvent++ )
+            {
+                pxEvent = &( pxBuffer->xEvents[ ulEvent & trcBUFFER_INDEX_MASK ] );
+                prvPutUint32( ucRecord, pxEvent->ulTimestamp );
+                ucRecord[ 4 ] = pxEvent->ucEventCode;
+                ucRecord[ 5 ] = pxEvent->ucCoreID;
+                ucRecord[ 6 ] = ( uint8_t ) pxEvent->usParameter;
+                ucRecord[ 7 ] = ( uint8_t ) ( pxEvent->usParameter >> 8 );
+                prvPutUint32( &( ucRecord[ 8 ] ), pxEvent->ulObject );
+                prvPutUint32( &( ucRecord[ 12 ] ), pxEvent->ulValue );
+                xReturn = pxWrite( ucRecord, trcEVENT_BYTES, pvContext );
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER == 1 */